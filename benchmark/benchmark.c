@@ -0,0 +1,678 @@
+/*
+	Benchmark of JSON library.
+
+	Description
+		This program measures jsonl_parse_text, jsonl_print, jsonl_get_value, jsonl_get_value_compiled and jsonl_set_values functions
+		with synthetic corpora generated by the file "corpus.c" and with JSON files given on the command line.
+		The files are memory mapped with the functions of the file "jsonl_file.c".
+
+		The size probe pass of jsonl_parse_text (zero buffer size) and the real pass that creates the value tree are measured separately.
+
+		Every operation is first repeated until one batch takes at least one tenth of the measuring time.
+		Then the time of several batches is measured and the fastest and the median time per operation are reported.
+
+	Usage
+		benchmark [-t seconds] [-s corpus_size] [-r seed] [-c shape] [-p] [-k] [file ...]
+
+		-t  Measuring time of every operation in seconds. Default is 0.5.
+		-s  Size of every generated corpus in bytes. Default is 1048576.
+		-r  Seed of the corpus generator. Default is 1.
+		-c  Generate only the corpus of given shape. Can be given multiple times.
+		    Shapes are twitter, canada, nested, wide, random, deep and flat_array.
+		    If no shapes or files are given, twitter, canada, nested and wide are generated.
+		    Corpora with other parameters can be created with the generator program and given as files.
+		-p  Read hardware performance counters with perf_event_open during the measured batches. Linux only.
+		-k  Measure instead how set values scales with the number of modifications k and the size of the tree n.
+		    Every generated corpus is measured with sizes of 1/16, 1/4 and 1 times the corpus size and k of 1, 16, 256 and 4096.
+
+	Output
+		One JSON object per line for every measured operation, for example
+		{"benchmark":"parse","corpus":"twitter","number_format":"double","bytes":1048576,"iterations":64,"best_ns_per_op":512000.0,"ns_per_op":530000.0,"mb_per_s":1978.4}
+
+		benchmark
+			Name of the operation. One of parse_probe, parse, print, get_value, get_value_compiled and set_values.
+		corpus
+			Name of the corpus shape or path of the file.
+		number_format
+			double or fixed_point depending on JSONL_FIXED_POINT_NUMBER_FORMAT.
+		bytes
+			Size of the data processed by one operation. This is the size of the JSON text for parse_probe, parse and print,
+			the size of the value tree for set_values and zero for get_value and get_value_compiled.
+		iterations
+			Number of operations in one measured batch.
+		best_ns_per_op and ns_per_op
+			Fastest and median batch time divided by number of operations.
+			For get_value and get_value_compiled one operation is one lookup.
+			get_value_compiled looks up the same paths as get_value with paths compiled once by jsonl_compile_path,
+			so the difference of the two is the time saved by the precomputed name hashes.
+		mb_per_s
+			Bytes divided by the median time per operation. Zero when bytes is zero.
+
+	Performance counters
+		With option -p the user space counters of cycles, instructions, branch misses, L1 data cache read misses and
+		last level cache read misses are added to every line, for example
+		"cycles_per_byte":12.5,"cycles_per_node":96.1,"instructions_per_byte":30.2,"instructions_per_node":232.4,...
+
+		The counters are summed over all measured batches and divided by the number of operations,
+		then by the size of the JSON text of the corpus (per_byte) and by the number of values in its tree (per_node).
+		The counts are scaled when the kernel multiplexes the counters.
+		A counter that the processor or the kernel does not provide is reported as null.
+		A high number of branch misses per byte points to the scanning of the text and
+		a high number of cache misses per node points to the traversal of the value tree.
+
+	Set values sweep
+		With option -k the operations are
+			set_values             jsonl_set_values that creates the plan of the modifications at every call.
+			set_values_with_plan   jsonl_set_values_with_plan with a plan created once.
+			set_values_sequential  jsonl_set_values called once for every modification, each call copying the whole tree.
+			                       This grows with k times n like searching the whole list of modifications at every value did.
+			                       It is skipped when k copies of the tree would exceed 256 MiB.
+		and the lines have the number of modifications and values of the tree, for example
+		"set_value_count":256,"node_count":41231
+		The modifications set random leaf values to numbers. Small corpora may have fewer distinct leaves than k.
+*/
+
+#define _POSIX_C_SOURCE 199309L
+#define _DEFAULT_SOURCE
+
+#include "jsonl.h"
+#include "jsonl_file.h"
+#include "corpus.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define BENCHMARK_BATCH_COUNT 7
+#define BENCHMARK_MAXIMUM_SHAPE_COUNT 16
+#define BENCHMARK_PATH_COUNT 64
+#define BENCHMARK_SET_VALUE_COUNT 8
+#define BENCHMARK_MAXIMUM_PATH_LENGTH 256
+#define BENCHMARK_COUNTER_COUNT 5
+#define BENCHMARK_SWEEP_SIZE_COUNT 3
+#define BENCHMARK_SWEEP_SET_VALUE_COUNT_COUNT 4
+#define BENCHMARK_SEQUENTIAL_MAXIMUM_SIZE ((size_t)256 << 20)
+
+#ifdef JSONL_FIXED_POINT_NUMBER_FORMAT
+#define BENCHMARK_NUMBER_FORMAT "fixed_point"
+#else
+#define BENCHMARK_NUMBER_FORMAT "double"
+#endif
+
+typedef struct benchmark_context_t
+{
+	const char* corpus_name;
+	size_t text_size;
+	const char* text;
+	size_t node_count;
+	size_t tree_size;
+	jsonl_value_t* tree;
+	size_t print_size;
+	char* print_buffer;
+	size_t path_count;
+	size_t path_length_table[BENCHMARK_PATH_COUNT];
+	jsonl_path_component_t path_table[BENCHMARK_PATH_COUNT][BENCHMARK_MAXIMUM_PATH_LENGTH];
+	size_t compiled_path_buffer_size;
+	void* compiled_path_buffer;
+	const jsonl_compiled_path_t* compiled_path_table[BENCHMARK_PATH_COUNT];
+	size_t set_value_count;
+	jsonl_set_value_t set_value_table[BENCHMARK_SET_VALUE_COUNT];
+	jsonl_value_t set_value;
+	size_t set_tree_size;
+	jsonl_value_t* set_tree;
+	size_t sweep_set_value_count;
+	jsonl_set_value_t* sweep_set_value_table;
+	jsonl_set_values_plan_t* sweep_plan;
+	size_t sweep_tree_size;
+	jsonl_value_t* sweep_tree;
+	jsonl_value_t* sweep_second_tree;
+} benchmark_context_t;
+
+typedef size_t (*benchmark_operation_t)(benchmark_context_t* context);
+
+static volatile size_t benchmark_sink;
+
+static const char* benchmark_counter_name_table[BENCHMARK_COUNTER_COUNT] = { "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses" };
+
+static const size_t benchmark_sweep_set_value_count_table[BENCHMARK_SWEEP_SET_VALUE_COUNT_COUNT] = { 1, 16, 256, 4096 };
+
+static int benchmark_counters_enabled;
+
+static int benchmark_counter_file_table[BENCHMARK_COUNTER_COUNT];
+
+static uint64_t benchmark_time(void)
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (uint64_t)time.tv_sec * 1000000000 + (uint64_t)time.tv_nsec;
+}
+
+static int benchmark_open_counters(void)
+{
+	int counter_opened = 0;
+	for (int i = 0; i != BENCHMARK_COUNTER_COUNT; ++i)
+		benchmark_counter_file_table[i] = -1;
+#ifdef __linux__
+	static const uint32_t type_table[BENCHMARK_COUNTER_COUNT] = { PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE };
+	static const uint64_t config_table[BENCHMARK_COUNTER_COUNT] = {
+		PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_BRANCH_MISSES,
+		PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+		PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) };
+	for (int i = 0; i != BENCHMARK_COUNTER_COUNT; ++i)
+	{
+		// The counters are opened separately and not as a group, so the counters that are available work without the others.
+		struct perf_event_attr attributes;
+		memset(&attributes, 0, sizeof(struct perf_event_attr));
+		attributes.size = sizeof(struct perf_event_attr);
+		attributes.type = type_table[i];
+		attributes.config = config_table[i];
+		attributes.disabled = 1;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+		attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		benchmark_counter_file_table[i] = (int)syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+		if (benchmark_counter_file_table[i] != -1)
+			counter_opened = 1;
+	}
+#endif
+	return counter_opened;
+}
+
+static void benchmark_start_counters(void)
+{
+#ifdef __linux__
+	for (int i = 0; i != BENCHMARK_COUNTER_COUNT; ++i)
+		if (benchmark_counter_file_table[i] != -1)
+		{
+			ioctl(benchmark_counter_file_table[i], PERF_EVENT_IOC_RESET, 0);
+			ioctl(benchmark_counter_file_table[i], PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif
+}
+
+static void benchmark_stop_counters(double* count_table)
+{
+	for (int i = 0; i != BENCHMARK_COUNTER_COUNT; ++i)
+		count_table[i] = -1.0;
+#ifdef __linux__
+	for (int i = 0; i != BENCHMARK_COUNTER_COUNT; ++i)
+		if (benchmark_counter_file_table[i] != -1)
+			ioctl(benchmark_counter_file_table[i], PERF_EVENT_IOC_DISABLE, 0);
+	for (int i = 0; i != BENCHMARK_COUNTER_COUNT; ++i)
+	{
+		// The value is followed by the time the counter was enabled and the time it was actually counting.
+		uint64_t value[3];
+		if (benchmark_counter_file_table[i] != -1 && read(benchmark_counter_file_table[i], value, sizeof(value)) == (ssize_t)sizeof(value) && value[2])
+			count_table[i] = (double)value[0] * ((double)value[1] / (double)value[2]);
+	}
+#endif
+}
+
+static void benchmark_close_counters(void)
+{
+#ifdef __linux__
+	for (int i = 0; i != BENCHMARK_COUNTER_COUNT; ++i)
+		if (benchmark_counter_file_table[i] != -1)
+			close(benchmark_counter_file_table[i]);
+#endif
+}
+
+static size_t benchmark_count_nodes(const jsonl_value_t* value)
+{
+	size_t node_count = 1;
+	if (value->type == JSONL_TYPE_ARRAY)
+		for (size_t i = 0; i != value->array.value_count; ++i)
+			node_count += benchmark_count_nodes(value->array.table[i]);
+	else if (value->type == JSONL_TYPE_OBJECT)
+		for (size_t i = 0; i != value->object.value_count; ++i)
+			node_count += benchmark_count_nodes(value->object.table[i].value);
+	return node_count;
+}
+
+static size_t benchmark_parse_probe(benchmark_context_t* context)
+{
+	return jsonl_parse_text(context->text_size, context->text, 0, 0);
+}
+
+static size_t benchmark_parse(benchmark_context_t* context)
+{
+	return jsonl_parse_text(context->text_size, context->text, context->tree_size, context->tree);
+}
+
+static size_t benchmark_print(benchmark_context_t* context)
+{
+	return jsonl_print(context->tree, context->print_size, context->print_buffer);
+}
+
+static size_t benchmark_get_value(benchmark_context_t* context)
+{
+	size_t found_count = 0;
+	for (size_t i = 0; i != context->path_count; ++i)
+		found_count += jsonl_get_value(context->tree, context->path_length_table[i], context->path_table[i], 0) != 0;
+	return found_count;
+}
+
+static size_t benchmark_get_value_compiled(benchmark_context_t* context)
+{
+	size_t found_count = 0;
+	for (size_t i = 0; i != context->path_count; ++i)
+		found_count += jsonl_get_value_compiled(context->tree, context->compiled_path_table[i], 0) != 0;
+	return found_count;
+}
+
+static size_t benchmark_set_values(benchmark_context_t* context)
+{
+	return jsonl_set_values(context->tree, context->set_value_count, context->set_value_table, context->set_tree_size, context->set_tree);
+}
+
+static size_t benchmark_sweep_set_values(benchmark_context_t* context)
+{
+	return jsonl_set_values(context->tree, context->sweep_set_value_count, context->sweep_set_value_table, context->sweep_tree_size, context->sweep_tree);
+}
+
+static size_t benchmark_sweep_set_values_with_plan(benchmark_context_t* context)
+{
+	return jsonl_set_values_with_plan(context->tree, context->sweep_plan, context->sweep_tree_size, context->sweep_tree);
+}
+
+static size_t benchmark_sweep_set_values_sequential(benchmark_context_t* context)
+{
+	// Setting a leaf to a number never makes the tree larger, so every intermediate tree fits to the size of the source tree.
+	const jsonl_value_t* source_tree = context->tree;
+	jsonl_value_t* tree_table[2] = { context->sweep_tree, context->sweep_second_tree };
+	size_t tree_size = 0;
+	for (size_t i = 0; i != context->sweep_set_value_count; ++i)
+	{
+		tree_size = jsonl_set_values(source_tree, 1, context->sweep_set_value_table + i, context->tree_size, tree_table[i & 1]);
+		source_tree = tree_table[i & 1];
+	}
+	return tree_size;
+}
+
+static int benchmark_compare_double(const void* a, const void* b)
+{
+	double value_a = *(const double*)a;
+	double value_b = *(const double*)b;
+	return (value_a > value_b) - (value_a < value_b);
+}
+
+static void benchmark_measure(benchmark_context_t* context, const char* name, benchmark_operation_t operation, size_t operations_per_call, size_t bytes, double measuring_time)
+{
+	uint64_t batch_time_target = (uint64_t)(measuring_time * 1000000000.0 / (double)(BENCHMARK_BATCH_COUNT + 3));
+	uint64_t iterations = 1;
+	for (;;)
+	{
+		uint64_t begin = benchmark_time();
+		for (uint64_t i = 0; i != iterations; ++i)
+			benchmark_sink += operation(context);
+		if (benchmark_time() - begin >= batch_time_target || iterations >= ((uint64_t)1 << 32))
+			break;
+		iterations *= 2;
+	}
+
+	double time_table[BENCHMARK_BATCH_COUNT];
+	double count_table[BENCHMARK_COUNTER_COUNT];
+	if (benchmark_counters_enabled)
+		benchmark_start_counters();
+	for (int batch = 0; batch != BENCHMARK_BATCH_COUNT; ++batch)
+	{
+		uint64_t begin = benchmark_time();
+		for (uint64_t i = 0; i != iterations; ++i)
+			benchmark_sink += operation(context);
+		time_table[batch] = (double)(benchmark_time() - begin) / ((double)iterations * (double)operations_per_call);
+	}
+	if (benchmark_counters_enabled)
+		benchmark_stop_counters(count_table);
+	qsort(time_table, BENCHMARK_BATCH_COUNT, sizeof(double), benchmark_compare_double);
+	double median_time = time_table[BENCHMARK_BATCH_COUNT / 2];
+	printf("{\"benchmark\":\"%s\",\"corpus\":\"%s\",\"number_format\":\"%s\",\"bytes\":%zu,\"iterations\":%llu,\"best_ns_per_op\":%.1f,\"ns_per_op\":%.1f,\"mb_per_s\":%.1f",
+		name, context->corpus_name, BENCHMARK_NUMBER_FORMAT, bytes, (unsigned long long)iterations, time_table[0], median_time, (bytes && median_time > 0.0) ? ((double)bytes * 1000.0 / median_time) : 0.0);
+	if (context->sweep_set_value_count)
+		printf(",\"set_value_count\":%zu,\"node_count\":%zu", context->sweep_set_value_count, context->node_count);
+	if (benchmark_counters_enabled)
+	{
+		double operation_count = (double)BENCHMARK_BATCH_COUNT * (double)iterations * (double)operations_per_call;
+		for (int i = 0; i != BENCHMARK_COUNTER_COUNT; ++i)
+		{
+			if (count_table[i] < 0.0)
+				printf(",\"%s_per_byte\":null,\"%s_per_node\":null", benchmark_counter_name_table[i], benchmark_counter_name_table[i]);
+			else
+				printf(",\"%s_per_byte\":%.4f,\"%s_per_node\":%.4f",
+					benchmark_counter_name_table[i], count_table[i] / operation_count / (double)context->text_size,
+					benchmark_counter_name_table[i], count_table[i] / operation_count / (double)context->node_count);
+		}
+	}
+	printf("}\n");
+	fflush(stdout);
+}
+
+static uint64_t benchmark_random(uint64_t* state)
+{
+	uint64_t value = (*state += (uint64_t)0x9E3779B97F4A7C15);
+	value = (value ^ (value >> 30)) * (uint64_t)0xBF58476D1CE4E5B9;
+	value = (value ^ (value >> 27)) * (uint64_t)0x94D049BB133111EB;
+	return value ^ (value >> 31);
+}
+
+static size_t benchmark_random_path(const jsonl_value_t* value, uint64_t* random_state, jsonl_path_component_t* path)
+{
+	size_t path_length = 0;
+	while (path_length != BENCHMARK_MAXIMUM_PATH_LENGTH)
+	{
+		if (value->type == JSONL_TYPE_ARRAY && value->array.value_count)
+		{
+			size_t index = (size_t)(benchmark_random(random_state) % value->array.value_count);
+			path[path_length].container_type = JSONL_TYPE_ARRAY;
+			path[path_length].index = index;
+			value = value->array.table[index];
+		}
+		else if (value->type == JSONL_TYPE_OBJECT && value->object.value_count)
+		{
+			size_t index = (size_t)(benchmark_random(random_state) % value->object.value_count);
+			path[path_length].container_type = JSONL_TYPE_OBJECT;
+			path[path_length].name.length = value->object.table[index].name_length;
+			path[path_length].name.value = value->object.table[index].name;
+			value = value->object.table[index].value;
+		}
+		else
+			break;
+		++path_length;
+	}
+	return path_length;
+}
+
+static int benchmark_path_equal(size_t path_length_a, const jsonl_path_component_t* path_a, size_t path_length_b, const jsonl_path_component_t* path_b)
+{
+	if (path_length_a != path_length_b)
+		return 0;
+	for (size_t i = 0; i != path_length_a; ++i)
+	{
+		if (path_a[i].container_type != path_b[i].container_type)
+			return 0;
+		if (path_a[i].container_type == JSONL_TYPE_ARRAY ? (path_a[i].index != path_b[i].index) : (path_a[i].name.value != path_b[i].name.value))
+			return 0;
+	}
+	return 1;
+}
+
+static benchmark_context_t* benchmark_create_context(const char* corpus_name, size_t text_size, const char* text)
+{
+	benchmark_context_t* context = (benchmark_context_t*)calloc(1, sizeof(benchmark_context_t));
+	if (!context)
+	{
+		fprintf(stderr, "benchmark: out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	context->corpus_name = corpus_name;
+	context->text_size = text_size;
+	context->text = text;
+	context->tree_size = jsonl_parse_text(text_size, text, 0, 0);
+	context->tree = context->tree_size ? (jsonl_value_t*)malloc(context->tree_size) : 0;
+	if (!context->tree || jsonl_parse_text(text_size, text, context->tree_size, context->tree) != context->tree_size)
+	{
+		fprintf(stderr, "benchmark: parsing %s failed\n", corpus_name);
+		free(context->tree);
+		free(context);
+		return 0;
+	}
+	context->node_count = benchmark_count_nodes(context->tree);
+	return context;
+}
+
+static void benchmark_corpus(const char* corpus_name, size_t text_size, const char* text, double measuring_time)
+{
+	benchmark_context_t* context = benchmark_create_context(corpus_name, text_size, text);
+	if (!context)
+		return;
+	context->print_size = jsonl_print(context->tree, 0, 0);
+	context->print_buffer = (char*)malloc(context->print_size ? context->print_size : 1);
+
+	// The lookups and the modifications are done to paths selected by random walks from the root.
+	uint64_t random_state = 1;
+	context->path_count = BENCHMARK_PATH_COUNT;
+	for (size_t i = 0; i != BENCHMARK_PATH_COUNT; ++i)
+		context->path_length_table[i] = benchmark_random_path(context->tree, &random_state, context->path_table[i]);
+
+	// The same paths are compiled once for the compiled lookups. The compiled paths are stored one after another to one buffer.
+	for (size_t i = 0; i != BENCHMARK_PATH_COUNT; ++i)
+		context->compiled_path_buffer_size += jsonl_compile_path(context->path_length_table[i], context->path_table[i], 0, 0);
+	context->compiled_path_buffer = malloc(context->compiled_path_buffer_size);
+	for (size_t offset = 0, i = 0; context->compiled_path_buffer && i != BENCHMARK_PATH_COUNT; ++i)
+	{
+		jsonl_compiled_path_t* compiled_path = (jsonl_compiled_path_t*)((char*)context->compiled_path_buffer + offset);
+		offset += jsonl_compile_path(context->path_length_table[i], context->path_table[i], context->compiled_path_buffer_size - offset, compiled_path);
+		context->compiled_path_table[i] = compiled_path;
+		// The walked paths point to the names of the tree, which would be matched by address. Copies of the names are used like by real lookups.
+		for (size_t j = 0; j != context->path_length_table[i]; ++j)
+			if (context->path_table[i][j].container_type == JSONL_TYPE_OBJECT)
+				context->path_table[i][j].name.value = compiled_path->path_table[j].name;
+	}
+	memset(&context->set_value, 0, sizeof(jsonl_value_t));
+	context->set_value.type = JSONL_TYPE_NUMBER;
+	for (size_t i = 0; i != BENCHMARK_PATH_COUNT && context->set_value_count != BENCHMARK_SET_VALUE_COUNT; ++i)
+	{
+		int duplicate = !context->path_length_table[i];
+		for (size_t j = 0; !duplicate && j != context->set_value_count; ++j)
+			duplicate = benchmark_path_equal(context->path_length_table[i], context->path_table[i], context->set_value_table[j].path_length, context->set_value_table[j].path);
+		if (!duplicate)
+		{
+			context->set_value_table[context->set_value_count].path_length = context->path_length_table[i];
+			context->set_value_table[context->set_value_count].path = context->path_table[i];
+			context->set_value_table[context->set_value_count].value = &context->set_value;
+			++context->set_value_count;
+		}
+	}
+	context->set_tree_size = jsonl_set_values(context->tree, context->set_value_count, context->set_value_table, 0, 0);
+	context->set_tree = (jsonl_value_t*)malloc(context->set_tree_size ? context->set_tree_size : 1);
+
+	if (!context->print_size || !context->print_buffer || !context->compiled_path_buffer || !context->set_tree_size || !context->set_tree)
+		fprintf(stderr, "benchmark: preparing %s failed\n", corpus_name);
+	else
+	{
+		benchmark_measure(context, "parse_probe", benchmark_parse_probe, 1, text_size, measuring_time);
+		benchmark_measure(context, "parse", benchmark_parse, 1, text_size, measuring_time);
+		benchmark_measure(context, "print", benchmark_print, 1, context->print_size, measuring_time);
+		benchmark_measure(context, "get_value", benchmark_get_value, context->path_count, 0, measuring_time);
+		benchmark_measure(context, "get_value_compiled", benchmark_get_value_compiled, context->path_count, 0, measuring_time);
+		benchmark_measure(context, "set_values", benchmark_set_values, 1, context->set_tree_size, measuring_time);
+	}
+	free(context->set_tree);
+	free(context->compiled_path_buffer);
+	free(context->print_buffer);
+	free(context->tree);
+	free(context);
+}
+
+static void benchmark_set_values_sweep(const char* corpus_name, size_t text_size, const char* text, double measuring_time)
+{
+	benchmark_context_t* context = benchmark_create_context(corpus_name, text_size, text);
+	if (!context)
+		return;
+	size_t maximum_set_value_count = benchmark_sweep_set_value_count_table[BENCHMARK_SWEEP_SET_VALUE_COUNT_COUNT - 1];
+	jsonl_path_component_t* path_buffer = (jsonl_path_component_t*)malloc(BENCHMARK_MAXIMUM_PATH_LENGTH * sizeof(jsonl_path_component_t));
+	context->sweep_set_value_table = (jsonl_set_value_t*)malloc(maximum_set_value_count * sizeof(jsonl_set_value_t));
+	if (!path_buffer || !context->sweep_set_value_table)
+	{
+		fprintf(stderr, "benchmark: out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// Random walks end at leaves, so distinct paths never overlap. Walks are tried until the table is full or most walks find leaves already selected.
+	memset(&context->set_value, 0, sizeof(jsonl_value_t));
+	context->set_value.type = JSONL_TYPE_NUMBER;
+	uint64_t random_state = 1;
+	size_t set_value_count = 0;
+	for (size_t attempt = 0; set_value_count != maximum_set_value_count && attempt != 4 * maximum_set_value_count; ++attempt)
+	{
+		size_t path_length = benchmark_random_path(context->tree, &random_state, path_buffer);
+		int duplicate = !path_length;
+		for (size_t i = 0; !duplicate && i != set_value_count; ++i)
+			duplicate = benchmark_path_equal(path_length, path_buffer, context->sweep_set_value_table[i].path_length, context->sweep_set_value_table[i].path);
+		if (!duplicate)
+		{
+			jsonl_path_component_t* path = (jsonl_path_component_t*)malloc(path_length * sizeof(jsonl_path_component_t));
+			if (!path)
+			{
+				fprintf(stderr, "benchmark: out of memory\n");
+				exit(EXIT_FAILURE);
+			}
+			memcpy(path, path_buffer, path_length * sizeof(jsonl_path_component_t));
+			context->sweep_set_value_table[set_value_count].path_length = path_length;
+			context->sweep_set_value_table[set_value_count].path = path;
+			context->sweep_set_value_table[set_value_count].value = &context->set_value;
+			++set_value_count;
+		}
+	}
+
+	for (size_t i = 0; i != BENCHMARK_SWEEP_SET_VALUE_COUNT_COUNT && (!i || benchmark_sweep_set_value_count_table[i - 1] < set_value_count); ++i)
+	{
+		context->sweep_set_value_count = (benchmark_sweep_set_value_count_table[i] < set_value_count) ? benchmark_sweep_set_value_count_table[i] : set_value_count;
+		size_t plan_size = jsonl_create_set_values_plan(context->sweep_set_value_count, context->sweep_set_value_table, 0, 0);
+		context->sweep_plan = plan_size ? (jsonl_set_values_plan_t*)malloc(plan_size) : 0;
+		if (context->sweep_plan)
+			jsonl_create_set_values_plan(context->sweep_set_value_count, context->sweep_set_value_table, plan_size, context->sweep_plan);
+		// A plan that does not fit to the stack is stored in the value buffer, so the size probe may need to be repeated.
+		context->sweep_tree_size = 0;
+		for (size_t size = jsonl_set_values(context->tree, context->sweep_set_value_count, context->sweep_set_value_table, 0, 0); size > context->sweep_tree_size;)
+		{
+			free(context->sweep_tree);
+			context->sweep_tree_size = size;
+			context->sweep_tree = (jsonl_value_t*)malloc(size);
+			size = context->sweep_tree ? jsonl_set_values(context->tree, context->sweep_set_value_count, context->sweep_set_value_table, context->sweep_tree_size, context->sweep_tree) : 0;
+		}
+		int sequential = context->sweep_set_value_count <= BENCHMARK_SEQUENTIAL_MAXIMUM_SIZE / context->tree_size;
+		if (sequential)
+		{
+			context->sweep_tree = (jsonl_value_t*)realloc(context->sweep_tree, (context->sweep_tree_size > context->tree_size) ? context->sweep_tree_size : context->tree_size);
+			context->sweep_second_tree = (jsonl_value_t*)malloc(context->tree_size);
+		}
+
+		if (!context->sweep_plan || !context->sweep_tree_size || !context->sweep_tree || (sequential && !context->sweep_second_tree))
+			fprintf(stderr, "benchmark: preparing %s failed\n", corpus_name);
+		else
+		{
+			size_t set_tree_size = jsonl_set_values_with_plan(context->tree, context->sweep_plan, 0, 0);
+			benchmark_measure(context, "set_values", benchmark_sweep_set_values, 1, set_tree_size, measuring_time);
+			benchmark_measure(context, "set_values_with_plan", benchmark_sweep_set_values_with_plan, 1, set_tree_size, measuring_time);
+			if (sequential)
+				benchmark_measure(context, "set_values_sequential", benchmark_sweep_set_values_sequential, 1, set_tree_size, measuring_time);
+		}
+		free(context->sweep_second_tree);
+		free(context->sweep_tree);
+		free(context->sweep_plan);
+		context->sweep_second_tree = 0;
+		context->sweep_tree = 0;
+		context->sweep_plan = 0;
+	}
+
+	for (size_t i = 0; i != set_value_count; ++i)
+		free((void*)context->sweep_set_value_table[i].path);
+	free(context->sweep_set_value_table);
+	free(path_buffer);
+	free(context->tree);
+	free(context);
+}
+
+int main(int argc, char** argv)
+{
+	static const char* default_shape_table[] = { "twitter", "canada", "nested", "wide" };
+	const char* shape_table[BENCHMARK_MAXIMUM_SHAPE_COUNT];
+	size_t shape_count = 0;
+	size_t file_count = 0;
+	double measuring_time = 0.5;
+	size_t corpus_size = 1 << 20;
+	uint64_t seed = 1;
+	int set_values_sweep = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "-t") && i + 1 < argc)
+			measuring_time = strtod(argv[++i], 0);
+		else if (!strcmp(argv[i], "-s") && i + 1 < argc)
+			corpus_size = (size_t)strtoull(argv[++i], 0, 0);
+		else if (!strcmp(argv[i], "-r") && i + 1 < argc)
+			seed = (uint64_t)strtoull(argv[++i], 0, 0);
+		else if (!strcmp(argv[i], "-c") && i + 1 < argc && shape_count != BENCHMARK_MAXIMUM_SHAPE_COUNT)
+			shape_table[shape_count++] = argv[++i];
+		else if (!strcmp(argv[i], "-p"))
+			benchmark_counters_enabled = 1;
+		else if (!strcmp(argv[i], "-k"))
+			set_values_sweep = 1;
+		else if (argv[i][0] == '-')
+		{
+			fprintf(stderr, "usage: %s [-t seconds] [-s corpus_size] [-r seed] [-c shape] [-p] [-k] [file ...]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+		else
+			++file_count;
+	}
+	if (!shape_count && !file_count)
+	{
+		for (size_t i = 0; i != sizeof(default_shape_table) / sizeof(*default_shape_table); ++i)
+			shape_table[shape_count++] = default_shape_table[i];
+	}
+
+	if (benchmark_counters_enabled && !benchmark_open_counters())
+	{
+		fprintf(stderr, "benchmark: performance counters are not available\n");
+		benchmark_counters_enabled = 0;
+	}
+
+	int error = 0;
+	for (size_t i = 0; i != shape_count; ++i)
+	{
+		for (int size_index = set_values_sweep ? 0 : (BENCHMARK_SWEEP_SIZE_COUNT - 1); size_index != BENCHMARK_SWEEP_SIZE_COUNT; ++size_index)
+		{
+			// The sweep sizes are 1/16, 1/4 and 1 times the corpus size.
+			corpus_text_t text;
+			memset(&text, 0, sizeof(corpus_text_t));
+			if (corpus_generate(shape_table[i], seed, corpus_size >> (2 * (BENCHMARK_SWEEP_SIZE_COUNT - 1 - size_index)), 0, &text))
+			{
+				if (set_values_sweep)
+					benchmark_set_values_sweep(shape_table[i], text.size, text.data, measuring_time);
+				else
+					benchmark_corpus(shape_table[i], text.size, text.data, measuring_time);
+			}
+			else
+			{
+				fprintf(stderr, "benchmark: generating corpus %s failed\n", shape_table[i]);
+				error = 1;
+			}
+			corpus_free(&text);
+		}
+	}
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "-p") || !strcmp(argv[i], "-k"))
+			continue;
+		if (argv[i][0] == '-')
+		{
+			++i;
+			continue;
+		}
+		jsonl_file_t file;
+		if (jsonl_file_map(argv[i], &file))
+		{
+			if (set_values_sweep)
+				benchmark_set_values_sweep(argv[i], file.size, file.data, measuring_time);
+			else
+				benchmark_corpus(argv[i], file.size, file.data, measuring_time);
+			jsonl_file_unmap(&file);
+		}
+		else
+		{
+			fprintf(stderr, "benchmark: reading file %s failed\n", argv[i]);
+			error = 1;
+		}
+	}
+	if (benchmark_counters_enabled)
+		benchmark_close_counters();
+	return error ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,498 @@
+/*
+	Synthetic JSON corpus generator used by the benchmarks of JSON library.
+	Documentation is provided in the file "corpus.h".
+*/
+
+#include "corpus.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CORPUS_NESTED_DEPTH 48
+
+#define CORPUS_CHUNK_SIZE 65536
+
+#define CORPUS_CONTAINER_PERCENT 30
+
+typedef struct corpus_random_t
+{
+	uint64_t state;
+} corpus_random_t;
+
+static uint64_t corpus_random_next(corpus_random_t* random)
+{
+	// splitmix64
+	uint64_t value = (random->state += (uint64_t)0x9E3779B97F4A7C15);
+	value = (value ^ (value >> 30)) * (uint64_t)0xBF58476D1CE4E5B9;
+	value = (value ^ (value >> 27)) * (uint64_t)0x94D049BB133111EB;
+	return value ^ (value >> 31);
+}
+
+static uint64_t corpus_random_below(corpus_random_t* random, uint64_t limit)
+{
+	return limit ? (corpus_random_next(random) % limit) : 0;
+}
+
+static double corpus_random_unit(corpus_random_t* random)
+{
+	return (double)(corpus_random_next(random) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static int corpus_write(corpus_text_t* text)
+{
+	if (!text->error && text->write_callback && text->size)
+	{
+		if (!text->write_callback(text->write_context, text->size, text->data))
+			text->error = 1;
+		text->size = 0;
+		text->data[0] = 0;
+	}
+	return !text->error;
+}
+
+static void corpus_append(corpus_text_t* text, size_t size, const char* data)
+{
+	if (text->error)
+		return;
+	if (text->write_callback && text->size + size + 1 > text->capacity)
+		corpus_write(text);
+	if (text->size + size + 1 > text->capacity)
+	{
+		size_t capacity = text->capacity ? text->capacity : CORPUS_CHUNK_SIZE;
+		while (text->size + size + 1 > capacity)
+			capacity *= 2;
+		char* data_buffer = (char*)realloc(text->data, capacity);
+		if (!data_buffer)
+		{
+			text->error = 1;
+			return;
+		}
+		text->data = data_buffer;
+		text->capacity = capacity;
+	}
+	memcpy(text->data + text->size, data, size);
+	text->size += size;
+	text->total_size += size;
+	text->data[text->size] = 0;
+}
+
+static void corpus_append_string(corpus_text_t* text, const char* string)
+{
+	corpus_append(text, strlen(string), string);
+}
+
+static void corpus_append_format(corpus_text_t* text, const char* format, ...)
+{
+	char buffer[256];
+	va_list arguments;
+	va_start(arguments, format);
+	int length = vsnprintf(buffer, sizeof(buffer), format, arguments);
+	va_end(arguments);
+	if (length < 0 || (size_t)length >= sizeof(buffer))
+		text->error = 1;
+	else
+		corpus_append(text, (size_t)length, buffer);
+}
+
+static void corpus_append_words(corpus_random_t* random, corpus_text_t* text, size_t word_count)
+{
+	static const char* word_table[] = { "json", "parse", "tree", "value", "the", "quick", "fox", "caf\\u00e9", "line\\nbreak", "\\\"quoted\\\"", "path\\/to", "tab\\tbed", "data", "stream" };
+	corpus_append_string(text, "\"");
+	for (size_t i = 0; i != word_count; ++i)
+	{
+		if (i)
+			corpus_append_string(text, " ");
+		corpus_append_string(text, word_table[corpus_random_below(random, sizeof(word_table) / sizeof(*word_table))]);
+	}
+	corpus_append_string(text, "\"");
+}
+
+static void corpus_append_line_break(corpus_text_t* text, const corpus_parameters_t* parameters)
+{
+	if (!parameters->single_line)
+		corpus_append_string(text, "\n");
+}
+
+static void corpus_append_random_string(corpus_random_t* random, corpus_text_t* text, const corpus_parameters_t* parameters, size_t length)
+{
+	static const char character_table[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 .,-";
+	static const char* escape_table[] = { "\\n", "\\t", "\\r", "\\b", "\\f", "\\\"", "\\\\", "\\/", "\\u00e9", "\\u20ac", "\\ud83d\\ude00", "\\u0001" };
+	uint64_t escape_threshold = (uint64_t)(parameters->escape_density * 1000000.0);
+	corpus_append_string(text, "\"");
+	for (size_t i = 0; i != length; ++i)
+	{
+		if (corpus_random_below(random, 1000000) < escape_threshold)
+			corpus_append_string(text, escape_table[corpus_random_below(random, sizeof(escape_table) / sizeof(*escape_table))]);
+		else
+			corpus_append(text, 1, character_table + corpus_random_below(random, sizeof(character_table) - 1));
+	}
+	corpus_append_string(text, "\"");
+}
+
+static void corpus_append_random_key(corpus_random_t* random, corpus_text_t* text, const corpus_parameters_t* parameters, uint64_t member_index)
+{
+	// Keys begin with the member index and an underscore, so names of one object are unique also after escapes are decoded.
+	static const char character_table[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+	char key[32];
+	size_t key_length = 0;
+	do
+	{
+		key[key_length++] = character_table[member_index % 36];
+		member_index /= 36;
+	} while (member_index);
+	key[key_length++] = '_';
+	size_t length = (size_t)(parameters->minimum_key_length + corpus_random_below(random, parameters->maximum_key_length - parameters->minimum_key_length + 1));
+	uint64_t escape_threshold = (uint64_t)(parameters->escape_density * 1000000.0);
+	corpus_append_string(text, "\"");
+	corpus_append(text, key_length, key);
+	for (size_t i = key_length; i < length; ++i)
+	{
+		char character = character_table[corpus_random_below(random, sizeof(character_table) - 1)];
+		if (corpus_random_below(random, 1000000) < escape_threshold)
+			corpus_append_format(text, "\\u%04x", (unsigned int)character);
+		else
+			corpus_append(text, 1, &character);
+	}
+	corpus_append_string(text, "\"");
+}
+
+static void corpus_append_random_number(corpus_random_t* random, corpus_text_t* text, const corpus_parameters_t* parameters)
+{
+	// Numbers are written from random digits instead of formatting floating point values, so the text does not depend on the C library.
+	const char* sign = corpus_random_below(random, 2) ? "-" : "";
+	switch (parameters->number_distribution)
+	{
+		case CORPUS_NUMBERS_INTEGER:
+			corpus_append_format(text, "%s%llu", sign, (unsigned long long)corpus_random_below(random, 1000000001));
+			break;
+		case CORPUS_NUMBERS_SCIENTIFIC:
+		{
+			corpus_append_format(text, "%s%u.", sign, (unsigned int)(1 + corpus_random_below(random, 9)));
+			for (int i = 0; i != 16; ++i)
+				corpus_append_format(text, "%u", (unsigned int)corpus_random_below(random, 10));
+			corpus_append_format(text, "e%d", (int)corpus_random_below(random, 601) - 300);
+			break;
+		}
+		default:
+		{
+			corpus_append_format(text, "%s%u.", sign, (unsigned int)corpus_random_below(random, 1000));
+			for (uint64_t i = 0, digit_count = 1 + corpus_random_below(random, 15); i != digit_count; ++i)
+				corpus_append_format(text, "%u", (unsigned int)corpus_random_below(random, 10));
+			break;
+		}
+	}
+}
+
+static void corpus_append_number(corpus_text_t* text, const corpus_parameters_t* parameters, const char* decimal_format, double value)
+{
+	// Shapes that model real documents compute their numbers, but the numbers still follow the number distribution. Decimal numbers keep the format of the shape.
+	switch (parameters->number_distribution)
+	{
+		case CORPUS_NUMBERS_INTEGER:
+			corpus_append_format(text, "%.0f", value);
+			break;
+		case CORPUS_NUMBERS_SCIENTIFIC:
+			corpus_append_format(text, "%.16e", value);
+			break;
+		default:
+			corpus_append_format(text, decimal_format, value);
+			break;
+	}
+}
+
+static void corpus_append_random_scalar(corpus_random_t* random, corpus_text_t* text, const corpus_parameters_t* parameters)
+{
+	switch (corpus_random_below(random, 8))
+	{
+		case 0:
+		case 1:
+		case 2:
+			corpus_append_random_string(random, text, parameters, (size_t)corpus_random_below(random, 33));
+			break;
+		case 3:
+		case 4:
+		case 5:
+			corpus_append_random_number(random, text, parameters);
+			break;
+		case 6:
+			corpus_append_string(text, corpus_random_below(random, 2) ? "true" : "false");
+			break;
+		default:
+			corpus_append_string(text, "null");
+			break;
+	}
+}
+
+static void corpus_append_random_value(corpus_random_t* random, corpus_text_t* text, const corpus_parameters_t* parameters, size_t depth, size_t end_size)
+{
+	// Containers stop adding children when the text reaches the target size, so the size of the text stays close to the target.
+	if (depth >= parameters->depth || !parameters->fan_out || corpus_random_below(random, 100) >= CORPUS_CONTAINER_PERCENT)
+	{
+		corpus_append_random_scalar(random, text, parameters);
+		return;
+	}
+	int object = (int)corpus_random_below(random, 2);
+	uint64_t child_count = corpus_random_below(random, (uint64_t)parameters->fan_out + 1);
+	corpus_append_string(text, object ? "{" : "[");
+	for (uint64_t i = 0; !text->error && i != child_count && text->total_size < end_size; ++i)
+	{
+		if (i)
+			corpus_append_string(text, ",");
+		if (object)
+		{
+			corpus_append_random_key(random, text, parameters, i);
+			corpus_append_string(text, ":");
+		}
+		corpus_append_random_value(random, text, parameters, depth + 1, end_size);
+	}
+	corpus_append_string(text, object ? "}" : "]");
+}
+
+static void corpus_generate_twitter(corpus_random_t* random, size_t target_size, const corpus_parameters_t* parameters, corpus_text_t* text)
+{
+	uint64_t end_size = text->total_size + target_size;
+	corpus_append_string(text, "{\"statuses\":[");
+	for (uint64_t i = 0; !text->error && (!i || text->total_size < end_size); ++i)
+	{
+		uint64_t id = (uint64_t)505874924095815681 + i * 7919;
+		uint64_t user_id = corpus_random_below(random, 3000000000);
+		if (i)
+			corpus_append_string(text, ",");
+		corpus_append_line_break(text, parameters);
+		corpus_append_format(text, "{\"created_at\":\"Sun Aug 31 00:%02u:%02u +0000 2014\",\"id\":%llu,\"id_str\":\"%llu\",\"text\":",
+			(unsigned int)corpus_random_below(random, 60), (unsigned int)corpus_random_below(random, 60), (unsigned long long)id, (unsigned long long)id);
+		corpus_append_words(random, text, 4 + (size_t)corpus_random_below(random, 16));
+		corpus_append_format(text, ",\"truncated\":false,\"in_reply_to_status_id\":null,\"user\":{\"id\":%llu,\"id_str\":\"%llu\",\"name\":", (unsigned long long)user_id, (unsigned long long)user_id);
+		corpus_append_words(random, text, 2);
+		corpus_append_format(text, ",\"screen_name\":\"user_%llu\",\"description\":", (unsigned long long)user_id);
+		corpus_append_words(random, text, (size_t)corpus_random_below(random, 12));
+		corpus_append_format(text, ",\"followers_count\":%u,\"friends_count\":%u,\"verified\":%s,\"lang\":\"en\"},\"entities\":{\"hashtags\":[",
+			(unsigned int)corpus_random_below(random, 100000), (unsigned int)corpus_random_below(random, 5000), corpus_random_below(random, 10) ? "false" : "true");
+		for (uint64_t j = 0, hashtag_count = corpus_random_below(random, 4); j != hashtag_count; ++j)
+		{
+			uint64_t begin = corpus_random_below(random, 100);
+			corpus_append_format(text, "%s{\"text\":\"tag%u\",\"indices\":[%u,%u]}", j ? "," : "", (unsigned int)corpus_random_below(random, 1000), (unsigned int)begin, (unsigned int)(begin + 5));
+		}
+		corpus_append_format(text, "],\"urls\":[]},\"retweet_count\":%u,\"favorite_count\":%u,\"favorited\":false,\"retweeted\":false,\"lang\":\"en\"}",
+			(unsigned int)corpus_random_below(random, 1000), (unsigned int)corpus_random_below(random, 1000));
+	}
+	corpus_append_string(text, "],\"search_metadata\":{\"completed_in\":");
+	corpus_append_number(text, parameters, "%.3f", 0.087);
+	corpus_append_string(text, ",\"max_id\":505874924095815681,\"query\":\"%E4%B8%80\",\"count\":100}}");
+}
+
+static void corpus_generate_canada(corpus_random_t* random, size_t target_size, const corpus_parameters_t* parameters, corpus_text_t* text)
+{
+	uint64_t end_size = text->total_size + target_size;
+	corpus_append_string(text, "{\"type\":\"FeatureCollection\",\"features\":[{\"type\":\"Feature\",\"properties\":{\"name\":\"Canada\"},\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[");
+	double longitude = -65.613616999999977;
+	double latitude = 43.420273000000009;
+	for (uint64_t i = 0; !text->error && (!i || text->total_size < end_size); ++i)
+	{
+		if (i)
+			corpus_append_string(text, ",");
+		corpus_append_line_break(text, parameters);
+		corpus_append_string(text, "[");
+		for (uint64_t j = 0, point_count = 16 + corpus_random_below(random, 48); j != point_count; ++j)
+		{
+			longitude += (corpus_random_unit(random) - 0.5) * 0.01;
+			latitude += (corpus_random_unit(random) - 0.5) * 0.01;
+			corpus_append_string(text, j ? ",[" : "[");
+			corpus_append_number(text, parameters, "%.17g", longitude);
+			corpus_append_string(text, ",");
+			corpus_append_number(text, parameters, "%.17g", latitude);
+			corpus_append_string(text, "]");
+		}
+		corpus_append_string(text, "]");
+	}
+	corpus_append_string(text, "]}}]}");
+}
+
+static void corpus_generate_nested(corpus_random_t* random, size_t target_size, const corpus_parameters_t* parameters, corpus_text_t* text)
+{
+	uint64_t end_size = text->total_size + target_size;
+	corpus_append_string(text, "[");
+	for (uint64_t i = 0; !text->error && (!i || text->total_size < end_size); ++i)
+	{
+		if (i)
+			corpus_append_string(text, ",");
+		corpus_append_line_break(text, parameters);
+		for (int level = 0; level != CORPUS_NESTED_DEPTH; ++level)
+			corpus_append_format(text, "{\"level\":%d,\"id\":%u,\"children\":[", level, (unsigned int)corpus_random_below(random, 1000000));
+		corpus_append_string(text, "null");
+		for (int level = 0; level != CORPUS_NESTED_DEPTH; ++level)
+			corpus_append_format(text, ",%s]}", corpus_random_below(random, 2) ? "true" : "\"leaf\"");
+	}
+	corpus_append_string(text, "]");
+}
+
+static void corpus_generate_wide(corpus_random_t* random, size_t target_size, const corpus_parameters_t* parameters, corpus_text_t* text)
+{
+	uint64_t end_size = text->total_size + target_size;
+	corpus_append_string(text, "{");
+	for (uint64_t i = 0; !text->error && (!i || text->total_size < end_size); ++i)
+	{
+		if (i)
+			corpus_append_string(text, ",");
+		corpus_append_line_break(text, parameters);
+		corpus_append_format(text, "\"member_%08llx\":", (unsigned long long)corpus_random_next(random));
+		switch (corpus_random_below(random, 4))
+		{
+			case 0:
+				corpus_append_format(text, "%u", (unsigned int)corpus_random_below(random, 1000000000));
+				break;
+			case 1:
+				corpus_append_number(text, parameters, "%.6f", corpus_random_unit(random) * 1000.0);
+				break;
+			case 2:
+				corpus_append_words(random, text, 1 + (size_t)corpus_random_below(random, 3));
+				break;
+			default:
+				corpus_append_string(text, corpus_random_below(random, 2) ? "true" : "null");
+				break;
+		}
+	}
+	corpus_append_string(text, "}");
+}
+
+static void corpus_generate_random(corpus_random_t* random, size_t target_size, const corpus_parameters_t* parameters, corpus_text_t* text)
+{
+	uint64_t end_size = text->total_size + target_size;
+	corpus_append_string(text, "{");
+	for (uint64_t i = 0; !text->error && (!i || text->total_size < end_size); ++i)
+	{
+		if (i)
+			corpus_append_string(text, ",");
+		corpus_append_line_break(text, parameters);
+		corpus_append_random_key(random, text, parameters, i);
+		corpus_append_string(text, ":");
+		corpus_append_random_value(random, text, parameters, 1, end_size);
+	}
+	corpus_append_string(text, "}");
+}
+
+static void corpus_generate_deep(corpus_random_t* random, size_t target_size, const corpus_parameters_t* parameters, corpus_text_t* text)
+{
+	size_t depth = parameters->depth ? parameters->depth : 1;
+	size_t padding_length = target_size / depth > 32 ? (target_size / depth - 32) : 0;
+	for (size_t level = 0; !text->error && level != depth; ++level)
+	{
+		if (level & 1)
+		{
+			corpus_append_string(text, "[");
+			corpus_append_random_string(random, text, parameters, padding_length);
+			corpus_append_string(text, ",");
+		}
+		else
+		{
+			corpus_append_string(text, "{\"padding\":");
+			corpus_append_random_string(random, text, parameters, padding_length);
+			corpus_append_string(text, ",\"next\":");
+		}
+	}
+	corpus_append_string(text, "null");
+	for (size_t level = depth; !text->error && level--;)
+		corpus_append_string(text, (level & 1) ? "]" : "}");
+}
+
+static void corpus_generate_flat_array(corpus_random_t* random, size_t target_size, const corpus_parameters_t* parameters, corpus_text_t* text)
+{
+	uint64_t end_size = text->total_size + target_size;
+	corpus_append_string(text, "[");
+	for (uint64_t i = 0; !text->error && (!i || text->total_size < end_size); ++i)
+	{
+		if (i)
+			corpus_append_string(text, ",");
+		if (i % 16 == 0)
+			corpus_append_line_break(text, parameters);
+		if (corpus_random_below(random, 4))
+			corpus_append_random_number(random, text, parameters);
+		else
+			corpus_append_random_string(random, text, parameters, (size_t)corpus_random_below(random, 17));
+	}
+	corpus_append_string(text, "]");
+}
+
+static int corpus_generate_shape(const char* shape, corpus_random_t* random, size_t target_size, const corpus_parameters_t* parameters, corpus_text_t* text)
+{
+	static const struct
+	{
+		const char* name;
+		void (*generate)(corpus_random_t* random, size_t target_size, const corpus_parameters_t* parameters, corpus_text_t* text);
+	} shape_table[] = {
+		{ "twitter", corpus_generate_twitter },
+		{ "canada", corpus_generate_canada },
+		{ "nested", corpus_generate_nested },
+		{ "wide", corpus_generate_wide },
+		{ "random", corpus_generate_random },
+		{ "deep", corpus_generate_deep },
+		{ "flat_array", corpus_generate_flat_array } };
+	for (size_t i = 0; i != sizeof(shape_table) / sizeof(*shape_table); ++i)
+		if (!strcmp(shape, shape_table[i].name))
+		{
+			shape_table[i].generate(random, target_size, parameters, text);
+			return !text->error;
+		}
+	return 0;
+}
+
+int corpus_generate(const char* shape, uint64_t seed, size_t target_size, const corpus_parameters_t* parameters, corpus_text_t* text)
+{
+	corpus_parameters_t default_parameters;
+	if (!parameters)
+	{
+		corpus_default_parameters(&default_parameters);
+		parameters = &default_parameters;
+	}
+	if (parameters->minimum_key_length > parameters->maximum_key_length)
+		return 0;
+	corpus_random_t random = { seed };
+	return corpus_generate_shape(shape, &random, target_size, parameters, text);
+}
+
+int corpus_generate_records(const char* shape, uint64_t seed, uint64_t record_count, size_t record_size, const corpus_parameters_t* parameters, corpus_text_t* text)
+{
+	corpus_parameters_t record_parameters;
+	if (parameters)
+		record_parameters = *parameters;
+	else
+		corpus_default_parameters(&record_parameters);
+	if (record_parameters.minimum_key_length > record_parameters.maximum_key_length)
+		return 0;
+	record_parameters.single_line = 1;
+	corpus_random_t random = { seed };
+	for (uint64_t i = 0; i != record_count; ++i)
+	{
+		if (!corpus_generate_shape(shape, &random, record_size, &record_parameters, text))
+			return 0;
+		corpus_append_string(text, "\n");
+	}
+	return !text->error;
+}
+
+void corpus_default_parameters(corpus_parameters_t* parameters)
+{
+	parameters->depth = 8;
+	parameters->fan_out = 16;
+	parameters->minimum_key_length = 4;
+	parameters->maximum_key_length = 16;
+	parameters->escape_density = 0.02;
+	parameters->number_distribution = CORPUS_NUMBERS_DECIMAL;
+	parameters->single_line = 0;
+}
+
+int corpus_flush(corpus_text_t* text)
+{
+	return corpus_write(text);
+}
+
+void corpus_free(corpus_text_t* text)
+{
+	free(text->data);
+	text->size = 0;
+	text->capacity = 0;
+	text->data = 0;
+	text->total_size = 0;
+	text->error = 0;
+}
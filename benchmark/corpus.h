@@ -0,0 +1,231 @@
+/*
+	Synthetic JSON corpus generator used by the benchmarks of JSON library.
+
+	Description
+		All corpora are generated from a seed with a deterministic random number generator,
+		so the same seed, size and parameters always produce the same JSON text on every platform.
+
+		The text is either collected to a growing buffer or passed in chunks to a write callback,
+		so corpora much larger than the memory can be generated.
+*/
+
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CORPUS_NUMBERS_INTEGER    0
+#define CORPUS_NUMBERS_DECIMAL    1
+#define CORPUS_NUMBERS_SCIENTIFIC 2
+
+typedef struct corpus_parameters_t
+{
+	size_t depth;
+	size_t fan_out;
+	size_t minimum_key_length;
+	size_t maximum_key_length;
+	double escape_density;
+	int number_distribution;
+	int single_line;
+} corpus_parameters_t;
+/*
+	Structure
+		corpus_parameters_t
+
+	Description
+		The corpus_parameters_t structure controls the shapes random, deep and flat_array.
+		The line breaks controlled by member single_line apply to all shapes.
+
+	Members
+		depth
+			This member specifies the maximum depth of the shape random and the exact depth of the shape deep.
+		fan_out
+			This member specifies the maximum number of children of objects and arrays of the shape random.
+		minimum_key_length
+			This member specifies the minimum length of generated member names in bytes.
+		maximum_key_length
+			This member specifies the maximum length of generated member names in bytes.
+		escape_density
+			This member specifies the probability that a character of generated string is written as an escape sequence.
+		number_distribution
+			This member specifies the kind of generated numbers. It applies to every shape.
+			Shapes that model real documents compute their numbers and only use the formatting of the kind,
+			integer numbers are rounded and scientific numbers have 17 significant digits.
+			This member can be one of the following constants.
+
+				CORPUS_NUMBERS_INTEGER
+					Integers uniformly distributed between -1000000000 and 1000000000.
+
+				CORPUS_NUMBERS_DECIMAL
+					Numbers uniformly distributed between -1000 and 1000 with 1 to 15 fraction digits.
+
+				CORPUS_NUMBERS_SCIENTIFIC
+					Numbers with 17 significant digits and decimal exponent between -300 and 300.
+
+		single_line
+			This member is nonzero if the text must not contain line breaks. Records of NDJSON text are always on single line.
+*/
+
+typedef int (*corpus_write_callback_t)(void* context, size_t size, const char* data);
+
+typedef struct corpus_text_t
+{
+	size_t size;
+	size_t capacity;
+	char* data;
+	uint64_t total_size;
+	corpus_write_callback_t write_callback;
+	void* write_context;
+	int error;
+} corpus_text_t;
+/*
+	Structure
+		corpus_text_t
+
+	Description
+		The corpus_text_t structure is a buffer that receives generated JSON text.
+		The structure is initialized to zero before the first use and released with corpus_free function.
+		To stream the text, set members write_callback and write_context after initializing the structure to zero.
+
+	Members
+		size
+			This member specifies size of the text currently in the buffer in bytes.
+		capacity
+			This member specifies size of the allocated buffer in bytes.
+		data
+			This member is a pointer to the text in the buffer. The text is null terminated.
+		total_size
+			This member specifies size of all text generated to the buffer including the text passed to the write callback.
+		write_callback
+			This member is a pointer to function that receives the text every time the buffer is full.
+			The callback returns nonzero if it succeeds.
+			If this member is zero, the buffer grows to hold the whole text.
+		write_context
+			This member is the pointer passed to the write callback.
+		error
+			This member is nonzero if allocating the buffer or the write callback failed.
+*/
+
+int corpus_generate(const char* shape, uint64_t seed, size_t target_size, const corpus_parameters_t* parameters, corpus_text_t* text);
+/*
+	Function
+		corpus_generate
+
+	Description
+		This function generates JSON text of given shape.
+		The generated text is appended to the buffer.
+
+	Parameters
+		shape
+			This parameter is the name of the shape.
+			This parameter can be one of the following names.
+
+				twitter
+					Array of status objects with nested user objects, short strings with escapes, integers, booleans and nulls.
+
+				canada
+					GeoJSON polygon whose coordinates are pairs of floating point numbers.
+
+				nested
+					Array of object and array chains nested 48 levels deep.
+
+				wide
+					Single flat object with large number of members.
+
+				random
+					Object of random members whose depth, fan out, names, strings and numbers are controlled by the parameters.
+
+				deep
+					Single chain of objects and arrays nested to the depth specified by the parameters.
+					Every level has a padding string, so the whole text is rescanned at every level by parsers that find the end of a value before parsing it.
+
+				flat_array
+					Single array of numbers and strings without nesting.
+
+		seed
+			This parameter specifies the seed of the random number generator.
+		target_size
+			This parameter specifies the approximate size of the text in bytes.
+		parameters
+			This parameter is a pointer to the parameters of the shape.
+			If this parameter is zero, the parameters set by corpus_default_parameters function are used.
+		text
+			This parameter is a pointer to the buffer that receives the text.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
+
+int corpus_generate_records(const char* shape, uint64_t seed, uint64_t record_count, size_t record_size, const corpus_parameters_t* parameters, corpus_text_t* text);
+/*
+	Function
+		corpus_generate_records
+
+	Description
+		This function generates NDJSON text that contains given number of records of given shape, each on its own line.
+		The records are generated from one random number sequence, so every record is different.
+
+	Parameters
+		shape
+			This parameter is the name of the shape of the records. The names are the same as for corpus_generate function.
+		seed
+			This parameter specifies the seed of the random number generator.
+		record_count
+			This parameter specifies the number of records.
+		record_size
+			This parameter specifies the approximate size of every record in bytes.
+		parameters
+			This parameter is a pointer to the parameters of the shape or zero for the default parameters.
+		text
+			This parameter is a pointer to the buffer that receives the text.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
+
+void corpus_default_parameters(corpus_parameters_t* parameters);
+/*
+	Function
+		corpus_default_parameters
+
+	Description
+		This function sets the default parameters. The default depth is 8 and fan out 16,
+		names are from 4 to 16 bytes long, 2 percent of string characters are escaped and numbers are decimals.
+
+	Parameters
+		parameters
+			This parameter is a pointer to the parameters to be set.
+*/
+
+int corpus_flush(corpus_text_t* text);
+/*
+	Function
+		corpus_flush
+
+	Description
+		This function passes the text in the buffer to the write callback.
+		If the buffer has no write callback, the function does nothing.
+
+	Parameters
+		text
+			This parameter is a pointer to the buffer.
+
+	Return
+		If the function succeeds and no previous errors happened, the return value is nonzero and zero otherwise.
+*/
+
+void corpus_free(corpus_text_t* text);
+/*
+	Function
+		corpus_free
+
+	Description
+		This function releases the buffer of the text. The text remaining in the buffer is not passed to the write callback.
+
+	Parameters
+		text
+			This parameter is a pointer to the buffer to be released.
+*/
+
+#endif
@@ -0,0 +1,159 @@
+/*
+	Synthetic JSON workload generator for the benchmarks of JSON library.
+
+	Description
+		This program writes JSON or NDJSON text generated by the file "corpus.c" to the standard output or to a file.
+		The text is generated in chunks, so the size of the output is not limited by the memory.
+		The same parameters and seed always produce the same output.
+
+	Usage
+		generate [options] > output.json
+
+		-shape name          Shape of the text. One of twitter, canada, nested, wide, random, deep and flat_array. Default is random.
+		-seed n              Seed of the random number generator. Default is 1.
+		-size n              Approximate size of the text, or of every record when -records is given. Default is 1M.
+		-records n           Write NDJSON text with n records on their own lines.
+		-depth n             Maximum depth of the shape random and the exact depth of the shape deep. Default is 8.
+		-fan-out n           Maximum number of children of objects and arrays of the shape random. Default is 16.
+		-key-length min:max  Lengths of generated member names in bytes. Default is 4:16.
+		-escape-density p    Probability that a character of generated string is escaped. Default is 0.02.
+		-numbers kind        Kind of generated numbers. One of integer, decimal and scientific. Default is decimal.
+		-single-line         Do not write line breaks inside JSON text.
+		-o file              Write the text to the file instead of the standard output.
+
+		Sizes and counts can have suffix K, M or G for multiples of 1024.
+
+	Examples
+		Deep nesting that makes parsers rescan the text at every level
+			generate -shape deep -depth 10000 -size 16M
+
+		Huge flat array
+			generate -shape flat_array -numbers scientific -size 1G
+
+		40 GB of NDJSON log records
+			generate -shape random -depth 3 -records 40M -size 1K -o records.ndjson
+*/
+
+#include "corpus.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int generate_write(void* context, size_t size, const char* data)
+{
+	return fwrite(data, 1, size, (FILE*)context) == size;
+}
+
+static int generate_parse_size(const char* text, uint64_t* size)
+{
+	char* end;
+	unsigned long long value = strtoull(text, &end, 0);
+	uint64_t multiplier = 1;
+	if (*end == 'K' || *end == 'k')
+		multiplier = (uint64_t)1 << 10;
+	else if (*end == 'M' || *end == 'm')
+		multiplier = (uint64_t)1 << 20;
+	else if (*end == 'G' || *end == 'g')
+		multiplier = (uint64_t)1 << 30;
+	if (end == text || (multiplier != 1 && *++end) || (multiplier == 1 && *end))
+		return 0;
+	*size = (uint64_t)value * multiplier;
+	return 1;
+}
+
+static int generate_usage(const char* program_name)
+{
+	fprintf(stderr, "usage: %s [-shape name] [-seed n] [-size n] [-records n] [-depth n] [-fan-out n] [-key-length min:max] [-escape-density p] [-numbers integer|decimal|scientific] [-single-line] [-o file]\n", program_name);
+	return EXIT_FAILURE;
+}
+
+int main(int argc, char** argv)
+{
+	const char* shape = "random";
+	const char* output_file_name = 0;
+	uint64_t seed = 1;
+	uint64_t size = (uint64_t)1 << 20;
+	uint64_t record_count = 0;
+	int records = 0;
+	corpus_parameters_t parameters;
+	corpus_default_parameters(&parameters);
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* option = argv[i];
+		const char* value = (i + 1 < argc) ? argv[i + 1] : 0;
+		uint64_t number;
+		if (!strcmp(option, "-single-line"))
+		{
+			parameters.single_line = 1;
+			continue;
+		}
+		if (!value)
+			return generate_usage(argv[0]);
+		++i;
+		if (!strcmp(option, "-shape"))
+			shape = value;
+		else if (!strcmp(option, "-o"))
+			output_file_name = value;
+		else if (!strcmp(option, "-seed") && generate_parse_size(value, &number))
+			seed = number;
+		else if (!strcmp(option, "-size") && generate_parse_size(value, &number) && number == (uint64_t)(size_t)number)
+			size = number;
+		else if (!strcmp(option, "-records") && generate_parse_size(value, &number))
+		{
+			record_count = number;
+			records = 1;
+		}
+		else if (!strcmp(option, "-depth") && generate_parse_size(value, &number))
+			parameters.depth = (size_t)number;
+		else if (!strcmp(option, "-fan-out") && generate_parse_size(value, &number))
+			parameters.fan_out = (size_t)number;
+		else if (!strcmp(option, "-key-length"))
+		{
+			char* end;
+			parameters.minimum_key_length = (size_t)strtoull(value, &end, 10);
+			if (*end != ':')
+				return generate_usage(argv[0]);
+			parameters.maximum_key_length = (size_t)strtoull(end + 1, &end, 10);
+			if (*end || parameters.minimum_key_length > parameters.maximum_key_length)
+				return generate_usage(argv[0]);
+		}
+		else if (!strcmp(option, "-escape-density"))
+			parameters.escape_density = strtod(value, 0);
+		else if (!strcmp(option, "-numbers") && !strcmp(value, "integer"))
+			parameters.number_distribution = CORPUS_NUMBERS_INTEGER;
+		else if (!strcmp(option, "-numbers") && !strcmp(value, "decimal"))
+			parameters.number_distribution = CORPUS_NUMBERS_DECIMAL;
+		else if (!strcmp(option, "-numbers") && !strcmp(value, "scientific"))
+			parameters.number_distribution = CORPUS_NUMBERS_SCIENTIFIC;
+		else
+			return generate_usage(argv[0]);
+	}
+
+	FILE* output = output_file_name ? fopen(output_file_name, "wb") : stdout;
+	if (!output)
+	{
+		fprintf(stderr, "generate: opening %s failed\n", output_file_name);
+		return EXIT_FAILURE;
+	}
+	corpus_text_t text;
+	memset(&text, 0, sizeof(corpus_text_t));
+	text.write_callback = generate_write;
+	text.write_context = output;
+	int success;
+	if (records)
+		success = corpus_generate_records(shape, seed, record_count, (size_t)size, &parameters, &text);
+	else
+		success = corpus_generate(shape, seed, (size_t)size, &parameters, &text);
+	success = corpus_flush(&text) && success;
+	corpus_free(&text);
+	if (output_file_name)
+		success = !fclose(output) && success;
+	else
+		success = !fflush(output) && success;
+	if (!success)
+	{
+		fprintf(stderr, "generate: generating shape %s failed\n", shape);
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+/*
+	Benchmark that compares reading a value tree through the C++ wrapper in the file "jsonl.hpp" to reading the C structures directly.
+
+	Build
+		cc -O2 -c ../jsonl.c -o jsonl.o
+		c++ -std=c++17 -O2 -I.. hpp_overhead.cpp jsonl.o -o hpp_overhead
+
+	Both traversals visit every record of an array, look up three members by name, sum the numbers and the string lengths.
+	The best time of several repetitions is reported for both traversals in nanoseconds per record.
+*/
+
+#include "jsonl.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+static std::string create_records(std::size_t record_count)
+{
+	std::string text = "[";
+	for (std::size_t i = 0; i != record_count; ++i)
+	{
+		if (i)
+			text += ",";
+		text += "{\"id\":" + std::to_string(i) + ",\"name\":\"record " + std::to_string(i) + "\",\"active\":" + ((i & 1) ? "true" : "false") + ",\"tags\":[1,2,3]}";
+	}
+	text += "]";
+	return text;
+}
+
+static std::size_t read_records_c(const jsonl_value_t* records)
+{
+	jsonl_path_component_t id_path;
+	id_path.container_type = JSONL_TYPE_OBJECT;
+	id_path.name.length = 2;
+	id_path.name.value = const_cast<char*>("id");
+	jsonl_path_component_t name_path;
+	name_path.container_type = JSONL_TYPE_OBJECT;
+	name_path.name.length = 4;
+	name_path.name.value = const_cast<char*>("name");
+	jsonl_path_component_t active_path;
+	active_path.container_type = JSONL_TYPE_OBJECT;
+	active_path.name.length = 6;
+	active_path.name.value = const_cast<char*>("active");
+	std::size_t sum = 0;
+	for (std::size_t i = 0; i != records->array.value_count; ++i)
+	{
+		const jsonl_value_t* record = records->array.table[i];
+		const jsonl_value_t* id = jsonl_get_value(record, 1, &id_path, JSONL_TYPE_NUMBER);
+		const jsonl_value_t* name = jsonl_get_value(record, 1, &name_path, JSONL_TYPE_STRING);
+		const jsonl_value_t* active = jsonl_get_value(record, 1, &active_path, JSONL_TYPE_BOOLEAN);
+#ifdef JSONL_FIXED_POINT_NUMBER_FORMAT
+		sum += id ? static_cast<std::size_t>(id->number.integer) : 0;
+#else
+		sum += id ? static_cast<std::size_t>(id->number.value) : 0;
+#endif
+		sum += name ? name->string.length : 0;
+		sum += (active && active->boolean.value) ? 1 : 0;
+	}
+	return sum;
+}
+
+static std::size_t read_records_hpp(jsonl::value_view records)
+{
+	std::size_t sum = 0;
+	for (jsonl::value_view record : records.elements())
+	{
+		const jsonl_number_value_t* id = record["id"].number();
+#ifdef JSONL_FIXED_POINT_NUMBER_FORMAT
+		sum += id ? static_cast<std::size_t>(id->integer) : 0;
+#else
+		sum += id ? static_cast<std::size_t>(id->value) : 0;
+#endif
+		sum += record["name"].string().size();
+		sum += record["active"].boolean() ? 1 : 0;
+	}
+	return sum;
+}
+
+template <typename function_t>
+static double measure_best(int repetition_count, std::size_t& result, function_t function)
+{
+	double best_time = 0.0;
+	for (int i = 0; i != repetition_count; ++i)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		result = function();
+		auto end = std::chrono::steady_clock::now();
+		double time = std::chrono::duration<double, std::nano>(end - begin).count();
+		if (!i || time < best_time)
+			best_time = time;
+	}
+	return best_time;
+}
+
+int main()
+{
+	const std::size_t record_count = 100000;
+	const int repetition_count = 20;
+	std::string text = create_records(record_count);
+	jsonl::document document(text);
+	if (!document)
+	{
+		std::fprintf(stderr, "parsing failed\n");
+		return 1;
+	}
+
+	std::size_t c_result;
+	std::size_t hpp_result;
+	double c_time = measure_best(repetition_count, c_result, [&]() { return read_records_c(document.get()); });
+	double hpp_time = measure_best(repetition_count, hpp_result, [&]() { return read_records_hpp(document.root()); });
+	if (c_result != hpp_result)
+	{
+		std::fprintf(stderr, "results differ %zu %zu\n", c_result, hpp_result);
+		return 1;
+	}
+	std::printf("{\"benchmark\":\"read_records_c\",\"ns_per_op\":%.3f}\n", c_time / static_cast<double>(record_count));
+	std::printf("{\"benchmark\":\"read_records_hpp\",\"ns_per_op\":%.3f}\n", hpp_time / static_cast<double>(record_count));
+	return 0;
+}
@@ -0,0 +1,222 @@
+/*
+	Randomized check of the versions of JSON library.
+
+	Description
+		This program creates a chain of versions with jsonl_create_next_version function from random lists of modifications.
+		Only a few of the newest versions stay in use, and older versions are freed by the rule documented for jsonl_version_t structure.
+		The buffer of a freed version is overwritten before it is freed, so a version that still refers to it produces a wrong tree.
+		Every new version is compared with the tree created by jsonl_set_values_with_plan function from the same base version.
+		Build the program with -fsanitize=address to also detect reads of freed buffers.
+
+		The program returns zero when every version is correct.
+
+	Usage
+		versions [options]
+
+		-versions n  Number of versions to create. Default is 3000.
+		-in-use n    Number of the newest versions that stay in use. Default is 6.
+		-seed n      Seed of the random number generator. Default is 7.
+*/
+
+#include "jsonl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define VERSIONS_MAXIMUM_SET_VALUE_COUNT 3
+#define VERSIONS_MAXIMUM_PATH_LENGTH 4
+
+static const char* versions_source_text = "{\"a\":{\"a\":1,\"b\":[1,2,3],\"c\":{\"d\":1}},\"b\":[{\"a\":1},{\"b\":2},3],\"c\":\"x\",\"d\":{\"e\":{\"f\":{\"g\":1}}}}";
+static const char* versions_names[] = { "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o", "p", "q", "r", "s", "t" };
+
+static uint64_t versions_random(uint64_t* state)
+{
+	uint64_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	*state = x;
+	return x;
+}
+
+static size_t versions_random_path(uint64_t* random_state, const jsonl_value_t* value, jsonl_path_component_t* path)
+{
+	size_t path_length = 0;
+	while (path_length != VERSIONS_MAXIMUM_PATH_LENGTH && versions_random(random_state) % 4)
+	{
+		if (value->type == JSONL_TYPE_OBJECT && value->object.value_count)
+		{
+			size_t i = (size_t)(versions_random(random_state) % value->object.value_count);
+			path[path_length].container_type = JSONL_TYPE_OBJECT;
+			path[path_length].name.length = value->object.table[i].name_length;
+			path[path_length].name.value = (char*)value->object.table[i].name;
+			value = value->object.table[i].value;
+		}
+		else if (value->type == JSONL_TYPE_ARRAY && value->array.value_count)
+		{
+			size_t i = (size_t)(versions_random(random_state) % value->array.value_count);
+			path[path_length].container_type = JSONL_TYPE_ARRAY;
+			path[path_length].index = i;
+			value = value->array.table[i];
+		}
+		else
+			break;
+		++path_length;
+	}
+	if (!path_length)
+	{
+		// Members that do not exist are added to the root object.
+		const char* name = versions_names[versions_random(random_state) % (sizeof(versions_names) / sizeof(*versions_names))];
+		path[0].container_type = JSONL_TYPE_OBJECT;
+		path[0].name.length = strlen(name);
+		path[0].name.value = (char*)name;
+		path_length = 1;
+	}
+	return path_length;
+}
+
+static int versions_path_overlap(size_t path_length_a, const jsonl_path_component_t* path_a, size_t path_length_b, const jsonl_path_component_t* path_b)
+{
+	size_t common_length = (path_length_a < path_length_b) ? path_length_a : path_length_b;
+	for (size_t i = 0; i != common_length; ++i)
+	{
+		if (path_a[i].container_type != path_b[i].container_type)
+			return 0;
+		if (path_a[i].container_type == JSONL_TYPE_ARRAY ?
+			(path_a[i].index != path_b[i].index) :
+			(path_a[i].name.length != path_b[i].name.length || memcmp(path_a[i].name.value, path_b[i].name.value, path_a[i].name.length)))
+			return 0;
+	}
+	return 1;
+}
+
+static int versions_parse_count(const char* text, size_t* count)
+{
+	char* end;
+	unsigned long long value = strtoull(text, &end, 0);
+	if (end == text || *end)
+		return 0;
+	*count = (size_t)value;
+	return 1;
+}
+
+int main(int argc, char** argv)
+{
+	size_t version_count = 3000;
+	size_t in_use_count = 6;
+	size_t seed = 7;
+	for (int i = 1; i != argc; ++i)
+	{
+		size_t* option = 0;
+		if (!strcmp(argv[i], "-versions"))
+			option = &version_count;
+		else if (!strcmp(argv[i], "-in-use"))
+			option = &in_use_count;
+		else if (!strcmp(argv[i], "-seed"))
+			option = &seed;
+		if (!option || i + 1 == argc || !versions_parse_count(argv[++i], option) || (option != &seed && !*option))
+		{
+			fprintf(stderr, "Usage: versions [-versions n] [-in-use n] [-seed n]\n");
+			return EXIT_FAILURE;
+		}
+	}
+	uint64_t random_state = seed ? (uint64_t)seed : 1;
+
+	size_t source_size = jsonl_parse_text(strlen(versions_source_text), versions_source_text, 0, 0);
+	jsonl_value_t* source = (jsonl_value_t*)malloc(source_size);
+	jsonl_version_t** version_table = (jsonl_version_t**)malloc(version_count * sizeof(jsonl_version_t*));
+	if (!source || !version_table)
+	{
+		fprintf(stderr, "Memory allocation failed\n");
+		return EXIT_FAILURE;
+	}
+	jsonl_parse_text(strlen(versions_source_text), versions_source_text, source_size, source);
+
+	// The versions from first_version to version_count are kept in a queue ordered by epoch, and the versions before first_in_use are no longer used.
+	size_t first_version = 0;
+	size_t version_size = jsonl_create_version(source, 0, 0, 0);
+	version_table[0] = (jsonl_version_t*)malloc(version_size);
+	if (!version_table[0] || jsonl_create_version(source, 0, version_size, version_table[0]) != version_size)
+	{
+		fprintf(stderr, "Creating the first version failed\n");
+		return EXIT_FAILURE;
+	}
+	free(source);
+
+	size_t freed_count = 0;
+	size_t maximum_kept_count = 1;
+	for (size_t n = 1; n != version_count; ++n)
+	{
+		const jsonl_version_t* base_version = version_table[n - 1];
+		jsonl_path_component_t path_table[VERSIONS_MAXIMUM_SET_VALUE_COUNT][VERSIONS_MAXIMUM_PATH_LENGTH];
+		jsonl_set_value_t set_value_table[VERSIONS_MAXIMUM_SET_VALUE_COUNT];
+		jsonl_value_t number_table[VERSIONS_MAXIMUM_SET_VALUE_COUNT];
+		size_t set_value_count = 0;
+		for (size_t i = 1 + (size_t)(versions_random(&random_state) % VERSIONS_MAXIMUM_SET_VALUE_COUNT); i--;)
+		{
+			jsonl_path_component_t* path = path_table[set_value_count];
+			size_t path_length = versions_random_path(&random_state, base_version->value_tree, path);
+			int overlap = 0;
+			for (size_t j = 0; !overlap && j != set_value_count; ++j)
+				overlap = versions_path_overlap(path_length, path, set_value_table[j].path_length, set_value_table[j].path);
+			if (overlap)
+				continue;
+			memset(number_table + set_value_count, 0, sizeof(jsonl_value_t));
+			number_table[set_value_count].type = JSONL_TYPE_NUMBER;
+			number_table[set_value_count].number.value = (double)n;
+			set_value_table[set_value_count].path_length = path_length;
+			set_value_table[set_value_count].path = path;
+			set_value_table[set_value_count].value = (versions_random(&random_state) % 5) ? (number_table + set_value_count) : 0;
+			++set_value_count;
+		}
+
+		size_t plan_size = jsonl_create_set_values_plan(set_value_count, set_value_table, 0, 0);
+		jsonl_set_values_plan_t* plan = (jsonl_set_values_plan_t*)malloc(plan_size);
+		if (!plan || jsonl_create_set_values_plan(set_value_count, set_value_table, plan_size, plan) != plan_size ||
+			!(version_size = jsonl_create_next_version(base_version, plan, 0, 0)) ||
+			!(version_table[n] = (jsonl_version_t*)malloc(version_size)) ||
+			jsonl_create_next_version(base_version, plan, version_size, version_table[n]) != version_size)
+		{
+			fprintf(stderr, "Creating version %zu failed\n", n);
+			return EXIT_FAILURE;
+		}
+
+		size_t expected_size = jsonl_set_values_with_plan(base_version->value_tree, plan, 0, 0);
+		jsonl_value_t* expected = (jsonl_value_t*)malloc(expected_size);
+		if (!expected || jsonl_set_values_with_plan(base_version->value_tree, plan, expected_size, expected) != expected_size)
+		{
+			fprintf(stderr, "Creating the tree of version %zu failed\n", n);
+			return EXIT_FAILURE;
+		}
+		if (!jsonl_value_equal(expected, version_table[n]->value_tree) || version_table[n]->epoch != n || version_table[n]->oldest_shared_epoch > n)
+		{
+			fprintf(stderr, "Version %zu is not equal to the tree created without sharing\n", n);
+			return EXIT_FAILURE;
+		}
+		free(expected);
+		free(plan);
+
+		// Free the unused versions at the front of the queue by the rule documented for jsonl_version_t.
+		size_t first_in_use = (n + 1 > in_use_count) ? (n + 1 - in_use_count) : 0;
+		size_t oldest_shared_epoch = (size_t)~0;
+		for (size_t i = (first_in_use > first_version) ? first_in_use : first_version; i != n + 1; ++i)
+			if (version_table[i]->oldest_shared_epoch < oldest_shared_epoch)
+				oldest_shared_epoch = version_table[i]->oldest_shared_epoch;
+		while (first_version < first_in_use && version_table[first_version]->epoch < oldest_shared_epoch)
+		{
+			memset(version_table[first_version], 0xCD, version_table[first_version]->size);
+			free(version_table[first_version]);
+			++first_version;
+			++freed_count;
+		}
+		if (n + 1 - first_version > maximum_kept_count)
+			maximum_kept_count = n + 1 - first_version;
+	}
+
+	printf("%zu versions created, %zu freed, at most %zu kept, oldest shared epoch of the last version %zu\n",
+		version_count, freed_count, maximum_kept_count, version_table[version_count - 1]->oldest_shared_epoch);
+	for (size_t i = first_version; i != version_count; ++i)
+		free(version_table[i]);
+	free(version_table);
+	return EXIT_SUCCESS;
+}
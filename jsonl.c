@@ -65,19 +65,183 @@ static void jsonl_debug_assert(int x, int location)
 #define JSONL_INLINE inline
 #endif
 
+#define JSONL_WRITER_NESTING_OBJECT 0x1
+#define JSONL_WRITER_NESTING_HAS_VALUES 0x2
+
+#define JSONL_JSON_PATCH_ADD 1
+#define JSONL_JSON_PATCH_REMOVE 2
+#define JSONL_JSON_PATCH_REPLACE 3
+#define JSONL_JSON_PATCH_MOVE 4
+#define JSONL_JSON_PATCH_COPY 5
+#define JSONL_JSON_PATCH_TEST 6
+
+#define JSONL_BIG_NUMBER_WORD_COUNT 40
+
+#define JSONL_STRUCT_HASH_SEED_COUNT 256
+
+#ifndef JSONL_BUILDER_MINIMUM_ARENA_SIZE
+#define JSONL_BUILDER_MINIMUM_ARENA_SIZE 4096
+#endif
+
+#ifndef JSONL_BUILDER_MINIMUM_TABLE_CAPACITY
+#define JSONL_BUILDER_MINIMUM_TABLE_CAPACITY 4
+#endif
+
+#ifndef JSONL_SET_VALUES_STACK_PLAN_SIZE
+#define JSONL_SET_VALUES_STACK_PLAN_SIZE 1024
+#endif
+
+#ifndef JSONL_OBJECT_INDEX_MINIMUM_VALUE_COUNT
+#define JSONL_OBJECT_INDEX_MINIMUM_VALUE_COUNT 16
+#endif
+
+#ifdef JSONL_PARSE_STATISTICS
+#ifndef JSONL_PARSE_STATISTICS_CLOCK
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define JSONL_PARSE_STATISTICS_CLOCK() ((uint64_t)__builtin_ia32_rdtsc())
+#else
+#define JSONL_PARSE_STATISTICS_CLOCK() ((uint64_t)0)
+#endif
+#endif
+#define JSONL_PARSE_STATISTICS_ADD(context, member, value) do { if ((context)->statistics) (context)->statistics->member += (value); } while (0)
+#define JSONL_PARSE_STATISTICS_BEGIN_PHASE(context) do { if ((context)->statistics) (context)->phase_begin_time = JSONL_PARSE_STATISTICS_CLOCK(); } while (0)
+#define JSONL_PARSE_STATISTICS_END_PHASE(context, phase) do { if ((context)->statistics) (context)->statistics->phase += JSONL_PARSE_STATISTICS_CLOCK() - (context)->phase_begin_time; } while (0)
+#define JSONL_PARSE_STATISTICS_UPDATE_DEPTH(context) do { if ((context)->statistics && (context)->depth > (context)->statistics->maximum_depth) (context)->statistics->maximum_depth = (context)->depth; } while (0)
+#define JSONL_PARSE_STATISTICS_COUNT_ESCAPES(context, size, text) do { if ((context)->statistics) (context)->statistics->escape_count += jsonl_count_escapes((size), (text)); } while (0)
+#else
+#define JSONL_PARSE_STATISTICS_ADD(context, member, value) do {} while (0)
+#define JSONL_PARSE_STATISTICS_BEGIN_PHASE(context) do {} while (0)
+#define JSONL_PARSE_STATISTICS_END_PHASE(context, phase) do {} while (0)
+#define JSONL_PARSE_STATISTICS_UPDATE_DEPTH(context) do {} while (0)
+#define JSONL_PARSE_STATISTICS_COUNT_ESCAPES(context, size, text) do {} while (0)
+#endif
+
+typedef struct jsonl_internal_interned_name_t
+{
+	size_t hash;
+	size_t text_size;
+	const char* text;
+	size_t name_length;
+	char* name;
+} jsonl_internal_interned_name_t;
+
+typedef struct jsonl_internal_parse_context_t
+{
+	size_t interned_name_count;
+	size_t interned_name_bucket_count;
+	jsonl_internal_interned_name_t* interned_name_table;
+	size_t depth;
+	size_t value_count;
+	size_t value_buffer_size;
+	uint64_t step_count;
+	size_t maximum_depth;
+	size_t maximum_value_count;
+	size_t maximum_string_length;
+	size_t maximum_value_buffer_size;
+	uint64_t maximum_step_count;
+#ifdef JSONL_PARSE_STATISTICS
+	jsonl_parse_stats_t* statistics;
+	uint64_t phase_begin_time;
+#endif
+} jsonl_internal_parse_context_t;
+
+typedef struct jsonl_internal_builder_member_t
+{
+	size_t name_hash;
+	size_t name_length;
+	size_t name;
+	size_t value;
+} jsonl_internal_builder_member_t;
+
+typedef struct jsonl_internal_builder_node_t
+{
+	int type;
+	size_t parent;
+	union
+	{
+		struct
+		{
+			size_t value_count;
+			size_t capacity;
+			size_t table;
+		} container;
+		struct
+		{
+			size_t length;
+			size_t capacity;
+			size_t value;
+		} string;
+		jsonl_number_value_t number;
+		int boolean;
+	};
+} jsonl_internal_builder_node_t;
+
+typedef struct jsonl_internal_big_number_t
+{
+	size_t word_count;
+	uint32_t word_table[JSONL_BIG_NUMBER_WORD_COUNT];
+} jsonl_internal_big_number_t;
+
+typedef struct jsonl_internal_diff_context_t
+{
+	const jsonl_tree_hash_t* tree_hash_a;
+	const jsonl_tree_hash_t* tree_hash_b;
+	size_t set_value_count;
+	size_t path_component_count;
+	jsonl_set_value_t* set_value_table;
+	jsonl_path_component_t* path_component_table;
+	jsonl_writer_t* writer;
+} jsonl_internal_diff_context_t;
+
+typedef struct jsonl_internal_compact_entry_t
+{
+	uint64_t hash;
+	size_t node_index;
+	const jsonl_value_t* source_value;
+	jsonl_value_t* value;
+} jsonl_internal_compact_entry_t;
+
+typedef struct jsonl_internal_set_values_scan_node_t
+{
+	size_t depth;
+	size_t prefix_index;
+	size_t set_value_index;
+	int remove;
+	size_t first_value_index;
+	int has_child;
+} jsonl_internal_set_values_scan_node_t;
+
+typedef struct jsonl_internal_compact_context_t
+{
+	const jsonl_tree_hash_node_t* node_table;
+	size_t entry_mask;
+	jsonl_internal_compact_entry_t* entry_table;
+} jsonl_internal_compact_context_t;
+
+typedef struct jsonl_internal_patch_target_t
+{
+	size_t parent;
+	size_t index;
+	int append;
+	size_t name_length;
+	size_t name;
+} jsonl_internal_patch_target_t;
+
 typedef struct jsonl_internal_path_t
 {
 	struct jsonl_internal_path_t* parent;
 	size_t depth;
 	jsonl_path_component_t path_component;
-	int value_type;
-	const jsonl_value_t* source_value;
 } jsonl_internal_path_t;
 
 static const size_t jsonl_value_alignment_minus_one = (((sizeof(double) > sizeof(void*)) ? sizeof(double) : ((sizeof(int) > sizeof(void*)) ? sizeof(int) : sizeof(void*))) - 1);
 
 static JSONL_INLINE size_t jsonl_round_size(size_t size) { return (size + jsonl_value_alignment_minus_one) & ~jsonl_value_alignment_minus_one; }
 
+static JSONL_INLINE int jsonl_parse_count_steps(jsonl_internal_parse_context_t* context, size_t step_count) { context->step_count += (uint64_t)step_count; return context->step_count <= context->maximum_step_count; }
+
+static JSONL_INLINE int jsonl_parse_reserve_value_buffer(jsonl_internal_parse_context_t* context, size_t size) { context->value_buffer_size += size; return context->value_buffer_size >= size && context->value_buffer_size <= context->maximum_value_buffer_size; }
+
 static JSONL_INLINE int jsonl_is_white_space(char character) { return character == ' ' || character == '\t' || character == '\n' || character == '\r'; }
 
 static JSONL_INLINE int jsonl_is_structural_character(char character) { return character == '[' || character == '{' || character == ']' || character == '}' || character == ':' || character == ',' || character == '"'; }
@@ -88,7 +252,7 @@ static JSONL_INLINE int jsonl_is_hex_value(char character) { return (character >
 
 static JSONL_INLINE int jsonl_decimal_value(char character) { return character - '0'; }
 
-static JSONL_INLINE int jsonl_hex_value(char character) { return (character <= '9') ? (character - '0') : ((character <= 'F') ? (character - ('A' - 10)) : (character - ('f' - 10))); }
+static JSONL_INLINE int jsonl_hex_value(char character) { return (character <= '9') ? (character - '0') : ((character <= 'F') ? (character - ('A' - 10)) : (character - ('a' - 10))); }
 
 static JSONL_INLINE size_t jsonl_string_length(const char* string)
 {
@@ -111,6 +275,19 @@ static JSONL_INLINE int jsonl_memory_compare(const void* block_a, const void* bl
 	return read_a == a_end;
 }
 
+static JSONL_INLINE int jsonl_memory_order(const void* block_a, const void* block_b, size_t size)
+{
+	const uint8_t* read_a = (const uint8_t*)block_a;
+	const uint8_t* read_b = (const uint8_t*)block_b;
+	const uint8_t* a_end = (const uint8_t*)((uintptr_t)read_a + size);
+	while (read_a != a_end && *read_a == *read_b)
+	{
+		++read_a;
+		++read_b;
+	}
+	return (read_a == a_end) ? 0 : ((*read_a < *read_b) ? -1 : 1);
+}
+
 static JSONL_INLINE void jsonl_copy_memory(void* destination, const void* source, size_t size)
 {
 	uint8_t* write = (uint8_t*)destination;
@@ -120,6 +297,92 @@ static JSONL_INLINE void jsonl_copy_memory(void* destination, const void* source
 		*write++ = *read++;
 }
 
+static JSONL_INLINE uint64_t jsonl_hash_bytes_64(uint64_t hash, size_t size, const void* data)
+{
+	for (const uint8_t* read = (const uint8_t*)data, * end = (const uint8_t*)((uintptr_t)data + size); read != end; ++read)
+		hash = (hash ^ (uint64_t)*read) * (uint64_t)0x100000001B3;
+	return hash;
+}
+
+static JSONL_INLINE size_t jsonl_hash_name(size_t name_length, const char* name)
+{
+	return (size_t)jsonl_hash_bytes_64((uint64_t)0xCBF29CE484222325, name_length, name);
+}
+
+static JSONL_INLINE uint64_t jsonl_mix_hash_64(uint64_t hash)
+{
+	hash ^= hash >> 33;
+	hash *= (uint64_t)0xFF51AFD7ED558CCD;
+	hash ^= hash >> 33;
+	hash *= (uint64_t)0xC4CEB9FE1A85EC53;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+static JSONL_INLINE size_t jsonl_struct_field_slot(uint64_t hash_seed, size_t hash_mask, size_t name_length, const char* name)
+{
+	return (size_t)jsonl_mix_hash_64(jsonl_hash_bytes_64((uint64_t)0xCBF29CE484222325 ^ hash_seed, name_length, name)) & hash_mask;
+}
+
+static JSONL_INLINE int jsonl_number_equal(const jsonl_number_value_t* number_value_a, const jsonl_number_value_t* number_value_b)
+{
+#ifdef JSONL_FIXED_POINT_NUMBER_FORMAT
+	return number_value_a->integer == number_value_b->integer && number_value_a->fraction == number_value_b->fraction && (number_value_a->sign == number_value_b->sign || (!number_value_a->integer && !number_value_a->fraction));
+#else
+	return number_value_a->value == number_value_b->value;
+#endif
+}
+
+static JSONL_INLINE uint64_t jsonl_load_unaligned_64(const void* address)
+{
+	uint64_t value;
+#ifdef __GNUC__
+	__builtin_memcpy(&value, address, sizeof(uint64_t));
+#else
+	jsonl_copy_memory(&value, address, sizeof(uint64_t));
+#endif
+	return value;
+}
+
+static JSONL_INLINE void jsonl_store_unaligned_64(void* address, uint64_t value)
+{
+#ifdef __GNUC__
+	__builtin_memcpy(address, &value, sizeof(uint64_t));
+#else
+	jsonl_copy_memory(address, &value, sizeof(uint64_t));
+#endif
+}
+
+static JSONL_INLINE uint32_t jsonl_load_unaligned_32(const void* address)
+{
+	uint32_t value;
+#ifdef __GNUC__
+	__builtin_memcpy(&value, address, sizeof(uint32_t));
+#else
+	jsonl_copy_memory(&value, address, sizeof(uint32_t));
+#endif
+	return value;
+}
+
+static JSONL_INLINE void jsonl_store_unaligned_32(void* address, uint32_t value)
+{
+#ifdef __GNUC__
+	__builtin_memcpy(address, &value, sizeof(uint32_t));
+#else
+	jsonl_copy_memory(address, &value, sizeof(uint32_t));
+#endif
+}
+
+static JSONL_INLINE int jsonl_word_needs_escape(uint64_t word)
+{
+	// Each term has the high bit of a byte set when that byte is a quote, a backslash or a control character.
+	const uint64_t ones = (uint64_t)0x0101010101010101;
+	const uint64_t high_bits = (uint64_t)0x8080808080808080;
+	uint64_t quote = word ^ (ones * (uint64_t)'\"');
+	uint64_t backslash = word ^ (ones * (uint64_t)'\\');
+	return ((((quote - ones) & ~quote) | ((backslash - ones) & ~backslash) | ((word - (ones * (uint64_t)0x20)) & ~word)) & high_bits) != 0;
+}
+
 static size_t jsonl_white_space_length(size_t json_text_size, const char* json_text);
 
 static size_t jsonl_printable_space_length(size_t json_text_size, const char* json_text);
@@ -146,31 +409,217 @@ static size_t jsonl_count_array_values(size_t json_text_size, const char* json_t
 
 static void jsonl_terminator_string(char* string_end);
 
-static size_t jsonl_create_tree_from_text(size_t json_text_size, const char* json_text, size_t value_buffer_size, jsonl_value_t* value_buffer, jsonl_value_t* parent_value, size_t* required_value_buffer_size);
+static size_t jsonl_object_index_bucket_count(size_t value_count);
+
+static size_t jsonl_object_index_size(size_t value_count);
+
+static void jsonl_create_object_index(jsonl_value_t* object_value, void* index_buffer, const jsonl_object_index_t* source_index);
+
+static size_t jsonl_find_object_member_with_hash(const jsonl_value_t* object_value, size_t name_length, const char* name, size_t name_hash);
+
+static size_t jsonl_find_object_member(const jsonl_value_t* object_value, size_t name_length, const char* name);
+
+static size_t jsonl_find_matching_object_member(const jsonl_value_t* object_value, size_t member_index, const jsonl_value_t* other_object_value);
+
+static jsonl_internal_interned_name_t* jsonl_find_interned_name(jsonl_internal_parse_context_t* context, size_t quoted_name_size, const char* quoted_name);
+
+#ifdef JSONL_PARSE_STATISTICS
+static size_t jsonl_count_escapes(size_t json_text_size, const char* json_text);
+
+#endif
+static size_t jsonl_create_tree_from_text(size_t json_text_size, const char* json_text, size_t value_buffer_size, jsonl_value_t* value_buffer, jsonl_value_t* parent_value, size_t* required_value_buffer_size, jsonl_internal_parse_context_t* context);
+
+static size_t jsonl_internal_parse_text(size_t json_text_size, const char* json_text, const jsonl_parse_options_t* options, jsonl_internal_parse_context_t* context, size_t value_buffer_size, jsonl_value_t* value_buffer);
+
+static const jsonl_value_t* jsonl_get_child_value(const jsonl_value_t* parent_value, const jsonl_path_component_t* path_component);
+
+static int jsonl_path_component_compare(const jsonl_path_component_t* path_component_a, const jsonl_path_component_t* path_component_b);
+
+static int jsonl_get_values_path_compare(const jsonl_get_value_t* get_value_a, const jsonl_get_value_t* get_value_b);
+
+static size_t jsonl_get_values_sort(size_t list, size_t list_length, const jsonl_get_value_t* get_value_table, const jsonl_value_t** value_table);
+
+static size_t jsonl_get_values_resolve(const jsonl_value_t* value, size_t depth, size_t list, size_t list_end, const jsonl_get_value_t* get_value_table, const jsonl_value_t** value_table);
+
+static int jsonl_decode_json_pointer_token(size_t token_size, const char* token, size_t name_buffer_size, char* name_buffer, size_t* name_length);
+
+static size_t jsonl_decode_array_index(size_t text_size, const char* text);
+
+static size_t jsonl_print_number_value(const jsonl_number_value_t* number_value, size_t text_buffer_size, char* text_buffer);
+
+static size_t jsonl_print_escaped_string(size_t string_size, const char* string, char hex_letter_base, size_t text_buffer_size, char* text_buffer);
+
+static size_t jsonl_print_string_value(size_t string_size, const char* string, char hex_letter_base, size_t text_buffer_size, char* text_buffer);
+
+static void jsonl_print_indent(char* text_buffer, size_t indent_length, char indent_character);
+
+static size_t jsonl_print_scalar_value(const jsonl_value_t* value_tree, size_t json_text_buffer_size, char* json_text_buffer);
+
+static size_t jsonl_internal_print(const jsonl_value_t* value_tree, size_t json_text_buffer_size, char* json_text_buffer, size_t depth, const jsonl_print_options_t* options);
+
+static size_t jsonl_internal_print_compact(const jsonl_value_t* value_tree, size_t json_text_buffer_size, char* json_text_buffer);
+
+static void jsonl_big_number_set(jsonl_internal_big_number_t* number, uint64_t value);
+
+static void jsonl_big_number_multiply(jsonl_internal_big_number_t* number, uint32_t factor);
+
+static void jsonl_big_number_multiply_power_of_ten(jsonl_internal_big_number_t* number, int exponent);
+
+static void jsonl_big_number_shift_left(jsonl_internal_big_number_t* number, size_t shift);
 
-static size_t jsonl_print_number_value(const jsonl_value_t* number_value, size_t text_buffer_size, char* text_buffer);
+static void jsonl_big_number_add(const jsonl_internal_big_number_t* number_a, const jsonl_internal_big_number_t* number_b, jsonl_internal_big_number_t* sum);
 
-static size_t jsonl_print_string_value(size_t string_size, const char* string, size_t text_buffer_size, char* text_buffer);
+static void jsonl_big_number_subtract(jsonl_internal_big_number_t* number, const jsonl_internal_big_number_t* subtrahend);
 
-static void jsonl_print_indent(char* text_buffer, size_t depth);
+static int jsonl_big_number_compare(const jsonl_internal_big_number_t* number_a, const jsonl_internal_big_number_t* number_b);
 
-static size_t jsonl_internal_print(const jsonl_value_t* value_tree, size_t json_text_buffer_size, char* json_text_buffer, size_t depth);
+static size_t jsonl_print_shortest_number(int sign, uint64_t mantissa, int exponent, size_t text_buffer_size, char* text_buffer);
+
+static size_t jsonl_print_canonical_number_value(const jsonl_number_value_t* number_value, size_t text_buffer_size, char* text_buffer);
+
+static int jsonl_canonical_member_order(const jsonl_value_t* object, uint32_t member_index_a, uint32_t member_index_b);
+
+static void jsonl_sift_canonical_member_order(const jsonl_value_t* object, char* order_table, size_t root, size_t heap_size);
+
+static void jsonl_sort_canonical_member_order(const jsonl_value_t* object, size_t value_count, char* order_table);
+
+static size_t jsonl_internal_print_canonical(const jsonl_value_t* value_tree, size_t json_text_buffer_size, char* json_text_buffer);
+
+static void jsonl_writer_flush(jsonl_writer_t* writer);
+
+static void jsonl_writer_write_data(jsonl_writer_t* writer, size_t size, const char* data);
+
+static void jsonl_writer_write_indent(jsonl_writer_t* writer, size_t indent_length);
+
+static void jsonl_writer_write_escaped_string(jsonl_writer_t* writer, size_t string_size, const char* string);
+
+static void jsonl_writer_write_string(jsonl_writer_t* writer, size_t string_size, const char* string);
+
+static void jsonl_internal_print_to_writer(jsonl_writer_t* writer, const jsonl_value_t* value_tree, size_t depth);
+
+static int jsonl_writer_begin_value(jsonl_writer_t* writer);
+
+static int jsonl_writer_begin_container(jsonl_writer_t* writer, int object);
+
+static int jsonl_find_struct_hash_seed(size_t field_count, const jsonl_field_descriptor_t* field_table, size_t hash_mask, uint64_t* hash_seed);
+
+static const jsonl_field_descriptor_t* jsonl_find_struct_field(const jsonl_struct_descriptor_t* struct_descriptor, size_t name_length, const char* name);
+
+static void jsonl_store_field_integer(void* field_address, size_t field_size, int64_t value);
+
+static int64_t jsonl_load_field_integer(const void* field_address, size_t field_size);
+
+static int jsonl_decode_integer(size_t json_text_size, const char* json_text, int64_t* value);
+
+static int jsonl_decode_struct_member(const jsonl_struct_descriptor_t* struct_descriptor, size_t name_size, const char* name_text, int value_type, size_t value_size, const char* value_text, void* structure);
+
+static int jsonl_internal_decode_struct(const jsonl_struct_descriptor_t* struct_descriptor, size_t object_text_size, const char* object_text, void* structure);
+
+static int jsonl_writer_integer(jsonl_writer_t* writer, int64_t integer_value);
 
 static size_t jsonl_internal_create_null_value(const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer);
 
 static size_t jsonl_internal_copy_value(const jsonl_value_t* value, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer);
 
-static int jsonl_internal_set_values_create_path_contains_second_path(size_t path_index, const jsonl_set_value_t* set_value_table, size_t depth, size_t second_path_index);
+static int jsonl_set_values_plan_component_compare(const jsonl_path_component_t* path_component_a, size_t set_value_index_a, const jsonl_path_component_t* path_component_b, size_t set_value_index_b);
+
+static int jsonl_set_values_plan_path_compare(const jsonl_set_value_t* set_value_table, size_t set_value_index_a, size_t set_value_index_b);
+
+static size_t jsonl_set_values_plan_sort(size_t list, size_t list_length, const jsonl_set_value_t* set_value_table, size_t* link_table);
+
+static size_t jsonl_set_values_plan_order_children(size_t list, size_t list_length, jsonl_set_values_plan_node_t* node_table);
+
+static size_t jsonl_set_values_plan_group_end(const jsonl_set_value_t* set_value_table, const size_t* order_table, size_t begin, size_t end, size_t depth);
+
+static void jsonl_set_values_plan_build(const jsonl_set_value_t* set_value_table, const size_t* order_table, size_t begin, size_t end, size_t depth, jsonl_set_values_plan_node_t* node_table, size_t node_index, size_t* node_count);
+
+static const jsonl_set_values_plan_node_t* jsonl_set_values_plan_find_child(const jsonl_set_values_plan_t* plan, const jsonl_set_values_plan_node_t* node, const jsonl_path_component_t* path_component);
+
+static const jsonl_set_values_plan_node_t* jsonl_set_values_plan_find_member_child(const jsonl_set_values_plan_t* plan, const jsonl_set_values_plan_node_t* node, size_t name_length, const char* name);
+
+static const jsonl_set_values_plan_node_t* jsonl_set_values_plan_find_element_child(const jsonl_set_values_plan_t* plan, const jsonl_set_values_plan_node_t* node, size_t index);
+
+static size_t jsonl_internal_set_values_create_planned_value(const jsonl_set_values_plan_t* plan, const jsonl_set_values_plan_node_t* node, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer);
+
+static size_t jsonl_internal_set_values_create_planned_path(const jsonl_set_values_plan_t* plan, const jsonl_set_values_plan_node_t* node, int container_type, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer);
+
+static size_t jsonl_internal_set_values_with_plan(const jsonl_set_values_plan_t* plan, const jsonl_set_values_plan_node_t* node, const jsonl_value_t* source_value, int share, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer);
+
+static int jsonl_set_values_scan_has_prefix(const jsonl_set_value_t* set_value_table, size_t set_value_index, size_t prefix_index, size_t depth);
+
+static void jsonl_set_values_scan_node(size_t set_value_count, const jsonl_set_value_t* set_value_table, size_t depth, size_t prefix_index, jsonl_internal_set_values_scan_node_t* node);
+
+static size_t jsonl_set_values_scan_find_child(size_t set_value_count, const jsonl_set_value_t* set_value_table, const jsonl_internal_set_values_scan_node_t* node, const jsonl_path_component_t* path_component);
+
+static int jsonl_set_values_scan_find_member_child(size_t set_value_count, const jsonl_set_value_t* set_value_table, const jsonl_internal_set_values_scan_node_t* node, size_t name_length, const char* name, jsonl_internal_set_values_scan_node_t* child_node);
+
+static int jsonl_set_values_scan_find_element_child(size_t set_value_count, const jsonl_set_value_t* set_value_table, const jsonl_internal_set_values_scan_node_t* node, size_t index, jsonl_internal_set_values_scan_node_t* child_node);
+
+static size_t jsonl_set_values_scan_next_child(size_t set_value_count, const jsonl_set_value_t* set_value_table, const jsonl_internal_set_values_scan_node_t* node, size_t set_value_index);
+
+static size_t jsonl_internal_set_values_create_scanned_value(size_t set_value_count, const jsonl_set_value_t* set_value_table, const jsonl_internal_set_values_scan_node_t* node, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer);
+
+static size_t jsonl_internal_set_values_create_scanned_path(size_t set_value_count, const jsonl_set_value_t* set_value_table, const jsonl_internal_set_values_scan_node_t* node, int container_type, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer);
+
+static size_t jsonl_internal_set_values_without_plan(size_t set_value_count, const jsonl_set_value_t* set_value_table, const jsonl_internal_set_values_scan_node_t* node, const jsonl_value_t* source_value, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer);
+
+static size_t jsonl_version_subtree_oldest_shared_epoch(const jsonl_version_t* version, const jsonl_value_t* value);
+
+static size_t jsonl_version_shared_value_epoch(const jsonl_version_t* base_version, const jsonl_value_t* value);
+
+static size_t jsonl_internal_create_version_subtree_table(const jsonl_version_t* version, const jsonl_version_t* base_version, const jsonl_value_t* value, jsonl_version_subtree_t* subtree_table, size_t* subtree_count);
+
+static uint64_t jsonl_internal_create_tree_hash(const jsonl_value_t* value, jsonl_tree_hash_node_t* node_table, size_t node_index, size_t* node_count);
+
+static size_t jsonl_count_tree_values(const jsonl_value_t* value);
+
+static void jsonl_writer_write_json_pointer_components(jsonl_writer_t* writer, const jsonl_internal_path_t* path);
+
+static void jsonl_diff_emit(jsonl_internal_diff_context_t* context, const jsonl_internal_path_t* path, int operation, const jsonl_value_t* value);
+
+static void jsonl_internal_diff(jsonl_internal_diff_context_t* context, size_t node_a, const jsonl_value_t* value_a, size_t node_b, const jsonl_value_t* value_b, const jsonl_internal_path_t* path);
+
+static int jsonl_internal_tree_hash_value_equal(const jsonl_tree_hash_node_t* node_table_a, size_t node_index_a, const jsonl_value_t* value_a, const jsonl_tree_hash_node_t* node_table_b, size_t node_index_b, const jsonl_value_t* value_b);
+
+static int jsonl_internal_compact_value_equal(const jsonl_tree_hash_node_t* node_table, size_t node_index_a, const jsonl_value_t* value_a, size_t node_index_b, const jsonl_value_t* value_b);
+
+static size_t jsonl_internal_compact_value(const jsonl_internal_compact_context_t* context, size_t node_index, const jsonl_value_t* value, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer, jsonl_value_t** compact_value);
+
+static size_t jsonl_builder_allocate(jsonl_builder_t* builder, size_t size);
+
+static size_t jsonl_builder_allocate_string(jsonl_builder_t* builder, size_t string_length, const char* string);
+
+static void jsonl_builder_clear_node(jsonl_internal_builder_node_t* node, int value_type);
+
+static size_t jsonl_builder_create_node(jsonl_builder_t* builder, size_t parent, int value_type);
+
+static size_t jsonl_builder_reserve_child(jsonl_builder_t* builder, size_t container_value, size_t entry_size);
+
+static size_t jsonl_internal_builder_finalize(const jsonl_builder_t* builder, size_t value, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer);
+
+static size_t jsonl_builder_find_member(const jsonl_builder_t* builder, size_t object_value, size_t name_length, const char* name);
+
+static size_t jsonl_builder_get_child(const jsonl_builder_t* builder, size_t value, const jsonl_path_component_t* path_component);
+
+static int jsonl_builder_import_value(jsonl_builder_t* builder, size_t value, const jsonl_value_t* source_value);
+
+static int jsonl_builder_resolve_json_pointer(jsonl_builder_t* builder, const jsonl_value_t* json_pointer, jsonl_internal_patch_target_t* target);
+
+static size_t jsonl_builder_get_patch_target(const jsonl_builder_t* builder, const jsonl_internal_patch_target_t* target);
+
+static int jsonl_builder_link_patch_target(jsonl_builder_t* builder, const jsonl_internal_patch_target_t* target, size_t value);
 
-static int jsonl_internal_set_values_create_path_sub_path_not_already_listed(size_t set_value_index, const jsonl_set_value_t* set_value_table, size_t depth);
+static int jsonl_builder_unlink_patch_target(jsonl_builder_t* builder, const jsonl_internal_patch_target_t* target);
 
-static size_t jsonl_internal_set_values_create_path(size_t path_index, size_t set_value_count, const jsonl_set_value_t* set_value_table, size_t value_buffer_size, jsonl_value_t* value_buffer, size_t depth, const jsonl_value_t* parent);
+static size_t jsonl_builder_copy_node(jsonl_builder_t* builder, size_t parent, size_t source_value);
 
-static int jsonl_internal_set_values_input_path_compare(const jsonl_set_value_t* input_path_a, const jsonl_set_value_t* input_path_b, size_t depth);
+static int jsonl_builder_value_equal(const jsonl_builder_t* builder, size_t value, const jsonl_value_t* value_tree);
 
-static int jsonl_internal_set_values_is_set_value_in_path(const jsonl_internal_path_t* internal_path, const jsonl_set_value_t* input_path);
+static const jsonl_value_t* jsonl_get_json_patch_member(const jsonl_value_t* operation, size_t name_length, const char* name, int required_value_type);
 
-static size_t jsonl_internal_set_values(size_t set_value_count, const jsonl_set_value_t* set_value_table, jsonl_internal_path_t* path, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer);
+static int jsonl_builder_apply_json_patch_operation(jsonl_builder_t* builder, const jsonl_value_t* operation);
+
+static int jsonl_builder_merge_patch(jsonl_builder_t* builder, size_t value, const jsonl_value_t* patch);
 
 static size_t jsonl_white_space_length(size_t json_text_size, const char* json_text)
 {
@@ -201,7 +650,7 @@ static size_t jsonl_quoted_string_lenght(size_t json_text_size, const char* json
 		char character = *read++;
 		if (!escape && character == '\"')
 			return (size_t)((uintptr_t)read - (uintptr_t)json_text);
-		escape = character == '\\';
+		escape = !escape && character == '\\';
 	}
 	return 0;
 }
@@ -271,6 +720,12 @@ static size_t jsonl_decode_quoted_string(size_t json_text_size, const char* json
 						*string_buffer++ = '\\';
 					++string_length;
 					break;
+				case '/' :
+					read += 2;
+					if (string_length < string_buffer_size)
+						*string_buffer++ = '/';
+					++string_length;
+					break;
 				case 'n':
 					read += 2;
 					if (string_length < string_buffer_size)
@@ -305,7 +760,29 @@ static size_t jsonl_decode_quoted_string(size_t json_text_size, const char* json
 					if (read + 5 != end && jsonl_is_hex_value(*(read + 2)) && jsonl_is_hex_value(*(read + 3)) && jsonl_is_hex_value(*(read + 4)) && jsonl_is_hex_value(*(read + 5)))
 					{
 						uint32_t unicode_character = ((uint32_t)jsonl_hex_value(*(read + 2)) << 12) | ((uint32_t)jsonl_hex_value(*(read + 3)) << 8) | ((uint32_t)jsonl_hex_value(*(read + 4)) << 4) | (uint32_t)jsonl_hex_value(*(read + 5));
-						if (unicode_character > 0x7FF)
+						uint32_t low_surrogate = 0;
+						if (unicode_character >= 0xD800 && unicode_character < 0xDC00 && (size_t)(end - read) > 11 && *(read + 6) == '\\' && *(read + 7) == 'u' &&
+							jsonl_is_hex_value(*(read + 8)) && jsonl_is_hex_value(*(read + 9)) && jsonl_is_hex_value(*(read + 10)) && jsonl_is_hex_value(*(read + 11)))
+							low_surrogate = ((uint32_t)jsonl_hex_value(*(read + 8)) << 12) | ((uint32_t)jsonl_hex_value(*(read + 9)) << 8) | ((uint32_t)jsonl_hex_value(*(read + 10)) << 4) | (uint32_t)jsonl_hex_value(*(read + 11));
+						if (low_surrogate >= 0xDC00 && low_surrogate < 0xE000)
+						{
+							// Surrogate pair is decoded to one supplementary character.
+							unicode_character = 0x10000 + ((unicode_character - 0xD800) << 10) + (low_surrogate - 0xDC00);
+							if (string_length < string_buffer_size)
+								*(uint8_t*)string_buffer++ = (uint8_t)(unicode_character >> 18) | 0xF0;
+							++string_length;
+							if (string_length < string_buffer_size)
+								*(uint8_t*)string_buffer++ = (uint8_t)((unicode_character >> 12) & 0x3F) | 0x80;
+							++string_length;
+							if (string_length < string_buffer_size)
+								*(uint8_t*)string_buffer++ = (uint8_t)((unicode_character >> 6) & 0x3F) | 0x80;
+							++string_length;
+							if (string_length < string_buffer_size)
+								*(uint8_t*)string_buffer++ = (uint8_t)(unicode_character & 0x3F) | 0x80;
+							++string_length;
+							read += 6;
+						}
+						else if (unicode_character > 0x7FF)
 						{
 							if (string_length < string_buffer_size)
 								*(uint8_t*)string_buffer++ = (uint8_t)(unicode_character >> 12) | 0xE0;
@@ -869,62 +1346,255 @@ static void jsonl_terminator_string(char* string_end)
 		*string_end++ = 0;
 }
 
-static size_t jsonl_create_tree_from_text(size_t json_text_size, const char* json_text, size_t value_buffer_size, jsonl_value_t* value_buffer, jsonl_value_t* parent_value, size_t* required_value_buffer_size)
+static size_t jsonl_object_index_bucket_count(size_t value_count)
 {
-	size_t value_text_size;
-	int value_type = jsonl_decide_value_type(json_text_size, json_text, &value_text_size);
-	int expecting_sub_value;
-	int boolean_value;
-	jsonl_number_value_t number_value_structure;
-	size_t value_size = jsonl_round_size(sizeof(jsonl_value_t));
-	size_t string_length;
-	size_t string_size;
-	size_t sub_value_text_size;
-	size_t sub_value_count;
-	size_t sub_value_size;
-	uintptr_t polymorphic_content = (uintptr_t)value_buffer + value_size;
-	jsonl_value_t* sub_value_content;
-	const char* end = json_text + value_text_size - 1;
-	const char* read = json_text + 1;
-	switch (value_type)
+#ifdef JSONL_NO_OBJECT_INDEX
+	return 0;
+#else
+	if (value_count < JSONL_OBJECT_INDEX_MINIMUM_VALUE_COUNT)
+		return 0;
+	size_t bucket_count = 1;
+	while (bucket_count < 2 * value_count)
+		bucket_count <<= 1;
+	return bucket_count;
+#endif
+}
+
+static size_t jsonl_object_index_size(size_t value_count)
+{
+	const jsonl_object_index_t* index = 0;
+	size_t bucket_count = jsonl_object_index_bucket_count(value_count);
+	if (!bucket_count)
+		return 0;
+	return jsonl_round_size(sizeof(jsonl_object_index_t)) + jsonl_round_size(bucket_count * sizeof(*index->bucket_table));
+}
+
+static void jsonl_create_object_index(jsonl_value_t* object_value, void* index_buffer, const jsonl_object_index_t* source_index)
+{
+	size_t value_count = object_value->object.value_count;
+	size_t bucket_count = jsonl_object_index_bucket_count(value_count);
+	if (!bucket_count)
 	{
-		case JSONL_TYPE_OBJECT:
-			sub_value_count = jsonl_count_object_name_value_pairs(value_text_size, json_text);
-			if (sub_value_count == (size_t)~0)
-				return 0;
-			value_size += jsonl_round_size(sub_value_count * sizeof(*value_buffer->object.table));
-			sub_value_content = (jsonl_value_t*)((uintptr_t)value_buffer + value_size);
-			expecting_sub_value = 1;
-			if (value_size <= value_buffer_size)
-			{
-				value_buffer->object.value_count = sub_value_count;
-				*(uintptr_t*)&value_buffer->object.table = polymorphic_content;
-			}
-			for (size_t sub_object_index = 0; sub_object_index != sub_value_count;)
-			{
-				char character = *read;
-				if (expecting_sub_value)
-				{
-					if (character == '"')
-					{
-						size_t name_length;
-						size_t value_offset;
+		object_value->object.index = 0;
+		return;
+	}
+	jsonl_object_index_t* index = (jsonl_object_index_t*)index_buffer;
+	index->bucket_count = bucket_count;
+	index->bucket_table = (jsonl_object_index_bucket_t*)((uintptr_t)index_buffer + jsonl_round_size(sizeof(jsonl_object_index_t)));
+	if (source_index && source_index->bucket_count == bucket_count)
+	{
+		for (size_t i = 0; i != bucket_count; ++i)
+		{
+			index->bucket_table[i].hash = source_index->bucket_table[i].hash;
+			index->bucket_table[i].member_index = source_index->bucket_table[i].member_index;
+		}
+	}
+	else
+	{
+		size_t bucket_mask = bucket_count - 1;
+		for (size_t i = 0; i != bucket_count; ++i)
+			index->bucket_table[i].member_index = (size_t)~0;
+		for (size_t i = 0; i != value_count; ++i)
+		{
+			size_t hash = jsonl_hash_name(object_value->object.table[i].name_length, object_value->object.table[i].name);
+			size_t bucket_index = hash & bucket_mask;
+			while (index->bucket_table[bucket_index].member_index != (size_t)~0)
+				bucket_index = (bucket_index + 1) & bucket_mask;
+			index->bucket_table[bucket_index].hash = hash;
+			index->bucket_table[bucket_index].member_index = i;
+		}
+	}
+	object_value->object.index = index;
+}
+
+static size_t jsonl_find_object_member_with_hash(const jsonl_value_t* object_value, size_t name_length, const char* name, size_t name_hash)
+{
+	const jsonl_object_index_t* index = object_value->object.index;
+	JSONL_ASSERT(index && index->bucket_count > object_value->object.value_count);
+	size_t bucket_mask = index->bucket_count - 1;
+	for (size_t bucket_index = name_hash & bucket_mask;; bucket_index = (bucket_index + 1) & bucket_mask)
+	{
+		size_t member_index = index->bucket_table[bucket_index].member_index;
+		if (member_index == (size_t)~0)
+			return (size_t)~0;
+		if (index->bucket_table[bucket_index].hash == name_hash && object_value->object.table[member_index].name_length == name_length && (object_value->object.table[member_index].name == name || jsonl_memory_compare(object_value->object.table[member_index].name, name, name_length)))
+			return member_index;
+	}
+}
+
+static size_t jsonl_find_object_member(const jsonl_value_t* object_value, size_t name_length, const char* name)
+{
+	if (object_value->object.index)
+		return jsonl_find_object_member_with_hash(object_value, name_length, name, jsonl_hash_name(name_length, name));
+	for (size_t n = object_value->object.value_count, i = 0; i != n; ++i)
+		if (object_value->object.table[i].name_length == name_length && (object_value->object.table[i].name == name || jsonl_memory_compare(object_value->object.table[i].name, name, name_length)))
+			return i;
+	return (size_t)~0;
+}
+
+static size_t jsonl_find_matching_object_member(const jsonl_value_t* object_value, size_t member_index, const jsonl_value_t* other_object_value)
+{
+	// Members with repeated names are matched in order of occurrence, so the second member of a name matches the second member of the same name.
+	size_t name_length = object_value->object.table[member_index].name_length;
+	const char* name = object_value->object.table[member_index].name;
+	size_t other_member_index = jsonl_find_object_member(other_object_value, name_length, name);
+	if (other_member_index == (size_t)~0 || jsonl_find_object_member(object_value, name_length, name) == member_index)
+		return other_member_index;
+	size_t occurrence = 0;
+	for (size_t i = 0; i != member_index; ++i)
+		if (object_value->object.table[i].name_length == name_length && jsonl_memory_compare(object_value->object.table[i].name, name, name_length))
+			++occurrence;
+	for (size_t n = other_object_value->object.value_count, i = other_member_index + 1; i != n; ++i)
+		if (other_object_value->object.table[i].name_length == name_length && jsonl_memory_compare(other_object_value->object.table[i].name, name, name_length) && !--occurrence)
+			return i;
+	return (size_t)~0;
+}
+
+static jsonl_internal_interned_name_t* jsonl_find_interned_name(jsonl_internal_parse_context_t* context, size_t quoted_name_size, const char* quoted_name)
+{
+	if (!context->interned_name_bucket_count)
+		return 0;
+	size_t hash = jsonl_hash_name(quoted_name_size, quoted_name);
+	size_t bucket_mask = context->interned_name_bucket_count - 1;
+	for (size_t bucket_index = hash & bucket_mask;; bucket_index = (bucket_index + 1) & bucket_mask)
+	{
+		jsonl_internal_interned_name_t* interned_name = context->interned_name_table + bucket_index;
+		if (!interned_name->text)
+		{
+			if (2 * (context->interned_name_count + 1) > context->interned_name_bucket_count)
+				return 0;
+			interned_name->hash = hash;
+			return interned_name;
+		}
+		if (interned_name->hash == hash && interned_name->text_size == quoted_name_size && jsonl_memory_compare(interned_name->text, quoted_name, quoted_name_size))
+			return interned_name;
+	}
+}
+
+#ifdef JSONL_PARSE_STATISTICS
+static size_t jsonl_count_escapes(size_t json_text_size, const char* json_text)
+{
+	size_t escape_count = 0;
+	for (const char* read = json_text, * end = json_text + json_text_size; read != end; ++read)
+		if (*read == '\\' && read + 1 != end)
+		{
+			++escape_count;
+			++read;
+		}
+	return escape_count;
+}
+
+#endif
+static size_t jsonl_create_tree_from_text(size_t json_text_size, const char* json_text, size_t value_buffer_size, jsonl_value_t* value_buffer, jsonl_value_t* parent_value, size_t* required_value_buffer_size, jsonl_internal_parse_context_t* context)
+{
+	size_t value_text_size;
+	JSONL_PARSE_STATISTICS_BEGIN_PHASE(context);
+	int value_type = jsonl_decide_value_type(json_text_size, json_text, &value_text_size);
+	JSONL_PARSE_STATISTICS_END_PHASE(context, scan_time);
+	if (value_type == JSONL_TYPE_ERROR || !jsonl_parse_count_steps(context, value_text_size) || context->value_count == context->maximum_value_count || !jsonl_parse_reserve_value_buffer(context, jsonl_round_size(sizeof(jsonl_value_t))))
+		return 0;
+	++context->value_count;
+	JSONL_PARSE_STATISTICS_ADD(context, value_count_table[value_type], 1);
+	JSONL_PARSE_STATISTICS_ADD(context, node_buffer_size, jsonl_round_size(sizeof(jsonl_value_t)));
+	int expecting_sub_value;
+	int boolean_value;
+	jsonl_number_value_t number_value_structure;
+	size_t value_size = jsonl_round_size(sizeof(jsonl_value_t));
+	size_t string_length;
+	size_t string_size;
+	size_t sub_value_text_size;
+	size_t sub_value_count;
+	size_t sub_value_size;
+	size_t index_size;
+	uintptr_t polymorphic_content = (uintptr_t)value_buffer + value_size;
+	uintptr_t index_content;
+	jsonl_value_t* sub_value_content;
+	const char* end = json_text + value_text_size - 1;
+	const char* read = json_text + 1;
+	switch (value_type)
+	{
+		case JSONL_TYPE_OBJECT:
+			if (context->depth == context->maximum_depth)
+				return 0;
+			++context->depth;
+			JSONL_PARSE_STATISTICS_UPDATE_DEPTH(context);
+			// Counting reads the text once to find the end of the object and once more to find the ends of the members.
+			JSONL_PARSE_STATISTICS_BEGIN_PHASE(context);
+			sub_value_count = jsonl_count_object_name_value_pairs(value_text_size, json_text);
+			JSONL_PARSE_STATISTICS_END_PHASE(context, count_time);
+			if (sub_value_count == (size_t)~0 || !jsonl_parse_count_steps(context, value_text_size) || !jsonl_parse_count_steps(context, value_text_size) || sub_value_count > context->maximum_value_count - context->value_count)
+				return 0;
+			value_size += jsonl_round_size(sub_value_count * sizeof(*value_buffer->object.table));
+			index_size = jsonl_object_index_size(sub_value_count);
+			if (!jsonl_parse_reserve_value_buffer(context, jsonl_round_size(sub_value_count * sizeof(*value_buffer->object.table)) + index_size))
+				return 0;
+			JSONL_PARSE_STATISTICS_ADD(context, table_buffer_size, jsonl_round_size(sub_value_count * sizeof(*value_buffer->object.table)) + index_size);
+			index_content = (uintptr_t)value_buffer + value_size;
+			value_size += index_size;
+			sub_value_content = (jsonl_value_t*)((uintptr_t)value_buffer + value_size);
+			expecting_sub_value = 1;
+			if (value_size <= value_buffer_size)
+			{
+				value_buffer->object.value_count = sub_value_count;
+				*(uintptr_t*)&value_buffer->object.table = polymorphic_content;
+			}
+			for (size_t sub_object_index = 0; sub_object_index != sub_value_count;)
+			{
+				char character = *read;
+				if (expecting_sub_value)
+				{
+					if (character == '"')
+					{
+						size_t name_length;
+						size_t value_offset;
 						size_t value_lenght;
+						JSONL_PARSE_STATISTICS_BEGIN_PHASE(context);
 						size_t name_value_pair_length = jsonl_name_value_pair_size((size_t)((uintptr_t)end - (uintptr_t)read), read, &name_length, 0, &value_offset, &value_lenght);
-						if (!name_value_pair_length || !jsonl_decode_quoted_string(name_length, read, (value_size <= value_buffer_size) ? (value_buffer_size - value_size) : 0, (char*)sub_value_content, &string_length))
+						JSONL_PARSE_STATISTICS_END_PHASE(context, scan_time);
+						if (!name_value_pair_length || !jsonl_parse_count_steps(context, name_value_pair_length))
 							return 0;
-						string_size = jsonl_round_size(string_length + 1);
+						char* name;
+						jsonl_internal_interned_name_t* interned_name = jsonl_find_interned_name(context, name_length, read);
+						if (interned_name && interned_name->text)
+						{
+							name = interned_name->name;
+							string_length = interned_name->name_length;
+							string_size = 0;
+						}
+						else
+						{
+							JSONL_PARSE_STATISTICS_BEGIN_PHASE(context);
+							if (!jsonl_decode_quoted_string(name_length, read, (value_size <= value_buffer_size) ? (value_buffer_size - value_size) : 0, (char*)sub_value_content, &string_length))
+								return 0;
+							JSONL_PARSE_STATISTICS_END_PHASE(context, decode_time);
+							name = (char*)sub_value_content;
+							string_size = jsonl_round_size(string_length + 1);
+							if (!jsonl_parse_count_steps(context, name_length) || string_length > context->maximum_string_length || !jsonl_parse_reserve_value_buffer(context, string_size))
+								return 0;
+							JSONL_PARSE_STATISTICS_ADD(context, string_byte_count, string_length);
+							JSONL_PARSE_STATISTICS_COUNT_ESCAPES(context, name_length, read);
+							JSONL_PARSE_STATISTICS_ADD(context, string_buffer_size, string_size);
+							if (interned_name)
+							{
+								interned_name->text_size = name_length;
+								interned_name->text = read;
+								interned_name->name_length = string_length;
+								interned_name->name = name;
+								++context->interned_name_count;
+							}
+						}
 						value_size += string_size;
 						if (value_size <= value_buffer_size)
 						{
 							jsonl_value_t* next_sub_value_content = (jsonl_value_t*)((uintptr_t)sub_value_content + string_size);
 							value_buffer->object.table[sub_object_index].name_length = string_length;
-							value_buffer->object.table[sub_object_index].name = (char*)sub_value_content;
+							value_buffer->object.table[sub_object_index].name = name;
 							value_buffer->object.table[sub_object_index].value = next_sub_value_content;
-							jsonl_terminator_string((char*)sub_value_content + string_length);
+							if (string_size)
+								jsonl_terminator_string(name + string_length);
 							sub_value_content = next_sub_value_content;
 						}
-						size_t value_text_lenght = jsonl_create_tree_from_text(value_lenght, read + value_offset, (value_size <= value_buffer_size) ? (value_buffer_size - value_size) : 0, sub_value_content, value_buffer, &sub_value_size);
+						size_t value_text_lenght = jsonl_create_tree_from_text(value_lenght, read + value_offset, (value_size <= value_buffer_size) ? (value_buffer_size - value_size) : 0, sub_value_content, value_buffer, &sub_value_size, context);
 						if (!value_text_lenght)
 							return 0;
 						value_size += sub_value_size;
@@ -949,17 +1619,30 @@ static size_t jsonl_create_tree_from_text(size_t json_text_size, const char* jso
 			}
 			if (value_size <= value_buffer_size)
 			{
+				JSONL_PARSE_STATISTICS_BEGIN_PHASE(context);
+				jsonl_create_object_index(value_buffer, (void*)index_content, 0);
+				JSONL_PARSE_STATISTICS_END_PHASE(context, index_time);
 				value_buffer->type = value_type;
 				value_buffer->size = value_size;
 				value_buffer->parent = parent_value;
 			}
+			--context->depth;
 			*required_value_buffer_size = value_size;
 			return value_text_size;
 		case JSONL_TYPE_ARRAY:
+			if (context->depth == context->maximum_depth)
+				return 0;
+			++context->depth;
+			JSONL_PARSE_STATISTICS_UPDATE_DEPTH(context);
+			JSONL_PARSE_STATISTICS_BEGIN_PHASE(context);
 			sub_value_count = jsonl_count_array_values(value_text_size, json_text);
-			if (sub_value_count == (size_t)~0)
+			JSONL_PARSE_STATISTICS_END_PHASE(context, count_time);
+			if (sub_value_count == (size_t)~0 || !jsonl_parse_count_steps(context, value_text_size) || !jsonl_parse_count_steps(context, value_text_size) || sub_value_count > context->maximum_value_count - context->value_count)
 				return 0;
 			value_size += jsonl_round_size(sub_value_count * sizeof(jsonl_value_t*));
+			if (!jsonl_parse_reserve_value_buffer(context, jsonl_round_size(sub_value_count * sizeof(jsonl_value_t*))))
+				return 0;
+			JSONL_PARSE_STATISTICS_ADD(context, table_buffer_size, jsonl_round_size(sub_value_count * sizeof(jsonl_value_t*)));
 			sub_value_content = (jsonl_value_t*)((uintptr_t)value_buffer + value_size);
 			expecting_sub_value = 1;
 			for (size_t sub_object_index = 0; sub_object_index != sub_value_count;)
@@ -971,7 +1654,7 @@ static size_t jsonl_create_tree_from_text(size_t json_text_size, const char* jso
 						++read;
 					else
 					{
-						sub_value_text_size = jsonl_create_tree_from_text((size_t)((uintptr_t)end - (uintptr_t)read), read, (value_size <= value_buffer_size) ? (value_buffer_size - value_size) : 0, sub_value_content, value_buffer, &sub_value_size);
+						sub_value_text_size = jsonl_create_tree_from_text((size_t)((uintptr_t)end - (uintptr_t)read), read, (value_size <= value_buffer_size) ? (value_buffer_size - value_size) : 0, sub_value_content, value_buffer, &sub_value_size, context);
 						if (!sub_value_text_size)
 							return 0;
 						if (value_size <= value_buffer_size)
@@ -1002,11 +1685,19 @@ static size_t jsonl_create_tree_from_text(size_t json_text_size, const char* jso
 				value_buffer->size = value_size;
 				value_buffer->parent = parent_value;
 			}
+			--context->depth;
 			*required_value_buffer_size = value_size;
 			return value_text_size;
 		case JSONL_TYPE_STRING:
+			JSONL_PARSE_STATISTICS_BEGIN_PHASE(context);
 			if (!jsonl_decode_quoted_string(value_text_size, json_text, (value_size <= value_buffer_size) ? (value_buffer_size - value_size) : 0, (char*)polymorphic_content, &string_length))
 				return 0;
+			JSONL_PARSE_STATISTICS_END_PHASE(context, decode_time);
+			if (!jsonl_parse_count_steps(context, value_text_size) || string_length > context->maximum_string_length || !jsonl_parse_reserve_value_buffer(context, jsonl_round_size(string_length + 1)))
+				return 0;
+			JSONL_PARSE_STATISTICS_ADD(context, string_byte_count, string_length);
+			JSONL_PARSE_STATISTICS_ADD(context, string_buffer_size, jsonl_round_size(string_length + 1));
+			JSONL_PARSE_STATISTICS_COUNT_ESCAPES(context, value_text_size, json_text);
 			value_size += jsonl_round_size(string_length + 1);
 			if (value_size <= value_buffer_size)
 			{
@@ -1020,8 +1711,12 @@ static size_t jsonl_create_tree_from_text(size_t json_text_size, const char* jso
 			*required_value_buffer_size = value_size;
 			return value_text_size;
 		case JSONL_TYPE_NUMBER:
+			JSONL_PARSE_STATISTICS_BEGIN_PHASE(context);
 			if (!jsonl_decode_number(value_text_size, json_text, &number_value_structure))
 				return 0;
+			JSONL_PARSE_STATISTICS_END_PHASE(context, decode_time);
+			if (!jsonl_parse_count_steps(context, value_text_size))
+				return 0;
 			if (value_size <= value_buffer_size)
 			{
 				value_buffer->number = number_value_structure;
@@ -1032,8 +1727,12 @@ static size_t jsonl_create_tree_from_text(size_t json_text_size, const char* jso
 			*required_value_buffer_size = value_size;
 			return value_text_size;
 		case JSONL_TYPE_BOOLEAN:
+			JSONL_PARSE_STATISTICS_BEGIN_PHASE(context);
 			if (!jsonl_decode_boolean(value_text_size, json_text, &boolean_value))
 				return 0;
+			JSONL_PARSE_STATISTICS_END_PHASE(context, decode_time);
+			if (!jsonl_parse_count_steps(context, value_text_size))
+				return 0;
 			if (value_size <= value_buffer_size)
 			{
 				value_buffer->boolean.value = boolean_value;
@@ -1059,56 +1758,437 @@ static size_t jsonl_create_tree_from_text(size_t json_text_size, const char* jso
 
 size_t jsonl_parse_text(size_t json_text_size, const char* json_text, size_t value_buffer_size, jsonl_value_t* value_buffer)
 {
+	return jsonl_parse_text_with_options(json_text_size, json_text, 0, value_buffer_size, value_buffer);
+}
+
+static size_t jsonl_internal_parse_text(size_t json_text_size, const char* json_text, const jsonl_parse_options_t* options, jsonl_internal_parse_context_t* context, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	context->interned_name_count = 0;
+	context->interned_name_bucket_count = 0;
+	context->interned_name_table = 0;
+	context->depth = 0;
+	context->value_count = 0;
+	context->value_buffer_size = 0;
+	context->step_count = 0;
+	context->maximum_depth = (size_t)~0;
+	context->maximum_value_count = (size_t)~0;
+	context->maximum_string_length = (size_t)~0;
+	context->maximum_value_buffer_size = (size_t)~0;
+	context->maximum_step_count = (uint64_t)~0;
+#ifdef JSONL_PARSE_STATISTICS
+	context->phase_begin_time = 0;
+#endif
+	if (options && options->limits)
+	{
+		const jsonl_parse_limits_t* limits = options->limits;
+		if (limits->maximum_text_size && json_text_size > limits->maximum_text_size)
+			return 0;
+		if (limits->maximum_depth)
+			context->maximum_depth = limits->maximum_depth;
+		if (limits->maximum_value_count)
+			context->maximum_value_count = limits->maximum_value_count;
+		if (limits->maximum_string_length)
+			context->maximum_string_length = limits->maximum_string_length;
+		if (limits->maximum_value_buffer_size)
+			context->maximum_value_buffer_size = limits->maximum_value_buffer_size;
+		if (limits->maximum_step_count)
+			context->maximum_step_count = limits->maximum_step_count;
+	}
+	if (options && (options->flags & JSONL_PARSE_FLAG_INTERN_NAMES))
+	{
+		uintptr_t scratch_buffer = (uintptr_t)options->scratch_buffer;
+		uintptr_t scratch_buffer_end = scratch_buffer + options->scratch_buffer_size;
+		uintptr_t interned_name_table = (scratch_buffer + (uintptr_t)jsonl_value_alignment_minus_one) & ~(uintptr_t)jsonl_value_alignment_minus_one;
+		if (scratch_buffer && interned_name_table < scratch_buffer_end)
+		{
+			size_t maximum_bucket_count = (size_t)(scratch_buffer_end - interned_name_table) / sizeof(jsonl_internal_interned_name_t);
+			size_t bucket_count = maximum_bucket_count ? 1 : 0;
+			while (bucket_count && (bucket_count << 1) <= maximum_bucket_count)
+				bucket_count <<= 1;
+			context->interned_name_bucket_count = bucket_count;
+			context->interned_name_table = (jsonl_internal_interned_name_t*)interned_name_table;
+			for (size_t i = 0; i != bucket_count; ++i)
+				context->interned_name_table[i].text = 0;
+		}
+	}
 	size_t beginning_white_space = jsonl_white_space_length(json_text_size, json_text);
 	size_t tree_size;
-	if (jsonl_create_tree_from_text(json_text_size - beginning_white_space, json_text + beginning_white_space, value_buffer_size, value_buffer, 0, &tree_size))
+	if (jsonl_create_tree_from_text(json_text_size - beginning_white_space, json_text + beginning_white_space, value_buffer_size, value_buffer, 0, &tree_size, context))
 		return tree_size;
 	else
 		return 0;
 }
 
+size_t jsonl_parse_text_with_options(size_t json_text_size, const char* json_text, const jsonl_parse_options_t* options, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	jsonl_internal_parse_context_t context;
+#ifdef JSONL_PARSE_STATISTICS
+	context.statistics = 0;
+#endif
+	return jsonl_internal_parse_text(json_text_size, json_text, options, &context, value_buffer_size, value_buffer);
+}
+
+#ifdef JSONL_PARSE_STATISTICS
+size_t jsonl_parse_text_with_statistics(size_t json_text_size, const char* json_text, const jsonl_parse_options_t* options, jsonl_parse_stats_t* statistics, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	uint64_t begin_time = JSONL_PARSE_STATISTICS_CLOCK();
+	for (int i = 0; i != JSONL_TYPE_NULL + 1; ++i)
+		statistics->value_count_table[i] = 0;
+	statistics->maximum_depth = 0;
+	statistics->string_byte_count = 0;
+	statistics->escape_count = 0;
+	statistics->node_buffer_size = 0;
+	statistics->table_buffer_size = 0;
+	statistics->string_buffer_size = 0;
+	statistics->scan_time = 0;
+	statistics->count_time = 0;
+	statistics->decode_time = 0;
+	statistics->index_time = 0;
+	jsonl_internal_parse_context_t context;
+	context.statistics = statistics;
+	size_t tree_size = jsonl_internal_parse_text(json_text_size, json_text, options, &context, value_buffer_size, value_buffer);
+	statistics->scanned_byte_count = context.step_count;
+	statistics->total_time = JSONL_PARSE_STATISTICS_CLOCK() - begin_time;
+	return tree_size;
+}
+#endif
+
+static const jsonl_value_t* jsonl_get_child_value(const jsonl_value_t* parent_value, const jsonl_path_component_t* path_component)
+{
+	if (path_component->container_type != parent_value->type)
+		return 0;
+	if (parent_value->type == JSONL_TYPE_OBJECT)
+	{
+		size_t child_index = jsonl_find_object_member(parent_value, path_component->name.length, path_component->name.value);
+		if (child_index == (size_t)~0)
+			return 0;
+		return parent_value->object.table[child_index].value;
+	}
+	else if (parent_value->type == JSONL_TYPE_ARRAY)
+	{
+		if (path_component->index >= parent_value->array.value_count)
+			return 0;
+		return parent_value->array.table[path_component->index];
+	}
+	else
+		return 0;
+}
+
 const jsonl_value_t* jsonl_get_value(const jsonl_value_t* parent_value, size_t path_length, const jsonl_path_component_t* path_table, int required_value_type)
 {
 	const jsonl_value_t* iterator = parent_value;
-	for (size_t i = 0; i != path_length; ++i)
-		if (path_table[i].container_type == iterator->type)
+	for (size_t i = 0; iterator && i != path_length; ++i)
+		iterator = jsonl_get_child_value(iterator, path_table + i);
+	if (!iterator || (required_value_type && iterator->type != required_value_type))
+		return 0;
+	return iterator;
+}
+
+static int jsonl_path_component_compare(const jsonl_path_component_t* path_component_a, const jsonl_path_component_t* path_component_b)
+{
+	if (path_component_a->container_type != path_component_b->container_type)
+		return (path_component_a->container_type < path_component_b->container_type) ? -1 : 1;
+	if (path_component_a->container_type == JSONL_TYPE_OBJECT)
+	{
+		if (path_component_a->name.length != path_component_b->name.length)
+			return (path_component_a->name.length < path_component_b->name.length) ? -1 : 1;
+		return jsonl_memory_order(path_component_a->name.value, path_component_b->name.value, path_component_a->name.length);
+	}
+	else if (path_component_a->container_type == JSONL_TYPE_ARRAY)
+	{
+		if (path_component_a->index != path_component_b->index)
+			return (path_component_a->index < path_component_b->index) ? -1 : 1;
+		return 0;
+	}
+	else
+		return 0;
+}
+
+static int jsonl_get_values_path_compare(const jsonl_get_value_t* get_value_a, const jsonl_get_value_t* get_value_b)
+{
+	size_t common_length = (get_value_a->path_length < get_value_b->path_length) ? get_value_a->path_length : get_value_b->path_length;
+	for (size_t i = 0; i != common_length; ++i)
+	{
+		int component_order = jsonl_path_component_compare(get_value_a->path + i, get_value_b->path + i);
+		if (component_order)
+			return component_order;
+	}
+	if (get_value_a->path_length != get_value_b->path_length)
+		return (get_value_a->path_length < get_value_b->path_length) ? -1 : 1;
+	return 0;
+}
+
+static JSONL_INLINE size_t jsonl_get_values_next(const jsonl_value_t** value_table, size_t list)
+{
+	return (size_t)(uintptr_t)value_table[list];
+}
+
+static JSONL_INLINE void jsonl_get_values_link(const jsonl_value_t** value_table, size_t list, size_t next)
+{
+	value_table[list] = (const jsonl_value_t*)(uintptr_t)next;
+}
+
+static size_t jsonl_get_values_sort(size_t list, size_t list_length, const jsonl_get_value_t* get_value_table, const jsonl_value_t** value_table)
+{
+	if (list_length < 2)
+		return list;
+	size_t left_length = list_length / 2;
+	size_t left_last = list;
+	for (size_t i = 1; i != left_length; ++i)
+		left_last = jsonl_get_values_next(value_table, left_last);
+	size_t right = jsonl_get_values_next(value_table, left_last);
+	jsonl_get_values_link(value_table, left_last, (size_t)~0);
+	size_t left = jsonl_get_values_sort(list, left_length, get_value_table, value_table);
+	right = jsonl_get_values_sort(right, list_length - left_length, get_value_table, value_table);
+	size_t head = (size_t)~0;
+	size_t tail = (size_t)~0;
+	while (left != (size_t)~0 || right != (size_t)~0)
+	{
+		size_t next;
+		if (right == (size_t)~0 || (left != (size_t)~0 && jsonl_get_values_path_compare(get_value_table + left, get_value_table + right) <= 0))
+		{
+			next = left;
+			left = jsonl_get_values_next(value_table, left);
+		}
+		else
+		{
+			next = right;
+			right = jsonl_get_values_next(value_table, right);
+		}
+		if (tail != (size_t)~0)
+			jsonl_get_values_link(value_table, tail, next);
+		else
+			head = next;
+		tail = next;
+	}
+	jsonl_get_values_link(value_table, tail, (size_t)~0);
+	return head;
+}
+
+static size_t jsonl_get_values_resolve(const jsonl_value_t* value, size_t depth, size_t list, size_t list_end, const jsonl_get_value_t* get_value_table, const jsonl_value_t** value_table)
+{
+	size_t found_count = 0;
+	while (list != list_end)
+	{
+		const jsonl_get_value_t* get_value = get_value_table + list;
+		if (get_value->path_length == depth)
 		{
-			if (iterator->type == JSONL_TYPE_OBJECT)
+			size_t next = jsonl_get_values_next(value_table, list);
+			if (!get_value->required_value_type || value->type == get_value->required_value_type)
 			{
-				size_t child_index = (size_t)~0;
-				for (size_t n = iterator->object.value_count, j = 0; child_index == (size_t)~0 && j != n; ++j)
-					if (path_table[i].name.length == iterator->object.table[j].name_length && jsonl_memory_compare(path_table[i].name.value, iterator->object.table[j].name, path_table[i].name.length))
-						child_index = j;
-				if (child_index == (size_t)~0)
-					return 0;
-				iterator = iterator->object.table[child_index].value;
+				value_table[list] = value;
+				++found_count;
 			}
-			else if (iterator->type == JSONL_TYPE_ARRAY)
+			else
+				value_table[list] = 0;
+			list = next;
+		}
+		else
+		{
+			JSONL_ASSERT(get_value->path_length > depth);
+			const jsonl_path_component_t* path_component = get_value->path + depth;
+			size_t group_end = jsonl_get_values_next(value_table, list);
+			while (group_end != list_end && !jsonl_path_component_compare(get_value_table[group_end].path + depth, path_component))
+				group_end = jsonl_get_values_next(value_table, group_end);
+			const jsonl_value_t* child_value = jsonl_get_child_value(value, path_component);
+			if (child_value)
+				found_count += jsonl_get_values_resolve(child_value, depth + 1, list, group_end, get_value_table, value_table);
+			else
+				while (list != group_end)
+				{
+					size_t next = jsonl_get_values_next(value_table, list);
+					value_table[list] = 0;
+					list = next;
+				}
+			list = group_end;
+		}
+	}
+	return found_count;
+}
+
+size_t jsonl_get_values(const jsonl_value_t* parent_value, size_t get_value_count, const jsonl_get_value_t* get_value_table, const jsonl_value_t** value_table)
+{
+	if (!get_value_count)
+		return 0;
+	for (size_t i = 0; i != get_value_count; ++i)
+		jsonl_get_values_link(value_table, i, (i + 1 != get_value_count) ? (i + 1) : (size_t)~0);
+	size_t list = jsonl_get_values_sort(0, get_value_count, get_value_table, value_table);
+	return jsonl_get_values_resolve(parent_value, 0, list, (size_t)~0, get_value_table, value_table);
+}
+
+static int jsonl_decode_json_pointer_token(size_t token_size, const char* token, size_t name_buffer_size, char* name_buffer, size_t* name_length)
+{
+	const char* end = token + token_size;
+	const char* read = token;
+	size_t length = 0;
+	while (read != end)
+	{
+		char character = *read++;
+		if (character == '~')
+		{
+			if (read == end)
+				return 0;
+			if (*read == '0')
+				character = '~';
+			else if (*read == '1')
+				character = '/';
+			else
+				return 0;
+			++read;
+		}
+		if (length < name_buffer_size)
+			name_buffer[length] = character;
+		++length;
+	}
+	*name_length = length;
+	return 1;
+}
+
+static size_t jsonl_decode_array_index(size_t text_size, const char* text)
+{
+	if (!text_size || (text_size > 1 && *text == '0'))
+		return (size_t)~0;
+	size_t index = 0;
+	for (size_t i = 0; i != text_size; ++i)
+	{
+		if (!jsonl_is_decimal_value(text[i]))
+			return (size_t)~0;
+		size_t new_index = index * 10;
+		if (new_index / 10 != index)
+			return (size_t)~0;
+		index = new_index + (size_t)jsonl_decimal_value(text[i]);
+		if (index < new_index)
+			return (size_t)~0;
+	}
+	return index;
+}
+
+size_t jsonl_compile_path(size_t path_length, const jsonl_path_component_t* path_table, size_t compiled_path_buffer_size, jsonl_compiled_path_t* compiled_path_buffer)
+{
+	size_t compiled_path_size = jsonl_round_size(sizeof(jsonl_compiled_path_t));
+	jsonl_compiled_path_component_t* component_table = (jsonl_compiled_path_component_t*)((uintptr_t)compiled_path_buffer + compiled_path_size);
+	compiled_path_size += jsonl_round_size(path_length * sizeof(jsonl_compiled_path_component_t));
+	for (size_t i = 0; i != path_length; ++i)
+	{
+		int container_type = path_table[i].container_type;
+		if (container_type != JSONL_TYPE_OBJECT && container_type != JSONL_TYPE_ARRAY)
+			return 0;
+		size_t name_length = (container_type == JSONL_TYPE_OBJECT) ? path_table[i].name.length : 0;
+		char* name = (char*)((uintptr_t)compiled_path_buffer + compiled_path_size);
+		compiled_path_size += jsonl_round_size(name_length + 1);
+		if (compiled_path_size <= compiled_path_buffer_size)
+		{
+			component_table[i].container_type = container_type;
+			if (container_type == JSONL_TYPE_OBJECT)
 			{
-				if (path_table[i].index >= iterator->array.value_count)
-					return 0;
-				iterator = iterator->array.table[path_table[i].index];
+				component_table[i].index = (size_t)~0;
+				component_table[i].name_hash = jsonl_hash_name(name_length, path_table[i].name.value);
+				jsonl_copy_memory(name, path_table[i].name.value, name_length);
 			}
 			else
+			{
+				component_table[i].index = path_table[i].index;
+				component_table[i].name_hash = 0;
+			}
+			component_table[i].name_length = name_length;
+			component_table[i].name = name;
+			jsonl_terminator_string(name + name_length);
+		}
+	}
+	if (compiled_path_size <= compiled_path_buffer_size)
+	{
+		compiled_path_buffer->size = compiled_path_size;
+		compiled_path_buffer->path_length = path_length;
+		compiled_path_buffer->path_table = component_table;
+	}
+	return compiled_path_size;
+}
+
+size_t jsonl_compile_json_pointer(size_t json_pointer_length, const char* json_pointer, size_t compiled_path_buffer_size, jsonl_compiled_path_t* compiled_path_buffer)
+{
+	const char* end = json_pointer + json_pointer_length;
+	const char* read = json_pointer;
+	if (json_pointer_length && *json_pointer != '/')
+		return 0;
+	size_t path_length = 0;
+	for (size_t i = 0; i != json_pointer_length; ++i)
+		if (json_pointer[i] == '/')
+			++path_length;
+	size_t compiled_path_size = jsonl_round_size(sizeof(jsonl_compiled_path_t));
+	jsonl_compiled_path_component_t* component_table = (jsonl_compiled_path_component_t*)((uintptr_t)compiled_path_buffer + compiled_path_size);
+	compiled_path_size += jsonl_round_size(path_length * sizeof(jsonl_compiled_path_component_t));
+	for (size_t i = 0; i != path_length; ++i)
+	{
+		JSONL_ASSERT(read != end && *read == '/');
+		++read;
+		size_t token_size = 0;
+		while (read + token_size != end && read[token_size] != '/')
+			++token_size;
+		size_t name_length;
+		char* name = (char*)((uintptr_t)compiled_path_buffer + compiled_path_size);
+		if (!jsonl_decode_json_pointer_token(token_size, read, (compiled_path_size <= compiled_path_buffer_size) ? (compiled_path_buffer_size - compiled_path_size) : 0, name, &name_length))
+			return 0;
+		compiled_path_size += jsonl_round_size(name_length + 1);
+		if (compiled_path_size <= compiled_path_buffer_size)
+		{
+			component_table[i].container_type = 0;
+			component_table[i].index = jsonl_decode_array_index(token_size, read);
+			component_table[i].name_hash = jsonl_hash_name(name_length, name);
+			component_table[i].name_length = name_length;
+			component_table[i].name = name;
+			jsonl_terminator_string(name + name_length);
+		}
+		read += token_size;
+	}
+	if (compiled_path_size <= compiled_path_buffer_size)
+	{
+		compiled_path_buffer->size = compiled_path_size;
+		compiled_path_buffer->path_length = path_length;
+		compiled_path_buffer->path_table = component_table;
+	}
+	return compiled_path_size;
+}
+
+const jsonl_value_t* jsonl_get_value_compiled(const jsonl_value_t* parent_value, const jsonl_compiled_path_t* compiled_path, int required_value_type)
+{
+	const jsonl_value_t* iterator = parent_value;
+	for (size_t n = compiled_path->path_length, i = 0; i != n; ++i)
+	{
+		const jsonl_compiled_path_component_t* component = compiled_path->path_table + i;
+		if (iterator->type == JSONL_TYPE_OBJECT && component->container_type != JSONL_TYPE_ARRAY)
+		{
+			// Small objects have no stored member hashes, so they are searched by comparing the name lengths and then the names.
+			size_t child_index = iterator->object.index ?
+				jsonl_find_object_member_with_hash(iterator, component->name_length, component->name, component->name_hash) :
+				jsonl_find_object_member(iterator, component->name_length, component->name);
+			if (child_index == (size_t)~0)
+				return 0;
+			iterator = iterator->object.table[child_index].value;
+		}
+		else if (iterator->type == JSONL_TYPE_ARRAY && component->container_type != JSONL_TYPE_OBJECT)
+		{
+			if (component->index >= iterator->array.value_count)
 				return 0;
+			iterator = iterator->array.table[component->index];
 		}
 		else
 			return 0;
+	}
 	if (required_value_type && iterator->type != required_value_type)
 		return 0;
 	return iterator;
 }
 
 #ifdef JSONL_FIXED_POINT_NUMBER_FORMAT
-static size_t jsonl_print_number_value(const jsonl_value_t* number_value, size_t text_buffer_size, char* text_buffer)
+static size_t jsonl_print_number_value(const jsonl_number_value_t* number_value, size_t text_buffer_size, char* text_buffer)
 {
-	int sign_bit = number_value->number.sign ? 1 : 0;
-	uint64_t decimal_part = number_value->number.integer;
-	uint64_t fraction_part = number_value->number.fraction;
+	int sign_bit = number_value->sign ? 1 : 0;
+	uint64_t decimal_part = number_value->integer;
+	uint64_t fraction_part = number_value->fraction;
 
 	uint64_t decimal_shift = 1;
 	int decimal_count = 1;
-	while (decimal_count < 19 && decimal_part / (decimal_shift * 10))
+	while (decimal_count < 20 && decimal_part / (decimal_shift * 10))
 	{
 		++decimal_count;
 		decimal_shift *= 10;
@@ -1151,9 +2231,9 @@ static size_t jsonl_print_number_value(const jsonl_value_t* number_value, size_t
 	return (size_t)sign_bit + (size_t)decimal_count + (fraction_count ? (1 + (size_t)fraction_count) : 0);
 }
 #else
-static size_t jsonl_print_number_value(const jsonl_value_t* number_value, size_t text_buffer_size, char* text_buffer)
+static size_t jsonl_print_number_value(const jsonl_number_value_t* number_value, size_t text_buffer_size, char* text_buffer)
 {
-	double value = number_value->number.value;
+	double value = number_value->value;
 	int sign_bit = (int)(value < 0.0);
 	if (sign_bit)
 		value = -value;
@@ -1161,7 +2241,7 @@ static size_t jsonl_print_number_value(const jsonl_value_t* number_value, size_t
 	uint64_t decimal_part = (uint64_t)value;
 	uint64_t decimal_shift = 1;
 	int decimal_count = 1;
-	while (decimal_count < 19 && decimal_part / (decimal_shift * 10))
+	while (decimal_count < 20 && decimal_part / (decimal_shift * 10))
 	{
 		++decimal_count;
 		decimal_shift *= 10;
@@ -1211,73 +2291,162 @@ static size_t jsonl_print_number_value(const jsonl_value_t* number_value, size_t
 }
 #endif
 
-static size_t jsonl_print_string_value(size_t string_size, const char* string, size_t text_buffer_size, char* text_buffer)
+static size_t jsonl_print_escaped_string(size_t string_size, const char* string, char hex_letter_base, size_t text_buffer_size, char* text_buffer)
 {
-	static const struct { char character; char escaped; } escaped_character_table[] = {
-				{ '\"', '\"' },
-				{ '\\', '\\' },
-				{ '\b', 'b' },
-				{ '\f', 'f' },
-				{ '\n', 'n' },
-				{ '\r', 'r' },
-				{ '\t', 't' } };
-	if (text_buffer_size)
-		text_buffer[0] = '\"';
-	size_t printed_string_length = 0;
-	for (size_t i = 0; i != string_size; ++i)
+	// Zero for characters printed as is, 'u' for characters printed as \u00XX and the escape letter for the rest.
+	static const char escape_table[256] = {
+		'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+		'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+		0, 0, '\"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0 };
+	size_t printed_size = 0;
+	const char* read = string;
+	const char* end = string + string_size;
+	while (read != end)
 	{
-		char character = string[i];
-		int escaped_character_index = -1;
-		for (int j = 0; escaped_character_index == -1 && j != (int)(sizeof(escaped_character_table) / sizeof(*escaped_character_table)); ++j)
-			if (character == escaped_character_table[j].character)
-				escaped_character_index = j;
-		if (escaped_character_index == -1)
+		size_t remaining_size = (size_t)((uintptr_t)end - (uintptr_t)read);
+		if (remaining_size >= 16)
 		{
-			if (character < 0x20)
+			uint64_t low_word = jsonl_load_unaligned_64(read);
+			uint64_t high_word = jsonl_load_unaligned_64(read + 8);
+			if (!jsonl_word_needs_escape(low_word) && !jsonl_word_needs_escape(high_word))
 			{
-				if (printed_string_length + 5 < text_buffer_size)
+				if (printed_size + 16 <= text_buffer_size)
 				{
-					text_buffer[1 + printed_string_length] = '\\';
-					text_buffer[1 + printed_string_length + 1] = 'u';
-					text_buffer[1 + printed_string_length + 2] = '0';
-					text_buffer[1 + printed_string_length + 3] = '0';
-					text_buffer[1 + printed_string_length + 4] = (char)((int)'0' + ((int)character >> 4));
-					text_buffer[1 + printed_string_length + 5] = (((int)character & 0xF) < 0xA) ? (char)((int)'0' + ((int)character & 0xF)) : (char)(((int)'A' - 10) + ((int)character & 0xF));
+					jsonl_store_unaligned_64(text_buffer + printed_size, low_word);
+					jsonl_store_unaligned_64(text_buffer + printed_size + 8, high_word);
 				}
-				printed_string_length += 6;
+				printed_size += 16;
+				read += 16;
+				continue;
 			}
-			else
+		}
+		else if (remaining_size >= 8)
+		{
+			uint64_t word = jsonl_load_unaligned_64(read);
+			if (!jsonl_word_needs_escape(word))
 			{
-				if (printed_string_length < text_buffer_size)
-					text_buffer[1 + printed_string_length] = character;
-				++printed_string_length;
+				if (printed_size + 8 <= text_buffer_size)
+					jsonl_store_unaligned_64(text_buffer + printed_size, word);
+				printed_size += 8;
+				read += 8;
+				continue;
 			}
 		}
-		else
+
+		// Print characters one at a time until the end of the block that needs escaping.
+		const char* block_end = read + ((remaining_size < 8) ? remaining_size : 8);
+		while (read != block_end)
 		{
-			if (printed_string_length + 1 < text_buffer_size)
+			uint8_t character = (uint8_t)*read++;
+			char escaped = escape_table[character];
+			if (!escaped)
+			{
+				if (printed_size < text_buffer_size)
+					text_buffer[printed_size] = (char)character;
+				printed_size += 1;
+			}
+			else if (escaped != 'u')
+			{
+				if (printed_size + 2 <= text_buffer_size)
+				{
+					text_buffer[printed_size] = '\\';
+					text_buffer[printed_size + 1] = escaped;
+				}
+				printed_size += 2;
+			}
+			else
 			{
-				text_buffer[1 + printed_string_length] = '\\';
-				text_buffer[1 + printed_string_length + 1] = escaped_character_table[escaped_character_index].character;
+				if (printed_size + 6 <= text_buffer_size)
+				{
+					text_buffer[printed_size] = '\\';
+					text_buffer[printed_size + 1] = 'u';
+					text_buffer[printed_size + 2] = '0';
+					text_buffer[printed_size + 3] = '0';
+					text_buffer[printed_size + 4] = (char)('0' + (character >> 4));
+					text_buffer[printed_size + 5] = ((character & 0xF) < 0xA) ? (char)('0' + (character & 0xF)) : (char)((hex_letter_base - 10) + (character & 0xF));
+				}
+				printed_size += 6;
 			}
-			printed_string_length += 2;
 		}
 	}
-	if (1 + printed_string_length < text_buffer_size)
-		text_buffer[1 + printed_string_length] = '\"';
-	return 2 + printed_string_length;
+	return printed_size;
 }
 
-static void jsonl_print_indent(char* text_buffer, size_t depth)
+static size_t jsonl_print_string_value(size_t string_size, const char* string, char hex_letter_base, size_t text_buffer_size, char* text_buffer)
 {
-	for (char* end = text_buffer + depth; text_buffer != end; ++text_buffer)
-		*text_buffer = '\t';
+	if (text_buffer_size)
+		text_buffer[0] = '\"';
+	size_t printed_size = 1 + jsonl_print_escaped_string(string_size, string, hex_letter_base, text_buffer_size ? (text_buffer_size - 1) : 0, text_buffer + 1);
+	if (printed_size < text_buffer_size)
+		text_buffer[printed_size] = '\"';
+	return printed_size + 1;
 }
 
-static size_t jsonl_internal_print(const jsonl_value_t* value_tree, size_t json_text_buffer_size, char* json_text_buffer, size_t depth)
+static void jsonl_print_indent(char* text_buffer, size_t indent_length, char indent_character)
 {
-	switch (value_tree->type)
-	{
+	for (char* end = text_buffer + indent_length; text_buffer != end; ++text_buffer)
+		*text_buffer = indent_character;
+}
+
+static size_t jsonl_print_scalar_value(const jsonl_value_t* value_tree, size_t json_text_buffer_size, char* json_text_buffer)
+{
+	switch (value_tree->type)
+	{
+		case JSONL_TYPE_STRING:
+			return jsonl_print_string_value(value_tree->string.length, value_tree->string.value, 'A', json_text_buffer_size, json_text_buffer);
+		case JSONL_TYPE_NUMBER:
+			return jsonl_print_number_value(&value_tree->number, json_text_buffer_size, json_text_buffer);
+		case JSONL_TYPE_BOOLEAN:
+		{
+			if (value_tree->boolean.value)
+			{
+				if (json_text_buffer_size > 3)
+				{
+					json_text_buffer[0] = 't';
+					json_text_buffer[1] = 'r';
+					json_text_buffer[2] = 'u';
+					json_text_buffer[3] = 'e';
+				}
+				return 4;
+			}
+			else
+			{
+				if (json_text_buffer_size > 4)
+				{
+					json_text_buffer[0] = 'f';
+					json_text_buffer[1] = 'a';
+					json_text_buffer[2] = 'l';
+					json_text_buffer[3] = 's';
+					json_text_buffer[4] = 'e';
+				}
+				return 5;
+			}
+		}
+		case JSONL_TYPE_NULL:
+		{
+			if (json_text_buffer_size > 3)
+			{
+				json_text_buffer[0] = 'n';
+				json_text_buffer[1] = 'u';
+				json_text_buffer[2] = 'l';
+				json_text_buffer[3] = 'l';
+			}
+			return 4;
+		}
+		default:
+			return 0;
+	}
+}
+
+static size_t jsonl_internal_print(const jsonl_value_t* value_tree, size_t json_text_buffer_size, char* json_text_buffer, size_t depth, const jsonl_print_options_t* options)
+{
+	size_t indent_length = depth * options->indent_width;
+	size_t child_indent_length = indent_length + options->indent_width;
+	switch (value_tree->type)
+	{
 		case JSONL_TYPE_OBJECT:
 		{
 			if (1 < json_text_buffer_size)
@@ -1288,10 +2457,10 @@ static size_t jsonl_internal_print(const jsonl_value_t* value_tree, size_t json_
 			size_t object_size = 2;
 			for (size_t i = 0; i != value_tree->object.value_count; ++i)
 			{
-				if (object_size + 1 < json_text_buffer_size)
-					jsonl_print_indent(json_text_buffer + object_size, depth + 1);
-				object_size += depth + 1;
-				object_size += jsonl_print_string_value(value_tree->object.table[i].name_length, value_tree->object.table[i].name, (object_size < json_text_buffer_size) ? (json_text_buffer_size - object_size) : 0, json_text_buffer + object_size);
+				if (object_size + child_indent_length <= json_text_buffer_size)
+					jsonl_print_indent(json_text_buffer + object_size, child_indent_length, options->indent_character);
+				object_size += child_indent_length;
+				object_size += jsonl_print_string_value(value_tree->object.table[i].name_length, value_tree->object.table[i].name, 'A', (object_size < json_text_buffer_size) ? (json_text_buffer_size - object_size) : 0, json_text_buffer + object_size);
 				if (object_size + 2 < json_text_buffer_size)
 				{
 					json_text_buffer[object_size] = ' ';
@@ -1299,7 +2468,7 @@ static size_t jsonl_internal_print(const jsonl_value_t* value_tree, size_t json_
 					json_text_buffer[object_size + 2] = ' ';
 				}
 				object_size += 3;
-				size_t child_value_size = jsonl_internal_print(value_tree->object.table[i].value, (object_size < json_text_buffer_size) ? (json_text_buffer_size - object_size) : 0, json_text_buffer + object_size, depth + 1);
+				size_t child_value_size = jsonl_internal_print(value_tree->object.table[i].value, (object_size < json_text_buffer_size) ? (json_text_buffer_size - object_size) : 0, json_text_buffer + object_size, depth + 1, options);
 				if (!child_value_size)
 					return 0;
 				object_size += child_value_size;
@@ -1313,12 +2482,12 @@ static size_t jsonl_internal_print(const jsonl_value_t* value_tree, size_t json_
 					json_text_buffer[object_size] = '\n';
 				++object_size;
 			}
-			if (object_size + depth < json_text_buffer_size)
+			if (object_size + indent_length < json_text_buffer_size)
 			{
-				jsonl_print_indent(json_text_buffer + object_size, depth);
-				json_text_buffer[object_size + depth] = '}';
+				jsonl_print_indent(json_text_buffer + object_size, indent_length, options->indent_character);
+				json_text_buffer[object_size + indent_length] = '}';
 			}
-			object_size += depth + 1;
+			object_size += indent_length + 1;
 			return object_size;
 		}
 		case JSONL_TYPE_ARRAY:
@@ -1331,10 +2500,10 @@ static size_t jsonl_internal_print(const jsonl_value_t* value_tree, size_t json_
 			size_t array_size = 2;
 			for (size_t i = 0; i != value_tree->array.value_count; ++i)
 			{
-				if (array_size + 1 < json_text_buffer_size)
-					jsonl_print_indent(json_text_buffer + array_size, depth + 1);
-				array_size += depth + 1;
-				size_t child_value_size = jsonl_internal_print(value_tree->array.table[i], (array_size < json_text_buffer_size) ? (json_text_buffer_size - array_size) : 0, json_text_buffer + array_size, depth + 1);
+				if (array_size + child_indent_length <= json_text_buffer_size)
+					jsonl_print_indent(json_text_buffer + array_size, child_indent_length, options->indent_character);
+				array_size += child_indent_length;
+				size_t child_value_size = jsonl_internal_print(value_tree->array.table[i], (array_size < json_text_buffer_size) ? (json_text_buffer_size - array_size) : 0, json_text_buffer + array_size, depth + 1, options);
 				if (!child_value_size)
 					return 0;
 				array_size += child_value_size;
@@ -1348,1013 +2517,3973 @@ static size_t jsonl_internal_print(const jsonl_value_t* value_tree, size_t json_
 					json_text_buffer[array_size] = '\n';
 				++array_size;
 			}
-			if (array_size + depth < json_text_buffer_size)
+			if (array_size + indent_length < json_text_buffer_size)
 			{
-				jsonl_print_indent(json_text_buffer + array_size, depth);
-				json_text_buffer[array_size + depth] = ']';
+				jsonl_print_indent(json_text_buffer + array_size, indent_length, options->indent_character);
+				json_text_buffer[array_size + indent_length] = ']';
 			}
-			array_size += depth + 1;
+			array_size += indent_length + 1;
 			return array_size;
 		}
-		case JSONL_TYPE_STRING:
-			return jsonl_print_string_value(value_tree->string.length, value_tree->string.value, json_text_buffer_size, json_text_buffer);
-		case JSONL_TYPE_NUMBER:
-			return jsonl_print_number_value(value_tree, json_text_buffer_size, json_text_buffer);
-		case JSONL_TYPE_BOOLEAN:
+		default:
+			return jsonl_print_scalar_value(value_tree, json_text_buffer_size, json_text_buffer);
+	}
+}
+
+static size_t jsonl_internal_print_compact(const jsonl_value_t* value_tree, size_t json_text_buffer_size, char* json_text_buffer)
+{
+	switch (value_tree->type)
+	{
+		case JSONL_TYPE_OBJECT:
 		{
-			if (value_tree->boolean.value)
-			{
-				if (json_text_buffer_size > 3)
-				{
-					json_text_buffer[0] = 't';
-					json_text_buffer[1] = 'r';
-					json_text_buffer[2] = 'u';
-					json_text_buffer[3] = 'e';
-				}
-				return 4;
-			}
-			else
+			if (json_text_buffer_size)
+				json_text_buffer[0] = '{';
+			size_t object_size = 1;
+			for (size_t i = 0; i != value_tree->object.value_count; ++i)
 			{
-				if (json_text_buffer_size > 4)
+				if (i)
 				{
-					json_text_buffer[0] = 'f';
-					json_text_buffer[1] = 'a';
-					json_text_buffer[2] = 'l';
-					json_text_buffer[3] = 's';
-					json_text_buffer[4] = 'e';
+					if (object_size < json_text_buffer_size)
+						json_text_buffer[object_size] = ',';
+					++object_size;
 				}
-				return 5;
+				object_size += jsonl_print_string_value(value_tree->object.table[i].name_length, value_tree->object.table[i].name, 'A', (object_size < json_text_buffer_size) ? (json_text_buffer_size - object_size) : 0, json_text_buffer + object_size);
+				if (object_size < json_text_buffer_size)
+					json_text_buffer[object_size] = ':';
+				++object_size;
+				size_t child_value_size = jsonl_internal_print_compact(value_tree->object.table[i].value, (object_size < json_text_buffer_size) ? (json_text_buffer_size - object_size) : 0, json_text_buffer + object_size);
+				if (!child_value_size)
+					return 0;
+				object_size += child_value_size;
 			}
+			if (object_size < json_text_buffer_size)
+				json_text_buffer[object_size] = '}';
+			return object_size + 1;
 		}
-		case JSONL_TYPE_NULL:
+		case JSONL_TYPE_ARRAY:
 		{
-			if (json_text_buffer_size > 3)
+			if (json_text_buffer_size)
+				json_text_buffer[0] = '[';
+			size_t array_size = 1;
+			for (size_t i = 0; i != value_tree->array.value_count; ++i)
 			{
-				json_text_buffer[0] = 'n';
-				json_text_buffer[1] = 'u';
-				json_text_buffer[2] = 'l';
-				json_text_buffer[3] = 'l';
+				if (i)
+				{
+					if (array_size < json_text_buffer_size)
+						json_text_buffer[array_size] = ',';
+					++array_size;
+				}
+				size_t child_value_size = jsonl_internal_print_compact(value_tree->array.table[i], (array_size < json_text_buffer_size) ? (json_text_buffer_size - array_size) : 0, json_text_buffer + array_size);
+				if (!child_value_size)
+					return 0;
+				array_size += child_value_size;
 			}
-			return 4;
+			if (array_size < json_text_buffer_size)
+				json_text_buffer[array_size] = ']';
+			return array_size + 1;
 		}
 		default:
-			return 0;
+			return jsonl_print_scalar_value(value_tree, json_text_buffer_size, json_text_buffer);
 	}
 }
 
-size_t jsonl_print(const jsonl_value_t* value_tree, size_t json_text_buffer_size, char* json_text_buffer)
+static void jsonl_big_number_set(jsonl_internal_big_number_t* number, uint64_t value)
 {
-	return jsonl_internal_print(value_tree, json_text_buffer_size, json_text_buffer, 0);
+	number->word_count = 0;
+	while (value)
+	{
+		number->word_table[number->word_count++] = (uint32_t)value;
+		value >>= 32;
+	}
 }
 
-static size_t jsonl_internal_create_null_value(const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer)
+static void jsonl_big_number_multiply(jsonl_internal_big_number_t* number, uint32_t factor)
 {
-	size_t null_object_size = jsonl_round_size(sizeof(jsonl_value_t));
-	if (null_object_size <= value_buffer_size)
+	uint64_t carry = 0;
+	for (size_t i = 0; i != number->word_count; ++i)
 	{
-		value_buffer->size = null_object_size;
-		value_buffer->parent = (jsonl_value_t*)parent;
-		value_buffer->type = JSONL_TYPE_NULL;
+		carry += (uint64_t)number->word_table[i] * (uint64_t)factor;
+		number->word_table[i] = (uint32_t)carry;
+		carry >>= 32;
 	}
-	return null_object_size;
+	if (carry)
+		number->word_table[number->word_count++] = (uint32_t)carry;
 }
 
-static size_t jsonl_internal_copy_value(const jsonl_value_t* value, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer)
+static void jsonl_big_number_multiply_power_of_ten(jsonl_internal_big_number_t* number, int exponent)
 {
-	size_t object_size = jsonl_round_size(sizeof(jsonl_value_t));
-	switch (value->type)
+	static const uint32_t power_of_ten_table[9] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+	for (; exponent >= 9; exponent -= 9)
+		jsonl_big_number_multiply(number, 1000000000);
+	jsonl_big_number_multiply(number, power_of_ten_table[exponent]);
+}
+
+static void jsonl_big_number_shift_left(jsonl_internal_big_number_t* number, size_t shift)
+{
+	size_t word_count = number->word_count;
+	if (!word_count)
+		return;
+	uint32_t* word_table = number->word_table;
+	size_t word_shift = shift >> 5;
+	unsigned int bit_shift = (unsigned int)(shift & 31);
+	if (bit_shift)
 	{
-		case JSONL_TYPE_OBJECT:
-		{
-			size_t object_table_size = jsonl_round_size(value->object.value_count * sizeof(*value->object.table));
-			if (object_size <= value_buffer_size)
-			{
-				value_buffer->object.value_count = value->object.value_count;
-				*(void**)&value_buffer->object.table = (void*)((uintptr_t)value_buffer + object_size);
-			}
-			for (size_t i = 0; i != value->object.value_count; ++i)
-			{
-				size_t name_size = jsonl_round_size(value->object.table[i].name_length + 1);
-				if (object_size + object_table_size + name_size <= value_buffer_size)
-				{
-					value_buffer->object.table[i].name_length = value->object.table[i].name_length;
-					value_buffer->object.table[i].name = (char*)((uintptr_t)value_buffer + object_size + object_table_size);
-					jsonl_copy_memory((void*)((uintptr_t)value_buffer + object_size + object_table_size), value->object.table[i].name, value->object.table[i].name_length + 1);
-				}
-				object_table_size += name_size;
-			}
-			object_size += object_table_size;
-			for (size_t i = 0; i != value->object.value_count; ++i)
-			{
-				if (object_size <= value_buffer_size)
-					value_buffer->object.table[i].value = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-				size_t remaining_buffer_size = object_size < value_buffer_size ? value_buffer_size - object_size : 0;
-				size_t sub_value_size = jsonl_internal_copy_value(value->object.table[i].value, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
-				if (!sub_value_size)
-					return 0;
-				object_size += sub_value_size;
-			}
-			break;
-		}
-		case JSONL_TYPE_ARRAY:
-		{
-			size_t array_table_size = jsonl_round_size(value->array.value_count * sizeof(jsonl_value_t*));
-			if (object_size <= value_buffer_size)
-			{
-				value_buffer->array.value_count = value->array.value_count;
-				*(void**)&value_buffer->array.table = (void*)((uintptr_t)value_buffer + object_size);
-			}
-			object_size += array_table_size;
-			for (size_t i = 0; i != value->array.value_count; ++i)
-			{
-				if (object_size <= value_buffer_size)
-					value_buffer->array.table[i] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-				size_t remaining_buffer_size = object_size < value_buffer_size ? value_buffer_size - object_size : 0;
-				size_t sub_value_size = jsonl_internal_copy_value(value->array.table[i], value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
-				if (!sub_value_size)
-					return 0;
-				object_size += sub_value_size;
-			}
-			break;
-		}
-		case JSONL_TYPE_STRING:
-		{
-			size_t data_size = jsonl_round_size(value->string.length + 1);
-			if (object_size + data_size <= value_buffer_size)
-			{
-				value_buffer->string.length = value->string.length;
-				value_buffer->string.value = (char*)((uintptr_t)value_buffer + object_size);
-				jsonl_copy_memory((char*)((uintptr_t)value_buffer + object_size), value->string.value, value->string.length + 1);
-			}
-			object_size += data_size;
-			break;
-		}
-		case JSONL_TYPE_NUMBER:
-		{
-			if (object_size <= value_buffer_size)
-			{
-#ifdef JSONL_FIXED_POINT_NUMBER_FORMAT
-				value_buffer->number.sign = value->number.sign;
-				value_buffer->number.integer = value->number.integer;
-				value_buffer->number.fraction = value->number.fraction;
-#else
-				value_buffer->number.value = value->number.value;
-#endif
-			}
-			break;
-		}
-		case JSONL_TYPE_BOOLEAN:
-		{
-			if (object_size <= value_buffer_size)
-				value_buffer->boolean.value = value->boolean.value;
-			break;
-		}
-		case JSONL_TYPE_NULL:
-		{
-			break;
-		}
-		default:
-			return 0;
+		word_table[word_count + word_shift] = word_table[word_count - 1] >> (32 - bit_shift);
+		for (size_t i = word_count - 1; i; --i)
+			word_table[i + word_shift] = (word_table[i] << bit_shift) | (word_table[i - 1] >> (32 - bit_shift));
+		word_table[word_shift] = word_table[0] << bit_shift;
+		word_count += word_shift + 1;
+		if (!word_table[word_count - 1])
+			--word_count;
 	}
-
-	if (object_size <= value_buffer_size)
+	else
 	{
-		value_buffer->size = object_size;
-		value_buffer->parent = (jsonl_value_t*)parent;
-		value_buffer->type = value->type;
+		for (size_t i = word_count; i--;)
+			word_table[i + word_shift] = word_table[i];
+		word_count += word_shift;
 	}
-	return object_size;
+	for (size_t i = 0; i != word_shift; ++i)
+		word_table[i] = 0;
+	number->word_count = word_count;
 }
 
-static int jsonl_internal_set_values_create_path_contains_second_path(size_t path_index, const jsonl_set_value_t* set_value_table, size_t depth, size_t second_path_index)
+static void jsonl_big_number_add(const jsonl_internal_big_number_t* number_a, const jsonl_internal_big_number_t* number_b, jsonl_internal_big_number_t* sum)
 {
-	if (path_index == second_path_index)
-		return 1;
-	int path_contains_this = set_value_table[path_index].path_length >= depth + 1 && set_value_table[second_path_index].path_length >= depth + 1;
-	for (size_t i = 0; path_contains_this && i != depth; ++i)
+	if (number_a->word_count < number_b->word_count)
 	{
-		if (set_value_table[path_index].path[i].container_type == set_value_table[second_path_index].path[i].container_type)
-		{
-			if (set_value_table[path_index].path[i].container_type == JSONL_TYPE_OBJECT)
-			{
-				if (set_value_table[path_index].path[i].name.length != set_value_table[second_path_index].path[i].name.length || !jsonl_memory_compare(set_value_table[path_index].path[i].name.value, set_value_table[second_path_index].path[i].name.value, set_value_table[path_index].path[i].name.length))
-					path_contains_this = 0;
-			}
-			else if (set_value_table[path_index].path[i].container_type == JSONL_TYPE_ARRAY)
-			{
-				if (set_value_table[path_index].path[i].index == (size_t)~0)
-					return 0;
-				if (set_value_table[path_index].path[i].index != set_value_table[second_path_index].path[i].index)
-					path_contains_this = 0;
-			}
-			else
-				JSONL_ASSERT(0);
-		}
-		else
-			path_contains_this = 0;
+		const jsonl_internal_big_number_t* swap = number_a;
+		number_a = number_b;
+		number_b = swap;
+	}
+	uint64_t carry = 0;
+	for (size_t i = 0; i != number_a->word_count; ++i)
+	{
+		carry += (uint64_t)number_a->word_table[i] + ((i < number_b->word_count) ? (uint64_t)number_b->word_table[i] : 0);
+		sum->word_table[i] = (uint32_t)carry;
+		carry >>= 32;
 	}
-	return path_contains_this;
+	sum->word_count = number_a->word_count;
+	if (carry)
+		sum->word_table[sum->word_count++] = (uint32_t)carry;
 }
 
-static int jsonl_internal_set_values_create_path_sub_path_not_already_listed(size_t set_value_index, const jsonl_set_value_t* set_value_table, size_t depth)
+static void jsonl_big_number_subtract(jsonl_internal_big_number_t* number, const jsonl_internal_big_number_t* subtrahend)
 {
-	int not_already_listed = 1;
-	for (size_t i = 0; not_already_listed && i != set_value_index; ++i)
+	uint64_t borrow = 0;
+	for (size_t i = 0; i != number->word_count; ++i)
 	{
-		if (set_value_table[i].value && set_value_table[i].path_length > depth && set_value_table[set_value_index].path[depth].container_type == set_value_table[i].path[depth].container_type)
-		{
-			JSONL_ASSERT(set_value_table[set_value_index].value && set_value_table[i].value);
-			JSONL_ASSERT(set_value_table[set_value_index].path_length > depth && set_value_table[i].path_length > depth);
-			if (set_value_table[set_value_index].path[depth].container_type == JSONL_TYPE_OBJECT)
-			{
-				if (set_value_table[set_value_index].path[depth].name.length == set_value_table[i].path[depth].name.length && jsonl_memory_compare(set_value_table[set_value_index].path[depth].name.value, set_value_table[i].path[depth].name.value, set_value_table[set_value_index].path[depth].name.length))
-					not_already_listed = 0;
-			}
-			else if (set_value_table[set_value_index].path[depth].container_type == JSONL_TYPE_ARRAY)
-			{
-				if (set_value_table[set_value_index].path[depth].index == (size_t)~0)
-					return 1;
-				if (set_value_table[set_value_index].path[depth].index == set_value_table[i].path[depth].index)
-					not_already_listed = 0;
-			}
-			else
-				JSONL_ASSERT(0);
-		}
+		uint64_t difference = (uint64_t)number->word_table[i] - ((i < subtrahend->word_count) ? (uint64_t)subtrahend->word_table[i] : 0) - borrow;
+		number->word_table[i] = (uint32_t)difference;
+		borrow = difference >> 63;
 	}
-	return not_already_listed;
+	while (number->word_count && !number->word_table[number->word_count - 1])
+		--number->word_count;
 }
 
-static size_t jsonl_internal_set_values_create_path(size_t path_index, size_t set_value_count, const jsonl_set_value_t* set_value_table, size_t value_buffer_size, jsonl_value_t* value_buffer, size_t depth, const jsonl_value_t* parent)
+static int jsonl_big_number_compare(const jsonl_internal_big_number_t* number_a, const jsonl_internal_big_number_t* number_b)
 {
-	JSONL_ASSERT(set_value_table[path_index].value && set_value_table[path_index].path_length > depth && set_value_table[path_index].path[depth].container_type == JSONL_TYPE_OBJECT || set_value_table[path_index].path[depth].container_type == JSONL_TYPE_ARRAY);
+	if (number_a->word_count != number_b->word_count)
+		return (number_a->word_count < number_b->word_count) ? -1 : 1;
+	for (size_t i = number_a->word_count; i--;)
+		if (number_a->word_table[i] != number_b->word_table[i])
+			return (number_a->word_table[i] < number_b->word_table[i]) ? -1 : 1;
+	return 0;
+}
 
-	size_t value_count = 0;
-	size_t path_count = 0;
-	size_t sub_value_count = 0;
-	size_t append_offset = 0;
-	size_t append_count = 0;
-	for (size_t i = 0; i != set_value_count; ++i)
-		if (set_value_table[i].value && jsonl_internal_set_values_create_path_contains_second_path(path_index, set_value_table, depth, i))
-		{
-			JSONL_ASSERT(set_value_table[i].path_length > depth);
-			if (set_value_table[i].path_length > depth + 1)
-			{
-				if (jsonl_internal_set_values_create_path_sub_path_not_already_listed(i, set_value_table, depth))
-				{
-					if (set_value_table[path_index].path[depth].container_type == JSONL_TYPE_ARRAY)
-					{
-						if (set_value_table[i].path[depth].index == (size_t)~0)
-							++append_count;
-						else if (set_value_table[i].path[depth].index + 1 > sub_value_count)
-							append_offset = set_value_table[i].path[depth].index + 1;
-					}
-					++path_count;
-				}
-			}
-			else
-			{
-				if (set_value_table[path_index].path[depth].container_type == JSONL_TYPE_ARRAY)
-				{
-					if (set_value_table[i].path[depth].index == (size_t)~0)
-						++append_count;
-					else if (set_value_table[i].path[depth].index + 1 > sub_value_count)
-						append_offset = set_value_table[i].path[depth].index + 1;
-				}
-				++value_count;
-			}
-		}
-	if (set_value_table[path_index].path[depth].container_type == JSONL_TYPE_OBJECT)
-		sub_value_count = value_count + path_count;
-	else if (set_value_table[path_index].path[depth].container_type == JSONL_TYPE_ARRAY)
-		sub_value_count = append_offset + append_count;
+static size_t jsonl_print_shortest_number(int sign, uint64_t mantissa, int exponent, size_t text_buffer_size, char* text_buffer)
+{
+	// Free-format digit generation of Steele and White with exact integers. The value is remainder / scale
+	// and the margins are distances to the midpoints between the value and its neighbouring doubles.
+	jsonl_internal_big_number_t remainder;
+	jsonl_internal_big_number_t scale;
+	jsonl_internal_big_number_t high_margin;
+	jsonl_internal_big_number_t low_margin;
+	jsonl_internal_big_number_t sum;
+	int even = !(mantissa & 1);
+	int unequal_margins = mantissa == ((uint64_t)1 << 52) && exponent > -1074;
+	size_t margin_shift = unequal_margins ? 2 : 1;
+	jsonl_big_number_set(&remainder, mantissa);
+	jsonl_big_number_set(&scale, 1);
+	jsonl_big_number_set(&high_margin, unequal_margins ? 2 : 1);
+	jsonl_big_number_set(&low_margin, 1);
+	jsonl_big_number_shift_left(&remainder, margin_shift);
+	jsonl_big_number_shift_left(&scale, margin_shift);
+	if (exponent >= 0)
+	{
+		jsonl_big_number_shift_left(&remainder, (size_t)exponent);
+		jsonl_big_number_shift_left(&high_margin, (size_t)exponent);
+		jsonl_big_number_shift_left(&low_margin, (size_t)exponent);
+	}
 	else
-		JSONL_ASSERT(0);
+		jsonl_big_number_shift_left(&scale, (size_t)-exponent);
 
-	JSONL_ASSERT(sub_value_count > 0);
-	JSONL_ASSERT(value_count + path_count > 0);
+	// The estimate of the decimal exponent is never too large and is corrected upwards.
+	int highest_bit = exponent;
+	for (uint64_t bits = mantissa >> 1; bits; bits >>= 1)
+		++highest_bit;
+	int decimal_exponent = (highest_bit >= 0) ? ((highest_bit * 78913) >> 18) : -((-highest_bit * 78913 + 262143) >> 18);
+	if (decimal_exponent >= 0)
+		jsonl_big_number_multiply_power_of_ten(&scale, decimal_exponent);
+	else
+	{
+		jsonl_big_number_multiply_power_of_ten(&remainder, -decimal_exponent);
+		jsonl_big_number_multiply_power_of_ten(&high_margin, -decimal_exponent);
+		jsonl_big_number_multiply_power_of_ten(&low_margin, -decimal_exponent);
+	}
+	for (;;)
+	{
+		jsonl_big_number_add(&remainder, &high_margin, &sum);
+		int compare_high = jsonl_big_number_compare(&sum, &scale);
+		if (even ? (compare_high < 0) : (compare_high <= 0))
+			break;
+		jsonl_big_number_multiply(&scale, 10);
+		++decimal_exponent;
+	}
 
-	size_t object_size = jsonl_round_size(sizeof(jsonl_value_t));
-	if (set_value_table[path_index].path[depth].container_type == JSONL_TYPE_OBJECT)
+	char digit_table[24];
+	int digit_count = 0;
+	for (;;)
 	{
-		size_t object_table_size = jsonl_round_size(sub_value_count * sizeof(*value_buffer->object.table));
-		if (object_size <= value_buffer_size)
+		jsonl_big_number_multiply(&remainder, 10);
+		jsonl_big_number_multiply(&high_margin, 10);
+		jsonl_big_number_multiply(&low_margin, 10);
+		int digit = 0;
+		while (jsonl_big_number_compare(&remainder, &scale) >= 0)
 		{
-			value_buffer->object.value_count = sub_value_count;
-			*(void**)&value_buffer->object.table = (void*)((uintptr_t)value_buffer + object_size);
+			jsonl_big_number_subtract(&remainder, &scale);
+			++digit;
 		}
-		for (size_t c = 0, i = 0; c != sub_value_count; ++i)
+		int compare_low = jsonl_big_number_compare(&remainder, &low_margin);
+		jsonl_big_number_add(&remainder, &high_margin, &sum);
+		int compare_high = jsonl_big_number_compare(&sum, &scale);
+		int low_reached = even ? (compare_low <= 0) : (compare_low < 0);
+		int high_reached = even ? (compare_high >= 0) : (compare_high > 0);
+		if (low_reached || high_reached)
 		{
-			JSONL_ASSERT(i < set_value_count);
-			if (set_value_table[i].value && jsonl_internal_set_values_create_path_contains_second_path(path_index, set_value_table, depth, i) && ((set_value_table[i].path_length + 1) == depth || jsonl_internal_set_values_create_path_sub_path_not_already_listed(i, set_value_table, depth)))
+			if (high_reached && low_reached)
 			{
-				JSONL_ASSERT(set_value_table[i].path_length > depth);
-				JSONL_ASSERT(set_value_table[i].path[depth].container_type == JSONL_TYPE_OBJECT);
-				size_t name_length = set_value_table[i].path[depth].name.length;
-				size_t name_size = jsonl_round_size(name_length + 1);
-				if (object_size + object_table_size + name_size <= value_buffer_size)
-				{
-					value_buffer->object.table[c].name_length = name_length;
-					value_buffer->object.table[c].name = (char*)((uintptr_t)value_buffer + object_size + object_table_size);
-					jsonl_copy_memory((void*)((uintptr_t)value_buffer + object_size + object_table_size), set_value_table[i].path[depth].name.value, name_length + 1);
-				}
-				object_table_size += name_size;
-				++c;
+				// Both last digits are within the rounding interval, the closer one is chosen and ties go to the even digit.
+				jsonl_big_number_shift_left(&remainder, 1);
+				int compare_half = jsonl_big_number_compare(&remainder, &scale);
+				if (compare_half > 0 || (!compare_half && (digit & 1)))
+					++digit;
 			}
+			else if (high_reached)
+				++digit;
+			JSONL_ASSERT(digit < 10);
+			digit_table[digit_count++] = (char)('0' + digit);
+			break;
 		}
-		object_size += object_table_size;
-		for (size_t c = 0, i = 0; c != sub_value_count; ++i)
-		{
-			JSONL_ASSERT(i < set_value_count);
-			if (set_value_table[i].value && jsonl_internal_set_values_create_path_contains_second_path(path_index, set_value_table, depth, i))
-				if (set_value_table[i].path_length > depth + 1)
-				{
-					if (jsonl_internal_set_values_create_path_sub_path_not_already_listed(i, set_value_table, depth))
-					{
-						if (object_size <= value_buffer_size)
-							value_buffer->object.table[c].value = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-						size_t remaining_buffer_size = object_size < value_buffer_size ? value_buffer_size - object_size : 0;
-						size_t sub_value_size = jsonl_internal_set_values_create_path(i, set_value_count, set_value_table, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size), depth + 1, value_buffer);
-						if (!sub_value_size)
-							return 0;
-						object_size += sub_value_size;
-						++c;
-					}
-				}
-				else
-				{
-					if (object_size <= value_buffer_size)
-						value_buffer->object.table[c].value = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-					size_t remaining_buffer_size = object_size < value_buffer_size ? value_buffer_size - object_size : 0;
-					size_t sub_value_size = jsonl_internal_copy_value(set_value_table[i].value, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
-					if (!sub_value_size)
-						return 0;
-					object_size += sub_value_size;
-					++c;
-				}
-		}
+		digit_table[digit_count++] = (char)('0' + digit);
 	}
-	else if (set_value_table[path_index].path[depth].container_type == JSONL_TYPE_ARRAY)
+
+	// The value is 0.digits * 10^decimal_exponent, the notation follows Number.prototype.toString of ECMAScript.
+	char text[32];
+	size_t text_length = 0;
+	if (sign)
+		text[text_length++] = '-';
+	if (digit_count <= decimal_exponent && decimal_exponent <= 21)
 	{
-		size_t array_table_size = jsonl_round_size(sub_value_count * sizeof(jsonl_value_t*));
-		if (object_size <= value_buffer_size)
+		for (int i = 0; i != digit_count; ++i)
+			text[text_length++] = digit_table[i];
+		for (int i = digit_count; i != decimal_exponent; ++i)
+			text[text_length++] = '0';
+	}
+	else if (0 < decimal_exponent && decimal_exponent <= 21)
+	{
+		for (int i = 0; i != digit_count; ++i)
 		{
-			value_buffer->array.value_count = sub_value_count;
-			*(void**)&value_buffer->array.table = (void*)((uintptr_t)value_buffer + object_size);
-			if ((object_size + array_table_size) <= value_buffer_size)
-				for (size_t i = 0; i != sub_value_count; ++i)
-					value_buffer->array.table[i] = 0;
+			if (i == decimal_exponent)
+				text[text_length++] = '.';
+			text[text_length++] = digit_table[i];
 		}
-		object_size += array_table_size;
-		for (size_t n = value_count + path_count, c = 0, i = 0; c != n; ++i)
+	}
+	else if (-6 < decimal_exponent && decimal_exponent <= 0)
+	{
+		text[text_length++] = '0';
+		text[text_length++] = '.';
+		for (int i = decimal_exponent; i; ++i)
+			text[text_length++] = '0';
+		for (int i = 0; i != digit_count; ++i)
+			text[text_length++] = digit_table[i];
+	}
+	else
+	{
+		text[text_length++] = digit_table[0];
+		if (digit_count > 1)
 		{
-			JSONL_ASSERT(i < set_value_count);
-			if (set_value_table[i].value && jsonl_internal_set_values_create_path_contains_second_path(path_index, set_value_table, depth, i))
-				if (set_value_table[i].path_length > depth + 1)
-				{
-					if (jsonl_internal_set_values_create_path_sub_path_not_already_listed(i, set_value_table, depth))
-					{
-						JSONL_ASSERT(set_value_table[i].path[depth].container_type == JSONL_TYPE_ARRAY && (set_value_table[i].path[depth].index == (size_t)~0 || set_value_table[i].path[depth].index < sub_value_count));
-						if (object_size <= value_buffer_size)
-							value_buffer->array.table[(set_value_table[i].path[depth].index != (size_t)~0) ? set_value_table[i].path[depth].index : append_offset++] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-						size_t remaining_buffer_size = object_size < value_buffer_size ? value_buffer_size - object_size : 0;
-						size_t sub_value_size = jsonl_internal_set_values_create_path(i, set_value_count, set_value_table, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size), depth + 1, value_buffer);
-						if (!sub_value_size)
-							return 0;
-						object_size += sub_value_size;
-						++c;
-					}
-				}
-				else
-				{
-					JSONL_ASSERT(set_value_table[i].path[depth].container_type == JSONL_TYPE_ARRAY && (set_value_table[i].path[depth].index == (size_t)~0 || set_value_table[i].path[depth].index < sub_value_count));
-					if (object_size <= value_buffer_size)
-						value_buffer->array.table[(set_value_table[i].path[depth].index != (size_t)~0) ? set_value_table[i].path[depth].index : append_offset++] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-					size_t remaining_buffer_size = object_size < value_buffer_size ? value_buffer_size - object_size : 0;
-					size_t sub_value_size = jsonl_internal_copy_value(set_value_table[i].value, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
-					if (!sub_value_size)
-						return 0;
-					object_size += sub_value_size;
-					++c;
-				}
+			text[text_length++] = '.';
+			for (int i = 1; i != digit_count; ++i)
+				text[text_length++] = digit_table[i];
 		}
-		if (object_size <= value_buffer_size)
+		int scientific_exponent = decimal_exponent - 1;
+		text[text_length++] = 'e';
+		text[text_length++] = (scientific_exponent < 0) ? '-' : '+';
+		if (scientific_exponent < 0)
+			scientific_exponent = -scientific_exponent;
+		if (scientific_exponent >= 100)
+			text[text_length++] = (char)('0' + scientific_exponent / 100);
+		if (scientific_exponent >= 10)
+			text[text_length++] = (char)('0' + (scientific_exponent / 10) % 10);
+		text[text_length++] = (char)('0' + scientific_exponent % 10);
+	}
+
+	if (text_length <= text_buffer_size)
+		jsonl_copy_memory(text_buffer, text, text_length);
+	return text_length;
+}
+
+static size_t jsonl_print_canonical_number_value(const jsonl_number_value_t* number_value, size_t text_buffer_size, char* text_buffer)
+{
+#ifdef JSONL_FIXED_POINT_NUMBER_FORMAT
+	// The number is rounded to the nearest double, because canonical JSON numbers are doubles.
+	uint64_t high_part = number_value->integer;
+	uint64_t low_part = number_value->fraction;
+	int sign = number_value->sign ? 1 : 0;
+	int exponent = -64;
+	int highest_bit = -1;
+	for (uint64_t bits = high_part ? high_part : low_part; bits; bits >>= 1)
+		++highest_bit;
+	if (high_part)
+		highest_bit += 64;
+	uint64_t mantissa;
+	if (highest_bit < 0)
+		mantissa = 0;
+	else if (highest_bit <= 52)
+	{
+		mantissa = low_part << (52 - highest_bit);
+		exponent -= 52 - highest_bit;
+	}
+	else
+	{
+		int shift = highest_bit - 52;
+		int round_shift = shift - 1;
+		mantissa = (shift >= 64) ? (high_part >> (shift - 64)) : ((high_part << (64 - shift)) | (low_part >> shift));
+		int round_bit = (int)(((round_shift >= 64) ? (high_part >> (round_shift - 64)) : (low_part >> round_shift)) & 1);
+		int sticky_bits = (round_shift >= 64) ? (low_part || (high_part & (((uint64_t)1 << (round_shift - 64)) - 1))) : (round_shift && (low_part & (((uint64_t)1 << round_shift) - 1)));
+		if (round_bit && (sticky_bits || (mantissa & 1)))
 		{
-			for (size_t i = 0; i != sub_value_count; ++i)
-				if (!value_buffer->array.table[i])
-				{
-					value_buffer->array.table[i] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-					size_t remaining_buffer_size = object_size < value_buffer_size ? value_buffer_size - object_size : 0;
-					size_t sub_value_size = jsonl_internal_create_null_value(value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
-					object_size += sub_value_size;
-				}
+			++mantissa;
+			if (mantissa >> 53)
+			{
+				mantissa >>= 1;
+				++shift;
+			}
 		}
-		else
+		exponent += shift;
+	}
+#else
+	uint64_t bits;
+	jsonl_copy_memory(&bits, &number_value->value, sizeof(double));
+	int sign = (int)(bits >> 63);
+	int biased_exponent = (int)((bits >> 52) & 0x7FF);
+	uint64_t mantissa = bits & (((uint64_t)1 << 52) - 1);
+	if (biased_exponent == 0x7FF)
+		return 0;
+	int exponent = biased_exponent ? (biased_exponent - 1075) : -1074;
+	if (biased_exponent)
+		mantissa |= (uint64_t)1 << 52;
+#endif
+	if (!mantissa)
+	{
+		if (text_buffer_size)
+			text_buffer[0] = '0';
+		return 1;
+	}
+	return jsonl_print_shortest_number(sign, mantissa, exponent, text_buffer_size, text_buffer);
+}
+
+static int jsonl_canonical_member_order(const jsonl_value_t* object, uint32_t member_index_a, uint32_t member_index_b)
+{
+	// Names are ordered by UTF-16 code units. UTF-8 byte order only differs from it when code points U+E000 to U+FFFF
+	// are compared with supplementary code points, which are encoded as surrogates below U+E000 in UTF-16.
+	size_t name_length_a = object->object.table[member_index_a].name_length;
+	size_t name_length_b = object->object.table[member_index_b].name_length;
+	const uint8_t* name_a = (const uint8_t*)object->object.table[member_index_a].name;
+	const uint8_t* name_b = (const uint8_t*)object->object.table[member_index_b].name;
+	size_t common_length = (name_length_a < name_length_b) ? name_length_a : name_length_b;
+	size_t i = 0;
+	while (i != common_length && name_a[i] == name_b[i])
+		++i;
+	if (i == common_length)
+		return (name_length_a != name_length_b) ? (name_length_a < name_length_b) : (member_index_a < member_index_b);
+	uint8_t character_a = name_a[i];
+	uint8_t character_b = name_b[i];
+	if ((character_a >= 0xF0 && (character_b == 0xEE || character_b == 0xEF)) || (character_b >= 0xF0 && (character_a == 0xEE || character_a == 0xEF)))
+		return character_a > character_b;
+	return character_a < character_b;
+}
+
+static void jsonl_sift_canonical_member_order(const jsonl_value_t* object, char* order_table, size_t root, size_t heap_size)
+{
+	uint32_t root_member = jsonl_load_unaligned_32(order_table + root * sizeof(uint32_t));
+	for (size_t child = root * 2 + 1; child < heap_size; child = root * 2 + 1)
+	{
+		uint32_t child_member = jsonl_load_unaligned_32(order_table + child * sizeof(uint32_t));
+		if (child + 1 < heap_size)
 		{
-			size_t sub_null_value_size = jsonl_internal_create_null_value(value_buffer, 0, 0);
-			object_size += (sub_value_count - (value_count + path_count)) * sub_null_value_size;
+			uint32_t sibling_member = jsonl_load_unaligned_32(order_table + (child + 1) * sizeof(uint32_t));
+			if (jsonl_canonical_member_order(object, child_member, sibling_member))
+			{
+				++child;
+				child_member = sibling_member;
+			}
 		}
-		object_size += array_table_size;
+		if (!jsonl_canonical_member_order(object, root_member, child_member))
+			break;
+		jsonl_store_unaligned_32(order_table + root * sizeof(uint32_t), child_member);
+		root = child;
 	}
-	else
-		JSONL_ASSERT(0);
+	jsonl_store_unaligned_32(order_table + root * sizeof(uint32_t), root_member);
+}
 
-	if (object_size <= value_buffer_size)
+static void jsonl_sort_canonical_member_order(const jsonl_value_t* object, size_t value_count, char* order_table)
+{
+	// Heap sort needs no memory beyond the table, which may be unaligned.
+	for (size_t i = 0; i != value_count; ++i)
+		jsonl_store_unaligned_32(order_table + i * sizeof(uint32_t), (uint32_t)i);
+	for (size_t i = value_count / 2; i--;)
+		jsonl_sift_canonical_member_order(object, order_table, i, value_count);
+	for (size_t i = value_count; i-- > 1;)
 	{
-		value_buffer->size = object_size;
-		value_buffer->parent = (jsonl_value_t*)parent;
-		value_buffer->type = set_value_table[path_index].path[depth].container_type;
+		uint32_t last_member = jsonl_load_unaligned_32(order_table + i * sizeof(uint32_t));
+		jsonl_store_unaligned_32(order_table + i * sizeof(uint32_t), jsonl_load_unaligned_32(order_table));
+		jsonl_store_unaligned_32(order_table, last_member);
+		jsonl_sift_canonical_member_order(object, order_table, 0, i);
 	}
-	return object_size;
 }
 
-static int jsonl_internal_set_values_input_path_compare(const jsonl_set_value_t* input_path_a, const jsonl_set_value_t* input_path_b, size_t depth)
+static size_t jsonl_internal_print_canonical(const jsonl_value_t* value_tree, size_t json_text_buffer_size, char* json_text_buffer)
 {
-	JSONL_ASSERT(input_path_a != input_path_b);
-	int match = input_path_a->path_length >= depth && input_path_b->path_length >= depth;
-	for (size_t i = 0; match && i != depth; ++i)
-		if (input_path_a->path[i].container_type == input_path_b->path[i].container_type)
+	switch (value_tree->type)
+	{
+		case JSONL_TYPE_OBJECT:
 		{
-			if (input_path_a->path[i].container_type == JSONL_TYPE_OBJECT)
+			// Sorted member order is stored at the end of the buffer space of the object. Text of a member and its separator takes
+			// at least five bytes, so a member never overwrites table entries of the members that follow it in a sufficiently large buffer.
+			size_t value_count = value_tree->object.value_count;
+			size_t order_table_size = value_count * sizeof(uint32_t);
+			int sorted = value_count <= (size_t)0xFFFFFFFF && order_table_size < json_text_buffer_size;
+			char* order_table = sorted ? (json_text_buffer + (json_text_buffer_size - order_table_size)) : 0;
+			if (sorted)
 			{
-				if (input_path_a->path[i].name.length != input_path_b->path[i].name.length || !jsonl_memory_compare(input_path_a->path[i].name.value, input_path_b->path[i].name.value, input_path_a->path[i].name.length))
-					match = 0;
+				jsonl_sort_canonical_member_order(value_tree, value_count, order_table);
+				json_text_buffer[0] = '{';
 			}
-			else if (input_path_a->path[i].container_type == JSONL_TYPE_ARRAY)
+			size_t object_size = 1;
+			for (size_t i = 0; i != value_count; ++i)
 			{
-				if (input_path_a->path[i].index == (size_t)~0 || input_path_b->path[i].index == (size_t)~0 || input_path_a->path[i].index != input_path_b->path[i].index)
-					match = 0;
+				size_t member_index = sorted ? (size_t)jsonl_load_unaligned_32(order_table + i * sizeof(uint32_t)) : i;
+				size_t text_buffer_size = sorted ? (json_text_buffer_size - order_table_size + (i + 1) * sizeof(uint32_t)) : 0;
+				if (i)
+				{
+					if (object_size < text_buffer_size)
+						json_text_buffer[object_size] = ',';
+					++object_size;
+				}
+				object_size += jsonl_print_string_value(value_tree->object.table[member_index].name_length, value_tree->object.table[member_index].name, 'a', (object_size < text_buffer_size) ? (text_buffer_size - object_size) : 0, json_text_buffer + object_size);
+				if (object_size < text_buffer_size)
+					json_text_buffer[object_size] = ':';
+				++object_size;
+				size_t child_value_size = jsonl_internal_print_canonical(value_tree->object.table[member_index].value, (object_size < text_buffer_size) ? (text_buffer_size - object_size) : 0, json_text_buffer + object_size);
+				if (!child_value_size)
+					return 0;
+				object_size += child_value_size;
 			}
-			else
-				JSONL_ASSERT(0);
+			if (sorted && object_size < json_text_buffer_size)
+				json_text_buffer[object_size] = '}';
+			return object_size + 1;
 		}
-		else
-			match = 0;
-	return match;
+		case JSONL_TYPE_ARRAY:
+		{
+			if (json_text_buffer_size)
+				json_text_buffer[0] = '[';
+			size_t array_size = 1;
+			for (size_t i = 0; i != value_tree->array.value_count; ++i)
+			{
+				if (i)
+				{
+					if (array_size < json_text_buffer_size)
+						json_text_buffer[array_size] = ',';
+					++array_size;
+				}
+				size_t child_value_size = jsonl_internal_print_canonical(value_tree->array.table[i], (array_size < json_text_buffer_size) ? (json_text_buffer_size - array_size) : 0, json_text_buffer + array_size);
+				if (!child_value_size)
+					return 0;
+				array_size += child_value_size;
+			}
+			if (array_size < json_text_buffer_size)
+				json_text_buffer[array_size] = ']';
+			return array_size + 1;
+		}
+		case JSONL_TYPE_STRING:
+			return jsonl_print_string_value(value_tree->string.length, value_tree->string.value, 'a', json_text_buffer_size, json_text_buffer);
+		case JSONL_TYPE_NUMBER:
+			return jsonl_print_canonical_number_value(&value_tree->number, json_text_buffer_size, json_text_buffer);
+		default:
+			return jsonl_print_scalar_value(value_tree, json_text_buffer_size, json_text_buffer);
+	}
+}
+
+size_t jsonl_print(const jsonl_value_t* value_tree, size_t json_text_buffer_size, char* json_text_buffer)
+{
+	return jsonl_print_with_options(value_tree, 0, json_text_buffer_size, json_text_buffer);
+}
+
+size_t jsonl_print_with_options(const jsonl_value_t* value_tree, const jsonl_print_options_t* options, size_t json_text_buffer_size, char* json_text_buffer)
+{
+	static const jsonl_print_options_t default_options = { JSONL_PRINT_MODE_PRETTY, 1, '\t' };
+	if (!options)
+		options = &default_options;
+	switch (options->mode)
+	{
+		case JSONL_PRINT_MODE_PRETTY:
+			if (options->indent_character != '\t' && options->indent_character != ' ')
+				return 0;
+			return jsonl_internal_print(value_tree, json_text_buffer_size, json_text_buffer, 0, options);
+		case JSONL_PRINT_MODE_COMPACT:
+			return jsonl_internal_print_compact(value_tree, json_text_buffer_size, json_text_buffer);
+		case JSONL_PRINT_MODE_CANONICAL:
+			return jsonl_internal_print_canonical(value_tree, json_text_buffer_size, json_text_buffer);
+		default:
+			return 0;
+	}
+}
+
+static void jsonl_writer_flush(jsonl_writer_t* writer)
+{
+	if (writer->write_callback)
+	{
+		if (writer->chunk_size && !writer->error && !writer->write_callback(writer->write_context, writer->chunk_size, writer->chunk_buffer))
+			writer->error = 1;
+		writer->chunk_size = 0;
+	}
+	else
+		writer->overflow = 1;
 }
 
-static int jsonl_internal_set_values_is_set_value_in_path(const jsonl_internal_path_t* internal_path, const jsonl_set_value_t* input_path)
+static void jsonl_writer_write_data(jsonl_writer_t* writer, size_t size, const char* data)
 {
-	int value_path_match = input_path->path_length >= internal_path->depth;
-	for (size_t i = internal_path->depth; value_path_match && i--; internal_path = internal_path->parent)
-		if (internal_path->path_component.container_type == input_path->path[i].container_type)
+	while (size)
+	{
+		if (writer->chunk_size == writer->chunk_buffer_size)
+			jsonl_writer_flush(writer);
+		if (writer->overflow)
 		{
-			if (internal_path->path_component.container_type == JSONL_TYPE_OBJECT)
-			{
-				if (internal_path->path_component.name.length != input_path->path[i].name.length || !jsonl_memory_compare(internal_path->path_component.name.value, input_path->path[i].name.value, internal_path->path_component.name.length))
-					value_path_match = 0;
-			}
-			else if (internal_path->path_component.container_type == JSONL_TYPE_ARRAY)
-			{
-				JSONL_ASSERT(internal_path->path_component.index != (size_t)~0);
-				if (internal_path->path_component.index != input_path->path[i].index)
-					value_path_match = 0;
-			}
-			else
-				JSONL_ASSERT(0);
+			writer->printed_size += size;
+			return;
 		}
-		else
-			value_path_match = 0;
-	return value_path_match;
+		size_t free_size = writer->chunk_buffer_size - writer->chunk_size;
+		size_t write_size = (size < free_size) ? size : free_size;
+		jsonl_copy_memory(writer->chunk_buffer + writer->chunk_size, data, write_size);
+		writer->chunk_size += write_size;
+		writer->printed_size += write_size;
+		data += write_size;
+		size -= write_size;
+	}
 }
 
-static size_t jsonl_internal_set_values(size_t set_value_count, const jsonl_set_value_t* set_value_table, jsonl_internal_path_t* path, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer)
+static void jsonl_writer_write_indent(jsonl_writer_t* writer, size_t indent_length)
 {
-	const jsonl_value_t* source_value = path->source_value;
-	JSONL_ASSERT(source_value && source_value->type == path->value_type);
-	size_t indirect_overwrite_set_value_index = (size_t)~0;
-	for (size_t i = 0; i != set_value_count; ++i)
-		if (set_value_table[i].value)
+	while (indent_length)
+	{
+		if (writer->chunk_size == writer->chunk_buffer_size)
+			jsonl_writer_flush(writer);
+		if (writer->overflow)
 		{
-			int value_path_match = jsonl_internal_set_values_is_set_value_in_path(path, set_value_table + i);
-			if (value_path_match)
-			{
-				if (set_value_table[i].path_length == path->depth)
-				{
-					return jsonl_internal_copy_value(set_value_table[i].value, parent, value_buffer_size, value_buffer);
-				}
-				else if (indirect_overwrite_set_value_index == (size_t)~0)
-				{
-					int set_value_in_child_value = 0;
-					if (set_value_table[i].path_length > path->depth && source_value->type == set_value_table[i].path[path->depth].container_type)
-					{
-						if (source_value->type == JSONL_TYPE_OBJECT)
-						{
-							for (size_t j = 0; !set_value_in_child_value && j != source_value->object.value_count; ++j)
-								if (source_value->object.table[j].name_length == set_value_table[i].path[path->depth].name.length && jsonl_memory_compare(source_value->object.table[j].name, set_value_table[i].path[path->depth].name.value, source_value->object.table[j].name_length))
-									set_value_in_child_value = 1;
-						}
-						else if (source_value->type == JSONL_TYPE_ARRAY)
-						{
-							if (source_value->array.value_count > set_value_table[i].path[path->depth].index)
-								set_value_in_child_value = 1;
-						}
-						else
-							JSONL_ASSERT(0);
-					}
-					if (!set_value_in_child_value && path->value_type != set_value_table[i].path[path->depth].container_type)
-					{
+			writer->printed_size += indent_length;
+			return;
+		}
+		size_t free_size = writer->chunk_buffer_size - writer->chunk_size;
+		size_t write_size = (indent_length < free_size) ? indent_length : free_size;
+		jsonl_print_indent(writer->chunk_buffer + writer->chunk_size, write_size, writer->options.indent_character);
+		writer->chunk_size += write_size;
+		writer->printed_size += write_size;
+		indent_length -= write_size;
+	}
+}
 
-						indirect_overwrite_set_value_index = i;
-					}
-				}
-			}
+static void jsonl_writer_write_escaped_string(jsonl_writer_t* writer, size_t string_size, const char* string)
+{
+	while (string_size)
+	{
+		if (writer->overflow)
+		{
+			writer->printed_size += jsonl_print_escaped_string(string_size, string, 'A', 0, 0);
+			break;
+		}
+
+		// Every character is printed as at most 6 characters, so a slice of a sixth of the free space always fits in the buffer.
+		size_t free_size = writer->chunk_buffer_size - writer->chunk_size;
+		size_t slice_size = free_size / 6;
+		if (slice_size)
+		{
+			if (slice_size > string_size)
+				slice_size = string_size;
+			size_t printed_size = jsonl_print_escaped_string(slice_size, string, 'A', free_size, writer->chunk_buffer + writer->chunk_size);
+			JSONL_ASSERT(printed_size <= free_size);
+			writer->chunk_size += printed_size;
+			writer->printed_size += printed_size;
 		}
-	if (indirect_overwrite_set_value_index != (size_t)~0)
-		return jsonl_internal_set_values_create_path(indirect_overwrite_set_value_index, set_value_count, set_value_table, value_buffer_size, value_buffer, path->depth, parent);
+		else
+		{
+			char escaped_character[6];
+			slice_size = 1;
+			jsonl_writer_write_data(writer, jsonl_print_escaped_string(1, string, 'A', sizeof(escaped_character), escaped_character), escaped_character);
+		}
+		string += slice_size;
+		string_size -= slice_size;
+	}
+}
 
-	jsonl_internal_path_t next_path;
-	next_path.parent = path;
-	next_path.depth = path->depth + 1;
-	next_path.path_component.container_type = source_value->type;
+static void jsonl_writer_write_string(jsonl_writer_t* writer, size_t string_size, const char* string)
+{
+	jsonl_writer_write_data(writer, 1, "\"");
+	jsonl_writer_write_escaped_string(writer, string_size, string);
+	jsonl_writer_write_data(writer, 1, "\"");
+}
 
-	size_t object_size = jsonl_round_size(sizeof(jsonl_value_t));
-	switch (source_value->type)
+static void jsonl_internal_print_to_writer(jsonl_writer_t* writer, const jsonl_value_t* value_tree, size_t depth)
+{
+	int pretty = writer->options.mode == JSONL_PRINT_MODE_PRETTY;
+	size_t indent_length = pretty ? (depth * writer->options.indent_width) : 0;
+	size_t child_indent_length = pretty ? (indent_length + writer->options.indent_width) : 0;
+	switch (value_tree->type)
 	{
 		case JSONL_TYPE_OBJECT:
 		{
-			size_t remove_value_count = 0;
-			size_t add_value_count = 0;
-			for (size_t i = 0; i != set_value_count; ++i)
+			jsonl_writer_write_data(writer, pretty ? 2 : 1, "{\n");
+			for (size_t i = 0; !writer->error && i != value_tree->object.value_count; ++i)
 			{
-				int value_path_match = jsonl_internal_set_values_is_set_value_in_path(path, set_value_table + i);
-				if (value_path_match && set_value_table[i].path_length > path->depth)
-				{
-					int set_value_in_child_value = 0;
-					if (source_value->type == set_value_table[i].path[path->depth].container_type)
-						for (size_t j = 0; !set_value_in_child_value && j != source_value->object.value_count; ++j)
-							if (source_value->object.table[j].name_length == set_value_table[i].path[path->depth].name.length && jsonl_memory_compare(source_value->object.table[j].name, set_value_table[i].path[path->depth].name.value, source_value->object.table[j].name_length))
-								set_value_in_child_value = 1;
-					if (set_value_in_child_value)
-					{
-						if (!set_value_table[i].value)
-						{
-							if (set_value_table[i].path_length == path->depth + 1)
-							{
-								++remove_value_count;
-							}
-						}
-					}
-					else
-					{
-						if (set_value_table[i].value)
-						{
-							if (set_value_table[i].path_length == path->depth + 1)
-								++add_value_count;
-							else
-							{
-								int set_value_already_counted = 0;
-								for (size_t j = 0; j != i; ++j)
-									if (jsonl_internal_set_values_input_path_compare(set_value_table + j, set_value_table + i, path->depth + 1))
-										set_value_already_counted = 1;
-								if (!set_value_already_counted)
-								{
-									++add_value_count;
-								}
-							}
-						}
-					}
-				}
+				if (i)
+					jsonl_writer_write_data(writer, pretty ? 2 : 1, ",\n");
+				jsonl_writer_write_indent(writer, child_indent_length);
+				jsonl_writer_write_string(writer, value_tree->object.table[i].name_length, value_tree->object.table[i].name);
+				jsonl_writer_write_data(writer, pretty ? 3 : 1, pretty ? " : " : ":");
+				jsonl_internal_print_to_writer(writer, value_tree->object.table[i].value, depth + 1);
 			}
-
-			JSONL_ASSERT(remove_value_count <= source_value->object.value_count);
-			size_t child_value_count = (source_value->object.value_count - remove_value_count) + add_value_count;
-			size_t object_table_size = jsonl_round_size(child_value_count * sizeof(*value_buffer->object.table));
-			if (object_size <= value_buffer_size)
+			if (pretty)
 			{
-				value_buffer->object.value_count = child_value_count;
-				*(void**)&value_buffer->object.table = (void*)((uintptr_t)value_buffer + object_size);
+				if (value_tree->object.value_count)
+					jsonl_writer_write_data(writer, 1, "\n");
+				jsonl_writer_write_indent(writer, indent_length);
 			}
-			for (size_t n = source_value->object.value_count - remove_value_count, c = 0, i = 0; c != n; ++i)
+			jsonl_writer_write_data(writer, 1, "}");
+			return;
+		}
+		case JSONL_TYPE_ARRAY:
+		{
+			jsonl_writer_write_data(writer, pretty ? 2 : 1, "[\n");
+			for (size_t i = 0; !writer->error && i != value_tree->array.value_count; ++i)
 			{
-				JSONL_ASSERT(i < source_value->object.value_count && c < n);
-				int child_value_removed = 0;
-				for (size_t j = 0; !child_value_removed && j != set_value_count; ++j)
-					if (!set_value_table[j].value)
-					{
-						int value_path_match = (set_value_table[j].path_length == path->depth + 1) && jsonl_internal_set_values_is_set_value_in_path(path, set_value_table + j);
-						if (value_path_match && set_value_table[j].path[path->depth].container_type == JSONL_TYPE_OBJECT)
-						{
-							if (source_value->object.table[i].name_length == set_value_table[j].path[path->depth].name.length && jsonl_memory_compare(source_value->object.table[i].name, set_value_table[j].path[path->depth].name.value, source_value->object.table[i].name_length))
-								child_value_removed = 1;
-						}
-					}
-				if (!child_value_removed)
-				{
-					size_t name_size = jsonl_round_size(source_value->object.table[i].name_length + 1);
-					if (object_size + object_table_size + name_size <= value_buffer_size)
-					{
-						value_buffer->object.table[c].name_length = source_value->object.table[i].name_length;
-						value_buffer->object.table[c].name = (char*)((uintptr_t)value_buffer + object_size + object_table_size);
-						jsonl_copy_memory((void*)((uintptr_t)value_buffer + object_size + object_table_size), source_value->object.table[i].name, source_value->object.table[i].name_length + 1);
-					}
-					object_table_size += name_size;
-					++c;
-				}
+				if (i)
+					jsonl_writer_write_data(writer, pretty ? 2 : 1, ",\n");
+				jsonl_writer_write_indent(writer, child_indent_length);
+				jsonl_internal_print_to_writer(writer, value_tree->array.table[i], depth + 1);
 			}
-			for (size_t c = 0, i = 0; c != add_value_count; ++i)
-				if (set_value_table[i].value)
-				{
-					JSONL_ASSERT(i < set_value_count);
-					int value_path_match = jsonl_internal_set_values_is_set_value_in_path(path, set_value_table + i);
-					if (value_path_match && set_value_table[i].path_length > path->depth)
-					{
-						int set_value_in_child_value = 0;
-						JSONL_ASSERT(source_value->type == JSONL_TYPE_OBJECT);
-						if (source_value->type == set_value_table[i].path[path->depth].container_type)
-							for (size_t j = 0; !set_value_in_child_value && j != source_value->object.value_count; ++j)
-								if (source_value->object.table[j].name_length == set_value_table[i].path[path->depth].name.length && jsonl_memory_compare(source_value->object.table[j].name, set_value_table[i].path[path->depth].name.value, source_value->object.table[j].name_length))
-									set_value_in_child_value = 1;
-						if (!set_value_in_child_value)
-						{
-							JSONL_ASSERT(set_value_table[i].path_length > path->depth);
-							JSONL_ASSERT(set_value_table[i].path[path->depth].container_type == JSONL_TYPE_OBJECT);
-							int set_value_already_counted = 0;
-							for (size_t j = 0; j != i; ++j)
-								if (jsonl_internal_set_values_input_path_compare(set_value_table + j, set_value_table + i, path->depth + 1))
-									set_value_already_counted = 1;
-							if (!set_value_already_counted)
-							{
-								size_t name_size = jsonl_round_size(set_value_table[i].path[path->depth].name.length + 1);
-								if (object_size + object_table_size + name_size <= value_buffer_size)
-								{
-									value_buffer->object.table[(source_value->object.value_count - remove_value_count) + c].name_length = set_value_table[i].path[path->depth].name.length;
-									value_buffer->object.table[(source_value->object.value_count - remove_value_count) + c].name = (char*)((uintptr_t)value_buffer + object_size + object_table_size);
-									jsonl_copy_memory((void*)((uintptr_t)value_buffer + object_size + object_table_size), set_value_table[i].path[path->depth].name.value, set_value_table[i].path[path->depth].name.length + 1);
-									value_buffer->object.table[(source_value->object.value_count - remove_value_count) + c].value = 0;// debug init
-								}
-								object_table_size += name_size;
-								++c;
-							}
-						}
-					}
-				}
-			object_size += object_table_size;
-			for (size_t n = source_value->object.value_count - remove_value_count, c = 0, i = 0; c != n; ++i)
+			if (pretty)
 			{
-				JSONL_ASSERT(i < source_value->object.value_count && c < n);
-				int child_value_removed = 0;
-				for (size_t j = 0; !child_value_removed && j != set_value_count; ++j)
-					if (!set_value_table[j].value)
-					{
-						int value_path_match = (set_value_table[j].path_length == path->depth + 1) && jsonl_internal_set_values_is_set_value_in_path(path, set_value_table + i);
-						if (value_path_match && set_value_table[j].path[path->depth].container_type == JSONL_TYPE_OBJECT)
-						{
-							if (source_value->object.table[i].name_length == set_value_table[j].path[path->depth].name.length && jsonl_memory_compare(source_value->object.table[i].name, set_value_table[j].path[path->depth].name.value, source_value->object.table[i].name_length))
-								child_value_removed = 1;
-						}
-					}
-				if (!child_value_removed)
-				{
-					JSONL_ASSERT(next_path.path_component.container_type == JSONL_TYPE_OBJECT);
-					next_path.path_component.name.length = source_value->object.table[i].name_length;
-					next_path.path_component.name.value = source_value->object.table[i].name;
-					next_path.value_type = source_value->object.table[i].value->type;
-					next_path.source_value = source_value->object.table[i].value;
+				if (value_tree->array.value_count)
+					jsonl_writer_write_data(writer, 1, "\n");
+				jsonl_writer_write_indent(writer, indent_length);
+			}
+			jsonl_writer_write_data(writer, 1, "]");
+			return;
+		}
+		case JSONL_TYPE_STRING:
+			jsonl_writer_write_string(writer, value_tree->string.length, value_tree->string.value);
+			return;
+		case JSONL_TYPE_NUMBER:
+		case JSONL_TYPE_BOOLEAN:
+		case JSONL_TYPE_NULL:
+		{
+			// Scalar values other than strings are always shorter than the minimum chunk size.
+			char scalar_text[JSONL_PRINT_MINIMUM_CHUNK_SIZE];
+			size_t scalar_size = jsonl_print_scalar_value(value_tree, sizeof(scalar_text), scalar_text);
+			JSONL_ASSERT(scalar_size <= sizeof(scalar_text));
+			jsonl_writer_write_data(writer, scalar_size, scalar_text);
+			return;
+		}
+		default:
+			writer->error = 1;
+			return;
+	}
+}
+
+static int jsonl_writer_begin_value(jsonl_writer_t* writer)
+{
+	if (writer->error)
+		return 0;
+	uint8_t* nesting_state = writer->nesting_stack + writer->depth;
+	if (!writer->depth)
+	{
+		if (*nesting_state & JSONL_WRITER_NESTING_HAS_VALUES)
+		{
+			writer->error = 1;
+			return 0;
+		}
+	}
+	else if (*nesting_state & JSONL_WRITER_NESTING_OBJECT)
+	{
+		if (!writer->key_written)
+		{
+			writer->error = 1;
+			return 0;
+		}
+		writer->key_written = 0;
+		return 1;
+	}
+	else
+	{
+		int pretty = writer->options.mode == JSONL_PRINT_MODE_PRETTY;
+		if (*nesting_state & JSONL_WRITER_NESTING_HAS_VALUES)
+			jsonl_writer_write_data(writer, pretty ? 2 : 1, ",\n");
+		if (pretty)
+			jsonl_writer_write_indent(writer, writer->depth * writer->options.indent_width);
+	}
+	*nesting_state |= JSONL_WRITER_NESTING_HAS_VALUES;
+	return 1;
+}
+
+static int jsonl_writer_begin_container(jsonl_writer_t* writer, int object)
+{
+	if (writer->depth == JSONL_WRITER_MAXIMUM_DEPTH)
+		writer->error = 1;
+	if (!jsonl_writer_begin_value(writer))
+		return 0;
+	int pretty = writer->options.mode == JSONL_PRINT_MODE_PRETTY;
+	jsonl_writer_write_data(writer, pretty ? 2 : 1, object ? "{\n" : "[\n");
+	writer->nesting_stack[++writer->depth] = object ? JSONL_WRITER_NESTING_OBJECT : 0;
+	return !writer->error;
+}
+
+int jsonl_writer_initialize(jsonl_writer_t* writer, const jsonl_print_options_t* options, size_t buffer_size, char* buffer, jsonl_write_callback_t write_callback, void* write_context)
+{
+	static const jsonl_print_options_t default_options = { JSONL_PRINT_MODE_PRETTY, 1, '\t' };
+	if (!options)
+		options = &default_options;
+	if (write_callback && buffer_size < JSONL_PRINT_MINIMUM_CHUNK_SIZE)
+		return 0;
+	if (options->mode == JSONL_PRINT_MODE_PRETTY)
+	{
+		if (options->indent_character != '\t' && options->indent_character != ' ')
+			return 0;
+	}
+	else if (options->mode != JSONL_PRINT_MODE_COMPACT)
+		return 0;
+
+	writer->options = *options;
+	writer->printed_size = 0;
+	writer->chunk_size = 0;
+	writer->chunk_buffer_size = buffer_size;
+	writer->chunk_buffer = buffer;
+	writer->write_callback = write_callback;
+	writer->write_context = write_context;
+	writer->error = 0;
+	writer->overflow = 0;
+	writer->key_written = 0;
+	writer->depth = 0;
+	writer->nesting_stack[0] = 0;
+	return 1;
+}
+
+int jsonl_writer_begin_object(jsonl_writer_t* writer)
+{
+	return jsonl_writer_begin_container(writer, 1);
+}
+
+int jsonl_writer_begin_array(jsonl_writer_t* writer)
+{
+	return jsonl_writer_begin_container(writer, 0);
+}
+
+int jsonl_writer_end(jsonl_writer_t* writer)
+{
+	if (!writer->depth || writer->key_written)
+		writer->error = 1;
+	if (writer->error)
+		return 0;
+	uint8_t nesting_state = writer->nesting_stack[writer->depth--];
+	if (writer->options.mode == JSONL_PRINT_MODE_PRETTY)
+	{
+		if (nesting_state & JSONL_WRITER_NESTING_HAS_VALUES)
+			jsonl_writer_write_data(writer, 1, "\n");
+		jsonl_writer_write_indent(writer, writer->depth * writer->options.indent_width);
+	}
+	jsonl_writer_write_data(writer, 1, (nesting_state & JSONL_WRITER_NESTING_OBJECT) ? "}" : "]");
+	return !writer->error;
+}
+
+int jsonl_writer_key(jsonl_writer_t* writer, size_t name_length, const char* name)
+{
+	uint8_t* nesting_state = writer->nesting_stack + writer->depth;
+	if (!writer->depth || !(*nesting_state & JSONL_WRITER_NESTING_OBJECT) || writer->key_written)
+		writer->error = 1;
+	if (writer->error)
+		return 0;
+	int pretty = writer->options.mode == JSONL_PRINT_MODE_PRETTY;
+	if (*nesting_state & JSONL_WRITER_NESTING_HAS_VALUES)
+		jsonl_writer_write_data(writer, pretty ? 2 : 1, ",\n");
+	if (pretty)
+		jsonl_writer_write_indent(writer, writer->depth * writer->options.indent_width);
+	jsonl_writer_write_string(writer, name_length, name);
+	jsonl_writer_write_data(writer, pretty ? 3 : 1, pretty ? " : " : ":");
+	*nesting_state |= JSONL_WRITER_NESTING_HAS_VALUES;
+	writer->key_written = 1;
+	return !writer->error;
+}
+
+int jsonl_writer_string(jsonl_writer_t* writer, size_t string_length, const char* string)
+{
+	if (!jsonl_writer_begin_value(writer))
+		return 0;
+	jsonl_writer_write_string(writer, string_length, string);
+	return !writer->error;
+}
+
+int jsonl_writer_number(jsonl_writer_t* writer, const jsonl_number_value_t* number_value)
+{
+#ifndef JSONL_FIXED_POINT_NUMBER_FORMAT
+	// The number format can not represent magnitudes of 2^64 or more. The comparisons also reject NaN.
+	if (!(number_value->value > -18446744073709551616.0 && number_value->value < 18446744073709551616.0))
+	{
+		writer->error = 1;
+		return 0;
+	}
+#endif
+	if (!jsonl_writer_begin_value(writer))
+		return 0;
+	char number_text[JSONL_PRINT_MINIMUM_CHUNK_SIZE];
+	size_t number_size = jsonl_print_number_value(number_value, sizeof(number_text), number_text);
+	JSONL_ASSERT(number_size <= sizeof(number_text));
+	jsonl_writer_write_data(writer, number_size, number_text);
+	return !writer->error;
+}
+
+int jsonl_writer_boolean(jsonl_writer_t* writer, int boolean_value)
+{
+	if (!jsonl_writer_begin_value(writer))
+		return 0;
+	if (boolean_value)
+		jsonl_writer_write_data(writer, 4, "true");
+	else
+		jsonl_writer_write_data(writer, 5, "false");
+	return !writer->error;
+}
+
+int jsonl_writer_null(jsonl_writer_t* writer)
+{
+	if (!jsonl_writer_begin_value(writer))
+		return 0;
+	jsonl_writer_write_data(writer, 4, "null");
+	return !writer->error;
+}
+
+int jsonl_writer_value(jsonl_writer_t* writer, const jsonl_value_t* value_tree)
+{
+	if (!jsonl_writer_begin_value(writer))
+		return 0;
+	jsonl_internal_print_to_writer(writer, value_tree, writer->depth);
+	return !writer->error;
+}
+
+size_t jsonl_writer_finish(jsonl_writer_t* writer)
+{
+	if (writer->depth || !(writer->nesting_stack[0] & JSONL_WRITER_NESTING_HAS_VALUES))
+		writer->error = 1;
+	if (writer->error)
+		return 0;
+	if (writer->write_callback)
+		jsonl_writer_flush(writer);
+	return writer->error ? 0 : writer->printed_size;
+}
+
+size_t jsonl_print_to_writer(const jsonl_value_t* value_tree, const jsonl_print_options_t* options, size_t chunk_buffer_size, char* chunk_buffer, jsonl_write_callback_t write_callback, void* write_context)
+{
+	jsonl_writer_t writer;
+	if (!write_callback || !jsonl_writer_initialize(&writer, options, chunk_buffer_size, chunk_buffer, write_callback, write_context))
+		return 0;
+	jsonl_writer_value(&writer, value_tree);
+	return jsonl_writer_finish(&writer);
+}
+
+static int jsonl_find_struct_hash_seed(size_t field_count, const jsonl_field_descriptor_t* field_table, size_t hash_mask, uint64_t* hash_seed)
+{
+	for (uint64_t seed_index = 0; seed_index != JSONL_STRUCT_HASH_SEED_COUNT; ++seed_index)
+	{
+		uint64_t seed = seed_index * (uint64_t)0x9E3779B97F4A7C15;
+		int collision = 0;
+		for (size_t i = 1; !collision && i < field_count; ++i)
+		{
+			size_t slot = jsonl_struct_field_slot(seed, hash_mask, field_table[i].name_length, field_table[i].name);
+			for (size_t j = 0; !collision && j != i; ++j)
+				collision = slot == jsonl_struct_field_slot(seed, hash_mask, field_table[j].name_length, field_table[j].name);
+		}
+		if (!collision)
+		{
+			*hash_seed = seed;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+size_t jsonl_create_struct_descriptor(size_t field_count, const jsonl_field_descriptor_t* field_table, size_t descriptor_buffer_size, jsonl_struct_descriptor_t* descriptor_buffer)
+{
+	size_t longest_name_length = 0;
+	for (size_t i = 0; i != field_count; ++i)
+	{
+		const jsonl_field_descriptor_t* field = field_table + i;
+		if (field->name_length > JSONL_STRUCT_MAXIMUM_NAME_LENGTH ||
+			(field->type == JSONL_FIELD_TYPE_OBJECT && !field->struct_descriptor) ||
+			(field->type == JSONL_FIELD_TYPE_STRING && !field->size) ||
+			((field->type == JSONL_FIELD_TYPE_BOOLEAN || field->type == JSONL_FIELD_TYPE_INTEGER) && field->size && field->size != 1 && field->size != 2 && field->size != 4 && field->size != 8) ||
+			(field->type != JSONL_FIELD_TYPE_OBJECT && field->type != JSONL_FIELD_TYPE_STRING && field->type != JSONL_FIELD_TYPE_NUMBER &&
+			field->type != JSONL_FIELD_TYPE_BOOLEAN && field->type != JSONL_FIELD_TYPE_INTEGER && field->type != JSONL_FIELD_TYPE_DOUBLE))
+			return 0;
+		for (size_t j = 0; j != i; ++j)
+			if (field_table[j].name_length == field->name_length && jsonl_memory_compare(field_table[j].name, field->name, field->name_length))
+				return 0;
+		if (field->name_length > longest_name_length)
+			longest_name_length = field->name_length;
+	}
+
+	// Every table size is tried with all seeds before the table size is doubled. At the birthday bound of the square of field count almost any seed works.
+	size_t slot_count = 1;
+	while (slot_count < field_count * 2)
+		slot_count <<= 1;
+	uint64_t hash_seed;
+	while (!jsonl_find_struct_hash_seed(field_count, field_table, slot_count - 1, &hash_seed))
+	{
+		if (slot_count > field_count * field_count || slot_count > ((size_t)~0 / sizeof(size_t)) / 2)
+			return 0;
+		slot_count <<= 1;
+	}
+
+	size_t descriptor_size = jsonl_round_size(sizeof(jsonl_struct_descriptor_t)) + slot_count * sizeof(size_t);
+	if (descriptor_size <= descriptor_buffer_size)
+	{
+		size_t* hash_table = (size_t*)((uintptr_t)descriptor_buffer + jsonl_round_size(sizeof(jsonl_struct_descriptor_t)));
+		descriptor_buffer->size = descriptor_size;
+		descriptor_buffer->field_count = field_count;
+		descriptor_buffer->field_table = field_table;
+		descriptor_buffer->hash_seed = hash_seed;
+		descriptor_buffer->hash_mask = slot_count - 1;
+		descriptor_buffer->hash_table = hash_table;
+		descriptor_buffer->longest_name_length = longest_name_length;
+		for (size_t i = 0; i != slot_count; ++i)
+			hash_table[i] = (size_t)~0;
+		for (size_t i = 0; i != field_count; ++i)
+			hash_table[jsonl_struct_field_slot(hash_seed, slot_count - 1, field_table[i].name_length, field_table[i].name)] = i;
+	}
+	return descriptor_size;
+}
+
+static const jsonl_field_descriptor_t* jsonl_find_struct_field(const jsonl_struct_descriptor_t* struct_descriptor, size_t name_length, const char* name)
+{
+	if (name_length > struct_descriptor->longest_name_length)
+		return 0;
+	size_t field_index = struct_descriptor->hash_table[jsonl_struct_field_slot(struct_descriptor->hash_seed, struct_descriptor->hash_mask, name_length, name)];
+	if (field_index == (size_t)~0)
+		return 0;
+	const jsonl_field_descriptor_t* field = struct_descriptor->field_table + field_index;
+	return (field->name_length == name_length && jsonl_memory_compare(field->name, name, name_length)) ? field : 0;
+}
+
+static void jsonl_store_field_integer(void* field_address, size_t field_size, int64_t value)
+{
+	switch (field_size)
+	{
+		case 1:
+			*(int8_t*)field_address = (int8_t)value;
+			return;
+		case 2:
+			*(int16_t*)field_address = (int16_t)value;
+			return;
+		case 4:
+			*(int32_t*)field_address = (int32_t)value;
+			return;
+		default:
+			JSONL_ASSERT(field_size == 8);
+			*(int64_t*)field_address = value;
+			return;
+	}
+}
+
+static int64_t jsonl_load_field_integer(const void* field_address, size_t field_size)
+{
+	switch (field_size)
+	{
+		case 1:
+			return (int64_t)*(const int8_t*)field_address;
+		case 2:
+			return (int64_t)*(const int16_t*)field_address;
+		case 4:
+			return (int64_t)*(const int32_t*)field_address;
+		default:
+			JSONL_ASSERT(field_size == 8);
+			return *(const int64_t*)field_address;
+	}
+}
+
+static int jsonl_decode_integer(size_t json_text_size, const char* json_text, int64_t* value)
+{
+	const char* read = json_text;
+	const char* end = json_text + json_text_size;
+	int negative = read != end && *read == '-';
+	if (negative)
+		++read;
+	if (read == end)
+		return 0;
+	uint64_t limit = negative ? ((uint64_t)1 << 63) : (((uint64_t)1 << 63) - 1);
+	uint64_t magnitude = 0;
+	while (read != end)
+	{
+		if (!jsonl_is_decimal_value(*read))
+			return 0;
+		uint64_t digit = (uint64_t)jsonl_decimal_value(*read++);
+		if (magnitude > (limit - digit) / 10)
+			return 0;
+		magnitude = magnitude * 10 + digit;
+	}
+	*value = (negative && magnitude) ? -(int64_t)(magnitude - 1) - 1 : (int64_t)magnitude;
+	return 1;
+}
+
+static int jsonl_decode_struct_member(const jsonl_struct_descriptor_t* struct_descriptor, size_t name_size, const char* name_text, int value_type, size_t value_size, const char* value_text, void* structure)
+{
+	// Names are decoded before the lookup, because the same name can be written with different escape sequences.
+	char name[JSONL_STRUCT_MAXIMUM_NAME_LENGTH];
+	size_t name_length;
+	jsonl_decode_quoted_string(name_size, name_text, sizeof(name), name, &name_length);
+	const jsonl_field_descriptor_t* field = jsonl_find_struct_field(struct_descriptor, name_length, name);
+	if (!field || value_type == JSONL_TYPE_NULL)
+		return 1;
+	void* field_address = (void*)((uintptr_t)structure + field->offset);
+	switch (field->type)
+	{
+		case JSONL_FIELD_TYPE_OBJECT:
+			return value_type == JSONL_TYPE_OBJECT && jsonl_internal_decode_struct(field->struct_descriptor, value_size, value_text, field_address);
+		case JSONL_FIELD_TYPE_STRING:
+		{
+			if (value_type != JSONL_TYPE_STRING)
+				return 0;
+			size_t string_length;
+			jsonl_decode_quoted_string(value_size, value_text, field->size, (char*)field_address, &string_length);
+			if (string_length >= field->size)
+				return 0;
+			*((char*)field_address + string_length) = 0;
+			return 1;
+		}
+		case JSONL_FIELD_TYPE_NUMBER:
+			return value_type == JSONL_TYPE_NUMBER && jsonl_decode_number(value_size, value_text, (jsonl_number_value_t*)field_address);
+		case JSONL_FIELD_TYPE_BOOLEAN:
+		{
+			int boolean_value;
+			if (value_type != JSONL_TYPE_BOOLEAN || !jsonl_decode_boolean(value_size, value_text, &boolean_value))
+				return 0;
+			jsonl_store_field_integer(field_address, field->size ? field->size : sizeof(int), (int64_t)boolean_value);
+			return 1;
+		}
+		case JSONL_FIELD_TYPE_INTEGER:
+		{
+			size_t field_size = field->size ? field->size : sizeof(int64_t);
+			int64_t integer_value;
+			if (value_type != JSONL_TYPE_NUMBER || !jsonl_decode_integer(value_size, value_text, &integer_value))
+				return 0;
+			int64_t limit = (int64_t)((((uint64_t)1 << (field_size * 8 - 1)) - 1));
+			if (integer_value > limit || integer_value < -limit - 1)
+				return 0;
+			jsonl_store_field_integer(field_address, field_size, integer_value);
+			return 1;
+		}
+		case JSONL_FIELD_TYPE_DOUBLE:
+		{
+			jsonl_number_value_t number_value;
+			if (value_type != JSONL_TYPE_NUMBER || !jsonl_decode_number(value_size, value_text, &number_value))
+				return 0;
+#ifdef JSONL_FIXED_POINT_NUMBER_FORMAT
+			double value = (double)number_value.integer + (double)number_value.fraction * (1.0 / 18446744073709551616.0);
+			*(double*)field_address = number_value.sign ? -value : value;
+#else
+			*(double*)field_address = number_value.value;
+#endif
+			return 1;
+		}
+		default:
+			return 0;
+	}
+}
+
+static int jsonl_internal_decode_struct(const jsonl_struct_descriptor_t* struct_descriptor, size_t object_text_size, const char* object_text, void* structure)
+{
+	const char* end = object_text + object_text_size - 1;
+	const char* read = object_text + 1;
+	size_t member_count = 0;
+	int expecting_new_member = 1;
+	while (read != end)
+	{
+		char character = *read;
+		if (expecting_new_member)
+		{
+			if (character == '"')
+			{
+				size_t name_size;
+				int value_type;
+				size_t value_offset;
+				size_t value_size;
+				size_t name_value_pair_size = jsonl_name_value_pair_size((size_t)((uintptr_t)end - (uintptr_t)read), read, &name_size, &value_type, &value_offset, &value_size);
+				if (!name_value_pair_size || !jsonl_decode_struct_member(struct_descriptor, name_size, read, value_type, value_size, read + value_offset, structure))
+					return 0;
+				read += name_value_pair_size;
+				++member_count;
+				expecting_new_member = 0;
+			}
+			else if (jsonl_is_white_space(character))
+				++read;
+			else
+				return 0;
+		}
+		else
+		{
+			if (character == ',')
+				expecting_new_member = 1;
+			else if (!jsonl_is_white_space(character))
+				return 0;
+			++read;
+		}
+	}
+	return !member_count || !expecting_new_member;
+}
+
+size_t jsonl_decode_struct(const jsonl_struct_descriptor_t* struct_descriptor, size_t json_text_size, const char* json_text, void* structure)
+{
+	size_t beginning_white_space = jsonl_white_space_length(json_text_size, json_text);
+	size_t object_text_size = jsonl_object_text_size(json_text_size - beginning_white_space, json_text + beginning_white_space);
+	if (!object_text_size || !jsonl_internal_decode_struct(struct_descriptor, object_text_size, json_text + beginning_white_space, structure))
+		return 0;
+	return beginning_white_space + object_text_size;
+}
+
+static int jsonl_writer_integer(jsonl_writer_t* writer, int64_t integer_value)
+{
+	if (!jsonl_writer_begin_value(writer))
+		return 0;
+	char integer_text[20];
+	size_t integer_size = 0;
+	uint64_t magnitude = (integer_value < 0) ? ((uint64_t)0 - (uint64_t)integer_value) : (uint64_t)integer_value;
+	do
+	{
+		integer_text[sizeof(integer_text) - 1 - integer_size++] = (char)('0' + (int)(magnitude % 10));
+		magnitude /= 10;
+	} while (magnitude);
+	if (integer_value < 0)
+		integer_text[sizeof(integer_text) - 1 - integer_size++] = '-';
+	jsonl_writer_write_data(writer, integer_size, integer_text + sizeof(integer_text) - integer_size);
+	return !writer->error;
+}
+
+int jsonl_writer_struct(jsonl_writer_t* writer, const jsonl_struct_descriptor_t* struct_descriptor, const void* structure)
+{
+	if (!jsonl_writer_begin_object(writer))
+		return 0;
+	for (size_t i = 0; i != struct_descriptor->field_count; ++i)
+	{
+		const jsonl_field_descriptor_t* field = struct_descriptor->field_table + i;
+		const void* field_address = (const void*)((uintptr_t)structure + field->offset);
+		if (!jsonl_writer_key(writer, field->name_length, field->name))
+			return 0;
+		switch (field->type)
+		{
+			case JSONL_FIELD_TYPE_OBJECT:
+				jsonl_writer_struct(writer, field->struct_descriptor, field_address);
+				break;
+			case JSONL_FIELD_TYPE_STRING:
+			{
+				size_t string_length = 0;
+				while (string_length != field->size && *((const char*)field_address + string_length))
+					++string_length;
+				jsonl_writer_string(writer, string_length, (const char*)field_address);
+				break;
+			}
+			case JSONL_FIELD_TYPE_NUMBER:
+				jsonl_writer_number(writer, (const jsonl_number_value_t*)field_address);
+				break;
+			case JSONL_FIELD_TYPE_BOOLEAN:
+				jsonl_writer_boolean(writer, jsonl_load_field_integer(field_address, field->size ? field->size : sizeof(int)) != 0);
+				break;
+			case JSONL_FIELD_TYPE_INTEGER:
+				jsonl_writer_integer(writer, jsonl_load_field_integer(field_address, field->size ? field->size : sizeof(int64_t)));
+				break;
+			case JSONL_FIELD_TYPE_DOUBLE:
+			{
+				// The comparisons also reject NaN.
+				double value = *(const double*)field_address;
+				if (!(value > -18446744073709551616.0 && value < 18446744073709551616.0))
+				{
+					writer->error = 1;
+					return 0;
+				}
+				jsonl_number_value_t number_value;
+#ifdef JSONL_FIXED_POINT_NUMBER_FORMAT
+				number_value.sign = (int)(value < 0.0);
+				if (number_value.sign)
+					value = -value;
+				number_value.integer = (uint64_t)value;
+				number_value.fraction = (uint64_t)((value - (double)number_value.integer) * 18446744073709551616.0);
+#else
+				number_value.value = value;
+#endif
+				jsonl_writer_number(writer, &number_value);
+				break;
+			}
+			default:
+				writer->error = 1;
+				return 0;
+		}
+	}
+	return jsonl_writer_end(writer);
+}
+
+size_t jsonl_print_struct(const jsonl_struct_descriptor_t* struct_descriptor, const void* structure, const jsonl_print_options_t* options, size_t json_text_buffer_size, char* json_text_buffer)
+{
+	jsonl_writer_t writer;
+	if (!jsonl_writer_initialize(&writer, options, json_text_buffer_size, json_text_buffer, 0, 0))
+		return 0;
+	jsonl_writer_struct(&writer, struct_descriptor, structure);
+	return jsonl_writer_finish(&writer);
+}
+
+static size_t jsonl_internal_create_null_value(const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	size_t null_object_size = jsonl_round_size(sizeof(jsonl_value_t));
+	if (null_object_size <= value_buffer_size)
+	{
+		value_buffer->size = null_object_size;
+		value_buffer->parent = (jsonl_value_t*)parent;
+		value_buffer->type = JSONL_TYPE_NULL;
+	}
+	return null_object_size;
+}
+
+static size_t jsonl_internal_copy_value(const jsonl_value_t* value, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	size_t object_size = jsonl_round_size(sizeof(jsonl_value_t));
+	switch (value->type)
+	{
+		case JSONL_TYPE_OBJECT:
+		{
+			size_t object_table_size = jsonl_round_size(value->object.value_count * sizeof(*value->object.table));
+			uintptr_t index_content = (uintptr_t)value_buffer + object_size + object_table_size;
+			object_table_size += jsonl_object_index_size(value->object.value_count);
+			if (object_size <= value_buffer_size)
+			{
+				value_buffer->object.value_count = value->object.value_count;
+				*(void**)&value_buffer->object.table = (void*)((uintptr_t)value_buffer + object_size);
+			}
+			for (size_t i = 0; i != value->object.value_count; ++i)
+			{
+				size_t name_size = jsonl_round_size(value->object.table[i].name_length + 1);
+				if (object_size + object_table_size + name_size <= value_buffer_size)
+				{
+					value_buffer->object.table[i].name_length = value->object.table[i].name_length;
+					value_buffer->object.table[i].name = (char*)((uintptr_t)value_buffer + object_size + object_table_size);
+					jsonl_copy_memory((void*)((uintptr_t)value_buffer + object_size + object_table_size), value->object.table[i].name, value->object.table[i].name_length + 1);
+				}
+				object_table_size += name_size;
+			}
+			object_size += object_table_size;
+			for (size_t i = 0; i != value->object.value_count; ++i)
+			{
+				if (object_size <= value_buffer_size)
+					value_buffer->object.table[i].value = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+				size_t remaining_buffer_size = object_size < value_buffer_size ? value_buffer_size - object_size : 0;
+				size_t sub_value_size = jsonl_internal_copy_value(value->object.table[i].value, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+				if (!sub_value_size)
+					return 0;
+				object_size += sub_value_size;
+			}
+			if (object_size <= value_buffer_size)
+				jsonl_create_object_index(value_buffer, (void*)index_content, value->object.index);
+			break;
+		}
+		case JSONL_TYPE_ARRAY:
+		{
+			size_t array_table_size = jsonl_round_size(value->array.value_count * sizeof(jsonl_value_t*));
+			if (object_size <= value_buffer_size)
+			{
+				value_buffer->array.value_count = value->array.value_count;
+				*(void**)&value_buffer->array.table = (void*)((uintptr_t)value_buffer + object_size);
+			}
+			object_size += array_table_size;
+			for (size_t i = 0; i != value->array.value_count; ++i)
+			{
+				if (object_size <= value_buffer_size)
+					value_buffer->array.table[i] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+				size_t remaining_buffer_size = object_size < value_buffer_size ? value_buffer_size - object_size : 0;
+				size_t sub_value_size = jsonl_internal_copy_value(value->array.table[i], value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+				if (!sub_value_size)
+					return 0;
+				object_size += sub_value_size;
+			}
+			break;
+		}
+		case JSONL_TYPE_STRING:
+		{
+			size_t data_size = jsonl_round_size(value->string.length + 1);
+			if (object_size + data_size <= value_buffer_size)
+			{
+				value_buffer->string.length = value->string.length;
+				value_buffer->string.value = (char*)((uintptr_t)value_buffer + object_size);
+				jsonl_copy_memory((char*)((uintptr_t)value_buffer + object_size), value->string.value, value->string.length + 1);
+			}
+			object_size += data_size;
+			break;
+		}
+		case JSONL_TYPE_NUMBER:
+		{
+			if (object_size <= value_buffer_size)
+			{
+#ifdef JSONL_FIXED_POINT_NUMBER_FORMAT
+				value_buffer->number.sign = value->number.sign;
+				value_buffer->number.integer = value->number.integer;
+				value_buffer->number.fraction = value->number.fraction;
+#else
+				value_buffer->number.value = value->number.value;
+#endif
+			}
+			break;
+		}
+		case JSONL_TYPE_BOOLEAN:
+		{
+			if (object_size <= value_buffer_size)
+				value_buffer->boolean.value = value->boolean.value;
+			break;
+		}
+		case JSONL_TYPE_NULL:
+		{
+			break;
+		}
+		default:
+			return 0;
+	}
+
+	if (object_size <= value_buffer_size)
+	{
+		value_buffer->size = object_size;
+		value_buffer->parent = (jsonl_value_t*)parent;
+		value_buffer->type = value->type;
+	}
+	return object_size;
+}
+
+static int jsonl_set_values_plan_component_compare(const jsonl_path_component_t* path_component_a, size_t set_value_index_a, const jsonl_path_component_t* path_component_b, size_t set_value_index_b)
+{
+	int component_order = jsonl_path_component_compare(path_component_a, path_component_b);
+	if (!component_order && path_component_a->container_type == JSONL_TYPE_ARRAY && path_component_a->index == (size_t)~0 && set_value_index_a != set_value_index_b)
+		return (set_value_index_a < set_value_index_b) ? -1 : 1;
+	return component_order;
+}
+
+static int jsonl_set_values_plan_path_compare(const jsonl_set_value_t* set_value_table, size_t set_value_index_a, size_t set_value_index_b)
+{
+	const jsonl_set_value_t* set_value_a = set_value_table + set_value_index_a;
+	const jsonl_set_value_t* set_value_b = set_value_table + set_value_index_b;
+	size_t common_length = (set_value_a->path_length < set_value_b->path_length) ? set_value_a->path_length : set_value_b->path_length;
+	for (size_t i = 0; i != common_length; ++i)
+	{
+		int component_order = jsonl_set_values_plan_component_compare(set_value_a->path + i, set_value_index_a, set_value_b->path + i, set_value_index_b);
+		if (component_order)
+			return component_order;
+	}
+	if (set_value_a->path_length != set_value_b->path_length)
+		return (set_value_a->path_length < set_value_b->path_length) ? -1 : 1;
+	return 0;
+}
+
+static size_t jsonl_set_values_plan_sort(size_t list, size_t list_length, const jsonl_set_value_t* set_value_table, size_t* link_table)
+{
+	if (list_length < 2)
+		return list;
+	size_t left_length = list_length / 2;
+	size_t left_last = list;
+	for (size_t i = 1; i != left_length; ++i)
+		left_last = link_table[left_last];
+	size_t right = link_table[left_last];
+	link_table[left_last] = (size_t)~0;
+	size_t left = jsonl_set_values_plan_sort(list, left_length, set_value_table, link_table);
+	right = jsonl_set_values_plan_sort(right, list_length - left_length, set_value_table, link_table);
+	size_t head = (size_t)~0;
+	size_t tail = (size_t)~0;
+	while (left != (size_t)~0 || right != (size_t)~0)
+	{
+		size_t next;
+		if (right == (size_t)~0 || (left != (size_t)~0 && jsonl_set_values_plan_path_compare(set_value_table, left, right) <= 0))
+		{
+			next = left;
+			left = link_table[left];
+		}
+		else
+		{
+			next = right;
+			right = link_table[right];
+		}
+		if (tail != (size_t)~0)
+			link_table[tail] = next;
+		else
+			head = next;
+		tail = next;
+	}
+	link_table[tail] = (size_t)~0;
+	return head;
+}
+
+static size_t jsonl_set_values_plan_order_children(size_t list, size_t list_length, jsonl_set_values_plan_node_t* node_table)
+{
+	if (list_length < 2)
+		return list;
+	size_t left_length = list_length / 2;
+	size_t left_last = list;
+	for (size_t i = 1; i != left_length; ++i)
+		left_last = node_table[left_last].next_ordered_index;
+	size_t right = node_table[left_last].next_ordered_index;
+	node_table[left_last].next_ordered_index = (size_t)~0;
+	size_t left = jsonl_set_values_plan_order_children(list, left_length, node_table);
+	right = jsonl_set_values_plan_order_children(right, list_length - left_length, node_table);
+	size_t head = (size_t)~0;
+	size_t tail = (size_t)~0;
+	while (left != (size_t)~0 || right != (size_t)~0)
+	{
+		size_t next;
+		if (right == (size_t)~0 || (left != (size_t)~0 && node_table[left].first_value_index <= node_table[right].first_value_index))
+		{
+			next = left;
+			left = node_table[left].next_ordered_index;
+		}
+		else
+		{
+			next = right;
+			right = node_table[right].next_ordered_index;
+		}
+		if (tail != (size_t)~0)
+			node_table[tail].next_ordered_index = next;
+		else
+			head = next;
+		tail = next;
+	}
+	node_table[tail].next_ordered_index = (size_t)~0;
+	return head;
+}
+
+static size_t jsonl_set_values_plan_group_end(const jsonl_set_value_t* set_value_table, const size_t* order_table, size_t begin, size_t end, size_t depth)
+{
+	size_t group_end = begin + 1;
+	while (group_end != end && !jsonl_set_values_plan_component_compare(set_value_table[order_table[begin]].path + depth, order_table[begin], set_value_table[order_table[group_end]].path + depth, order_table[group_end]))
+		++group_end;
+	return group_end;
+}
+
+static void jsonl_set_values_plan_build(const jsonl_set_value_t* set_value_table, const size_t* order_table, size_t begin, size_t end, size_t depth, jsonl_set_values_plan_node_t* node_table, size_t node_index, size_t* node_count)
+{
+	jsonl_set_values_plan_node_t* node = node_table + node_index;
+	node->set_value_index = (size_t)~0;
+	node->remove = 0;
+	node->child_index = *node_count;
+	node->child_count = 0;
+	node->ordered_child_index = (size_t)~0;
+	node->next_ordered_index = (size_t)~0;
+	for (; begin != end && set_value_table[order_table[begin]].path_length == depth; ++begin)
+	{
+		if (!set_value_table[order_table[begin]].value)
+			node->remove = 1;
+		else if (node->set_value_index == (size_t)~0)
+			node->set_value_index = order_table[begin];
+	}
+	node->first_value_index = node->set_value_index;
+	for (size_t group = begin; group != end; group = jsonl_set_values_plan_group_end(set_value_table, order_table, group, end, depth))
+		++node->child_count;
+	*node_count += node->child_count;
+	for (size_t child_index = node->child_index, group = begin; group != end; ++child_index)
+	{
+		size_t group_end = jsonl_set_values_plan_group_end(set_value_table, order_table, group, end, depth);
+		node_table[child_index].component = set_value_table[order_table[group]].path + depth;
+		jsonl_set_values_plan_build(set_value_table, order_table, group, group_end, depth + 1, node_table, child_index, node_count);
+		node_table[child_index].next_ordered_index = (child_index + 1 != node->child_index + node->child_count) ? (child_index + 1) : (size_t)~0;
+		if (node_table[child_index].first_value_index < node->first_value_index)
+			node->first_value_index = node_table[child_index].first_value_index;
+		group = group_end;
+	}
+	if (node->child_count)
+		node->ordered_child_index = jsonl_set_values_plan_order_children(node->child_index, node->child_count, node_table);
+}
+
+static JSONL_INLINE int jsonl_set_values_plan_is_unmodified(const jsonl_set_values_plan_node_t* node)
+{
+	return !node || (node->set_value_index == (size_t)~0 && !node->remove && !node->child_count);
+}
+
+static const jsonl_set_values_plan_node_t* jsonl_set_values_plan_find_child(const jsonl_set_values_plan_t* plan, const jsonl_set_values_plan_node_t* node, const jsonl_path_component_t* path_component)
+{
+	size_t low = node->child_index;
+	size_t high = node->child_index + node->child_count;
+	while (low != high)
+	{
+		size_t middle = low + ((high - low) / 2);
+		int component_order = jsonl_path_component_compare(plan->node_table[middle].component, path_component);
+		if (!component_order)
+			return plan->node_table + middle;
+		if (component_order < 0)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return 0;
+}
+
+static const jsonl_set_values_plan_node_t* jsonl_set_values_plan_find_member_child(const jsonl_set_values_plan_t* plan, const jsonl_set_values_plan_node_t* node, size_t name_length, const char* name)
+{
+	jsonl_path_component_t path_component;
+	path_component.container_type = JSONL_TYPE_OBJECT;
+	path_component.name.length = name_length;
+	path_component.name.value = (char*)name;
+	return jsonl_set_values_plan_find_child(plan, node, &path_component);
+}
+
+static const jsonl_set_values_plan_node_t* jsonl_set_values_plan_find_element_child(const jsonl_set_values_plan_t* plan, const jsonl_set_values_plan_node_t* node, size_t index)
+{
+	jsonl_path_component_t path_component;
+	path_component.container_type = JSONL_TYPE_ARRAY;
+	path_component.index = index;
+	return jsonl_set_values_plan_find_child(plan, node, &path_component);
+}
+
+static size_t jsonl_internal_set_values_create_planned_value(const jsonl_set_values_plan_t* plan, const jsonl_set_values_plan_node_t* node, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	JSONL_ASSERT(node->first_value_index != (size_t)~0);
+	if (node->set_value_index != (size_t)~0)
+		return jsonl_internal_copy_value(plan->set_value_table[node->set_value_index].value, parent, value_buffer_size, value_buffer);
+	JSONL_ASSERT(node->ordered_child_index != (size_t)~0);
+	return jsonl_internal_set_values_create_planned_path(plan, node, plan->node_table[node->ordered_child_index].component->container_type, parent, value_buffer_size, value_buffer);
+}
+
+static size_t jsonl_internal_set_values_create_planned_path(const jsonl_set_values_plan_t* plan, const jsonl_set_values_plan_node_t* node, int container_type, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	const jsonl_set_values_plan_node_t* child_table = plan->node_table + node->child_index;
+	size_t object_size = jsonl_round_size(sizeof(jsonl_value_t));
+	if (container_type == JSONL_TYPE_OBJECT)
+	{
+		size_t child_value_count = 0;
+		for (size_t i = 0; i != node->child_count; ++i)
+			if (child_table[i].component->container_type == JSONL_TYPE_OBJECT && child_table[i].first_value_index != (size_t)~0)
+				++child_value_count;
+		size_t object_table_size = jsonl_round_size(child_value_count * sizeof(*value_buffer->object.table));
+		uintptr_t index_content = (uintptr_t)value_buffer + object_size + object_table_size;
+		object_table_size += jsonl_object_index_size(child_value_count);
+		if (object_size <= value_buffer_size)
+		{
+			value_buffer->object.value_count = child_value_count;
+			*(void**)&value_buffer->object.table = (void*)((uintptr_t)value_buffer + object_size);
+		}
+		for (size_t c = 0, i = node->ordered_child_index; i != (size_t)~0; i = plan->node_table[i].next_ordered_index)
+			if (plan->node_table[i].component->container_type == JSONL_TYPE_OBJECT && plan->node_table[i].first_value_index != (size_t)~0)
+			{
+				const jsonl_path_component_t* path_component = plan->node_table[i].component;
+				size_t name_size = jsonl_round_size(path_component->name.length + 1);
+				if (object_size + object_table_size + name_size <= value_buffer_size)
+				{
+					value_buffer->object.table[c].name_length = path_component->name.length;
+					value_buffer->object.table[c].name = (char*)((uintptr_t)value_buffer + object_size + object_table_size);
+					jsonl_copy_memory((void*)((uintptr_t)value_buffer + object_size + object_table_size), path_component->name.value, path_component->name.length);
+					jsonl_terminator_string((char*)((uintptr_t)value_buffer + object_size + object_table_size + path_component->name.length));
+				}
+				object_table_size += name_size;
+				++c;
+			}
+		object_size += object_table_size;
+		for (size_t c = 0, i = node->ordered_child_index; i != (size_t)~0; i = plan->node_table[i].next_ordered_index)
+			if (plan->node_table[i].component->container_type == JSONL_TYPE_OBJECT && plan->node_table[i].first_value_index != (size_t)~0)
+			{
+				if (object_size <= value_buffer_size)
+					value_buffer->object.table[c].value = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+				size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
+				size_t child_value_size = jsonl_internal_set_values_create_planned_value(plan, plan->node_table + i, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+				if (!child_value_size)
+					return 0;
+				object_size += child_value_size;
+				++c;
+			}
+		if (object_size <= value_buffer_size)
+			jsonl_create_object_index(value_buffer, (void*)index_content, 0);
+	}
+	else
+	{
+		JSONL_ASSERT(container_type == JSONL_TYPE_ARRAY);
+		size_t set_child_value_count = 0;
+		size_t append_child_value_count = 0;
+		for (size_t i = 0; i != node->child_count; ++i)
+			if (child_table[i].component->container_type == JSONL_TYPE_ARRAY && child_table[i].first_value_index != (size_t)~0)
+			{
+				if (child_table[i].component->index == (size_t)~0)
+					++append_child_value_count;
+				else if (child_table[i].component->index + 1 > set_child_value_count)
+					set_child_value_count = child_table[i].component->index + 1;
+			}
+		size_t child_value_count = set_child_value_count + append_child_value_count;
+		size_t array_table_size = jsonl_round_size(child_value_count * sizeof(*value_buffer->array.table));
+		if (object_size + array_table_size <= value_buffer_size)
+		{
+			value_buffer->array.value_count = child_value_count;
+			*(void**)&value_buffer->array.table = (void*)((uintptr_t)value_buffer + object_size);
+		}
+		object_size += array_table_size;
+		for (size_t i = 0; i != set_child_value_count; ++i)
+		{
+			const jsonl_set_values_plan_node_t* child_node = jsonl_set_values_plan_find_element_child(plan, node, i);
+			size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
+			if (remaining_buffer_size)
+				value_buffer->array.table[i] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+			size_t child_value_size = (child_node && child_node->first_value_index != (size_t)~0) ?
+				jsonl_internal_set_values_create_planned_value(plan, child_node, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size)) :
+				jsonl_internal_create_null_value(value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+			if (!child_value_size)
+				return 0;
+			object_size += child_value_size;
+		}
+		for (size_t c = set_child_value_count, i = 0; i != node->child_count; ++i)
+			if (child_table[i].component->container_type == JSONL_TYPE_ARRAY && child_table[i].component->index == (size_t)~0 && child_table[i].first_value_index != (size_t)~0)
+			{
+				size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
+				if (remaining_buffer_size)
+					value_buffer->array.table[c] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+				size_t child_value_size = jsonl_internal_set_values_create_planned_value(plan, child_table + i, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+				if (!child_value_size)
+					return 0;
+				object_size += child_value_size;
+				++c;
+			}
+	}
+	if (object_size <= value_buffer_size)
+	{
+		value_buffer->size = object_size;
+		value_buffer->parent = (jsonl_value_t*)parent;
+		value_buffer->type = container_type;
+	}
+	return object_size;
+}
+
+static size_t jsonl_internal_set_values_with_plan(const jsonl_set_values_plan_t* plan, const jsonl_set_values_plan_node_t* node, const jsonl_value_t* source_value, int share, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	if (node && node->set_value_index != (size_t)~0)
+		return jsonl_internal_copy_value(plan->set_value_table[node->set_value_index].value, parent, value_buffer_size, value_buffer);
+	if (!node || (!node->child_count && !share))
+		return jsonl_internal_copy_value(source_value, parent, value_buffer_size, value_buffer);
+	for (size_t i = node->ordered_child_index; i != (size_t)~0 && plan->node_table[i].first_value_index != (size_t)~0; i = plan->node_table[i].next_ordered_index)
+		if (plan->node_table[i].component->container_type != source_value->type)
+			return jsonl_internal_set_values_create_planned_path(plan, node, plan->node_table[i].component->container_type, parent, value_buffer_size, value_buffer);
+
+	const jsonl_set_values_plan_node_t* child_table = plan->node_table + node->child_index;
+	size_t object_size = jsonl_round_size(sizeof(jsonl_value_t));
+	switch (source_value->type)
+	{
+		case JSONL_TYPE_OBJECT:
+		{
+			size_t remove_value_count = 0;
+			size_t add_value_count = 0;
+			for (size_t i = 0; i != source_value->object.value_count; ++i)
+			{
+				const jsonl_set_values_plan_node_t* child_node = jsonl_set_values_plan_find_member_child(plan, node, source_value->object.table[i].name_length, source_value->object.table[i].name);
+				if (child_node && child_node->remove)
+					++remove_value_count;
+			}
+			for (size_t i = 0; i != node->child_count; ++i)
+				if (child_table[i].component->container_type == JSONL_TYPE_OBJECT && child_table[i].first_value_index != (size_t)~0 &&
+					jsonl_find_object_member(source_value, child_table[i].component->name.length, child_table[i].component->name.value) == (size_t)~0)
+					++add_value_count;
+
+			size_t child_value_count = (source_value->object.value_count - remove_value_count) + add_value_count;
+			size_t object_table_size = jsonl_round_size(child_value_count * sizeof(*value_buffer->object.table));
+			uintptr_t index_content = (uintptr_t)value_buffer + object_size + object_table_size;
+			object_table_size += jsonl_object_index_size(child_value_count);
+			if (object_size <= value_buffer_size)
+			{
+				value_buffer->object.value_count = child_value_count;
+				*(void**)&value_buffer->object.table = (void*)((uintptr_t)value_buffer + object_size);
+			}
+			size_t c = 0;
+			for (size_t i = 0; i != source_value->object.value_count; ++i)
+			{
+				// Member names are copied even when values are shared, so the new tree refers to the source tree only through unmodified values.
+				const jsonl_set_values_plan_node_t* child_node = jsonl_set_values_plan_find_member_child(plan, node, source_value->object.table[i].name_length, source_value->object.table[i].name);
+				if (!child_node || !child_node->remove)
+				{
+					size_t name_size = jsonl_round_size(source_value->object.table[i].name_length + 1);
+					if (object_size + object_table_size + name_size <= value_buffer_size)
+					{
+						value_buffer->object.table[c].name_length = source_value->object.table[i].name_length;
+						value_buffer->object.table[c].name = (char*)((uintptr_t)value_buffer + object_size + object_table_size);
+						jsonl_copy_memory((void*)((uintptr_t)value_buffer + object_size + object_table_size), source_value->object.table[i].name, source_value->object.table[i].name_length + 1);
+					}
+					object_table_size += name_size;
+					++c;
+				}
+			}
+			for (size_t i = node->ordered_child_index; i != (size_t)~0; i = plan->node_table[i].next_ordered_index)
+			{
+				const jsonl_path_component_t* path_component = plan->node_table[i].component;
+				if (path_component->container_type == JSONL_TYPE_OBJECT && plan->node_table[i].first_value_index != (size_t)~0 &&
+					jsonl_find_object_member(source_value, path_component->name.length, path_component->name.value) == (size_t)~0)
+				{
+					size_t name_size = jsonl_round_size(path_component->name.length + 1);
+					if (object_size + object_table_size + name_size <= value_buffer_size)
+					{
+						value_buffer->object.table[c].name_length = path_component->name.length;
+						value_buffer->object.table[c].name = (char*)((uintptr_t)value_buffer + object_size + object_table_size);
+						jsonl_copy_memory((void*)((uintptr_t)value_buffer + object_size + object_table_size), path_component->name.value, path_component->name.length);
+						jsonl_terminator_string((char*)((uintptr_t)value_buffer + object_size + object_table_size + path_component->name.length));
+					}
+					object_table_size += name_size;
+					++c;
+				}
+			}
+			JSONL_ASSERT(c == child_value_count);
+			object_size += object_table_size;
+			c = 0;
+			for (size_t i = 0; i != source_value->object.value_count; ++i)
+			{
+				const jsonl_set_values_plan_node_t* child_node = jsonl_set_values_plan_find_member_child(plan, node, source_value->object.table[i].name_length, source_value->object.table[i].name);
+				if (share && jsonl_set_values_plan_is_unmodified(child_node))
+				{
+					if (object_size <= value_buffer_size)
+						value_buffer->object.table[c].value = source_value->object.table[i].value;
+					++c;
+				}
+				else if (!child_node || !child_node->remove)
+				{
+					if (object_size <= value_buffer_size)
+						value_buffer->object.table[c].value = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+					size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
+					size_t child_value_size = jsonl_internal_set_values_with_plan(plan, child_node, source_value->object.table[i].value, share, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+					if (!child_value_size)
+						return 0;
+					object_size += child_value_size;
+					++c;
+				}
+			}
+			for (size_t i = node->ordered_child_index; i != (size_t)~0; i = plan->node_table[i].next_ordered_index)
+			{
+				const jsonl_path_component_t* path_component = plan->node_table[i].component;
+				if (path_component->container_type == JSONL_TYPE_OBJECT && plan->node_table[i].first_value_index != (size_t)~0 &&
+					jsonl_find_object_member(source_value, path_component->name.length, path_component->name.value) == (size_t)~0)
+				{
+					if (object_size <= value_buffer_size)
+						value_buffer->object.table[c].value = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+					size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
+					size_t child_value_size = jsonl_internal_set_values_create_planned_value(plan, plan->node_table + i, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+					if (!child_value_size)
+						return 0;
+					object_size += child_value_size;
+					++c;
+				}
+			}
+			if (object_size <= value_buffer_size)
+				jsonl_create_object_index(value_buffer, (void*)index_content, (!remove_value_count && !add_value_count) ? source_value->object.index : 0);
+			break;
+		}
+		case JSONL_TYPE_ARRAY:
+		{
+			size_t remove_child_value_count = 0;
+			size_t set_child_value_count = 0;
+			size_t append_child_value_count = 0;
+			for (size_t i = 0; i != node->child_count; ++i)
+				if (child_table[i].component->container_type == JSONL_TYPE_ARRAY)
+				{
+					if (child_table[i].component->index == (size_t)~0)
+					{
+						if (child_table[i].first_value_index != (size_t)~0)
+							++append_child_value_count;
+					}
+					else
+					{
+						if (child_table[i].remove && child_table[i].component->index < source_value->array.value_count)
+							++remove_child_value_count;
+						if (child_table[i].first_value_index != (size_t)~0 && child_table[i].component->index + 1 > set_child_value_count)
+							set_child_value_count = child_table[i].component->index + 1;
+					}
+				}
+
+			size_t child_value_count = source_value->array.value_count - remove_child_value_count;
+			if (child_value_count < set_child_value_count)
+				child_value_count = set_child_value_count;
+			size_t fixed_child_value_count = child_value_count;
+			child_value_count += append_child_value_count;
+
+			size_t array_table_size = jsonl_round_size(child_value_count * sizeof(*value_buffer->array.table));
+			if (object_size + array_table_size <= value_buffer_size)
+			{
+				value_buffer->array.value_count = child_value_count;
+				*(void**)&value_buffer->array.table = (void*)((uintptr_t)value_buffer + object_size);
+			}
+			object_size += array_table_size;
+			for (size_t erased = 0, i = 0; i != fixed_child_value_count; ++i)
+			{
+				const jsonl_set_values_plan_node_t* child_node = jsonl_set_values_plan_find_element_child(plan, node, i);
+				if (!child_node || child_node->first_value_index == (size_t)~0)
+					for (const jsonl_set_values_plan_node_t* erased_node; i + erased < source_value->array.value_count; ++erased)
+					{
+						erased_node = jsonl_set_values_plan_find_element_child(plan, node, i + erased);
+						if (!erased_node || !erased_node->remove)
+							break;
+					}
+				size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
+				if (remaining_buffer_size)
+					value_buffer->array.table[i] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+				if (share && i + erased < source_value->array.value_count && jsonl_set_values_plan_is_unmodified(child_node))
+				{
+					if (object_size <= value_buffer_size)
+						value_buffer->array.table[i] = source_value->array.table[i + erased];
+					continue;
+				}
+				size_t child_value_size;
+				if (i + erased < source_value->array.value_count && (!child_node || child_node->set_value_index == (size_t)~0))
+					child_value_size = jsonl_internal_set_values_with_plan(plan, child_node, source_value->array.table[i + erased], share, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+				else if (child_node && child_node->first_value_index != (size_t)~0)
+					child_value_size = jsonl_internal_set_values_create_planned_value(plan, child_node, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+				else
+					child_value_size = jsonl_internal_create_null_value(value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+				if (!child_value_size)
+					return 0;
+				object_size += child_value_size;
+			}
+			for (size_t c = fixed_child_value_count, i = 0; i != node->child_count; ++i)
+				if (child_table[i].component->container_type == JSONL_TYPE_ARRAY && child_table[i].component->index == (size_t)~0 && child_table[i].first_value_index != (size_t)~0)
+				{
+					size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
+					if (remaining_buffer_size)
+						value_buffer->array.table[c] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+					size_t child_value_size = jsonl_internal_set_values_create_planned_value(plan, child_table + i, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+					if (!child_value_size)
+						return 0;
+					object_size += child_value_size;
+					++c;
+				}
+			break;
+		}
+		default:
+			return jsonl_internal_copy_value(source_value, parent, value_buffer_size, value_buffer);
+	}
+	if (object_size <= value_buffer_size)
+	{
+		value_buffer->size = object_size;
+		value_buffer->parent = (jsonl_value_t*)parent;
+		value_buffer->type = source_value->type;
+	}
+	return object_size;
+}
+
+size_t jsonl_create_set_values_plan(size_t set_value_count, const jsonl_set_value_t* set_value_table, size_t plan_buffer_size, jsonl_set_values_plan_t* plan_buffer)
+{
+	size_t node_count = 1;
+	for (size_t i = 0; i != set_value_count; ++i)
+	{
+		if (!set_value_table[i].path_length && !set_value_table[i].value)
+			return 0;
+		for (size_t j = 0; j != set_value_table[i].path_length; ++j)
+			if (set_value_table[i].path[j].container_type != JSONL_TYPE_OBJECT && set_value_table[i].path[j].container_type != JSONL_TYPE_ARRAY)
+				return 0;
+		node_count += set_value_table[i].path_length;
+	}
+
+	size_t plan_size = jsonl_round_size(sizeof(jsonl_set_values_plan_t));
+	size_t node_table_offset = plan_size;
+	plan_size += jsonl_round_size(node_count * sizeof(jsonl_set_values_plan_node_t));
+	size_t order_table_offset = plan_size;
+	plan_size += jsonl_round_size(set_value_count * sizeof(size_t));
+	size_t link_table_offset = plan_size;
+	plan_size += jsonl_round_size(set_value_count * sizeof(size_t));
+	if (plan_size > plan_buffer_size)
+		return plan_size;
+
+	jsonl_set_values_plan_node_t* node_table = (jsonl_set_values_plan_node_t*)((uintptr_t)plan_buffer + node_table_offset);
+	size_t* order_table = (size_t*)((uintptr_t)plan_buffer + order_table_offset);
+	size_t* link_table = (size_t*)((uintptr_t)plan_buffer + link_table_offset);
+	for (size_t i = 0; i != set_value_count; ++i)
+		link_table[i] = (i + 1 != set_value_count) ? (i + 1) : (size_t)~0;
+	size_t list = set_value_count ? jsonl_set_values_plan_sort(0, set_value_count, set_value_table, link_table) : (size_t)~0;
+	for (size_t i = 0; list != (size_t)~0; ++i, list = link_table[list])
+		order_table[i] = list;
+
+	size_t used_node_count = 1;
+	node_table[0].component = 0;
+	jsonl_set_values_plan_build(set_value_table, order_table, 0, set_value_count, 0, node_table, 0, &used_node_count);
+	JSONL_ASSERT(used_node_count <= node_count);
+
+	plan_buffer->size = plan_size;
+	plan_buffer->set_value_count = set_value_count;
+	plan_buffer->set_value_table = set_value_table;
+	plan_buffer->node_count = used_node_count;
+	plan_buffer->node_table = node_table;
+	return plan_size;
+}
+
+size_t jsonl_set_values_with_plan(const jsonl_value_t* value_tree, const jsonl_set_values_plan_t* plan, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	return jsonl_internal_set_values_with_plan(plan, plan->node_table, value_tree, 0, 0, value_buffer_size, value_buffer);
+}
+
+size_t jsonl_set_values_shared(const jsonl_value_t* value_tree, const jsonl_set_values_plan_t* plan, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	return jsonl_internal_set_values_with_plan(plan, plan->node_table, value_tree, 1, 0, value_buffer_size, value_buffer);
+}
+
+static int jsonl_set_values_scan_has_prefix(const jsonl_set_value_t* set_value_table, size_t set_value_index, size_t prefix_index, size_t depth)
+{
+	// A node of the path trie that is not stored in memory is identified by its depth and a modification that has the path of the node as prefix.
+	if (set_value_table[set_value_index].path_length < depth)
+		return 0;
+	if (set_value_index == prefix_index)
+		return 1;
+	for (size_t i = depth; i--;)
+		if (jsonl_set_values_plan_component_compare(set_value_table[set_value_index].path + i, set_value_index, set_value_table[prefix_index].path + i, prefix_index))
+			return 0;
+	return 1;
+}
+
+static void jsonl_set_values_scan_node(size_t set_value_count, const jsonl_set_value_t* set_value_table, size_t depth, size_t prefix_index, jsonl_internal_set_values_scan_node_t* node)
+{
+	node->depth = depth;
+	node->prefix_index = prefix_index;
+	node->set_value_index = (size_t)~0;
+	node->remove = 0;
+	node->first_value_index = (size_t)~0;
+	node->has_child = 0;
+	for (size_t i = 0; i != set_value_count; ++i)
+		if (jsonl_set_values_scan_has_prefix(set_value_table, i, prefix_index, depth))
+		{
+			if (set_value_table[i].path_length != depth)
+				node->has_child = 1;
+			else if (!set_value_table[i].value)
+				node->remove = 1;
+			else if (node->set_value_index == (size_t)~0)
+				node->set_value_index = i;
+			if (set_value_table[i].value && node->first_value_index == (size_t)~0)
+				node->first_value_index = i;
+		}
+}
+
+static size_t jsonl_set_values_scan_find_child(size_t set_value_count, const jsonl_set_value_t* set_value_table, const jsonl_internal_set_values_scan_node_t* node, const jsonl_path_component_t* path_component)
+{
+	for (size_t i = 0; i != set_value_count; ++i)
+		if (set_value_table[i].path_length > node->depth && !jsonl_path_component_compare(set_value_table[i].path + node->depth, path_component) &&
+			jsonl_set_values_scan_has_prefix(set_value_table, i, node->prefix_index, node->depth))
+			return i;
+	return (size_t)~0;
+}
+
+static int jsonl_set_values_scan_find_member_child(size_t set_value_count, const jsonl_set_value_t* set_value_table, const jsonl_internal_set_values_scan_node_t* node, size_t name_length, const char* name, jsonl_internal_set_values_scan_node_t* child_node)
+{
+	jsonl_path_component_t path_component;
+	path_component.container_type = JSONL_TYPE_OBJECT;
+	path_component.name.length = name_length;
+	path_component.name.value = (char*)name;
+	size_t prefix_index = jsonl_set_values_scan_find_child(set_value_count, set_value_table, node, &path_component);
+	if (prefix_index == (size_t)~0)
+		return 0;
+	jsonl_set_values_scan_node(set_value_count, set_value_table, node->depth + 1, prefix_index, child_node);
+	return 1;
+}
+
+static int jsonl_set_values_scan_find_element_child(size_t set_value_count, const jsonl_set_value_t* set_value_table, const jsonl_internal_set_values_scan_node_t* node, size_t index, jsonl_internal_set_values_scan_node_t* child_node)
+{
+	jsonl_path_component_t path_component;
+	path_component.container_type = JSONL_TYPE_ARRAY;
+	path_component.index = index;
+	size_t prefix_index = jsonl_set_values_scan_find_child(set_value_count, set_value_table, node, &path_component);
+	if (prefix_index == (size_t)~0)
+		return 0;
+	jsonl_set_values_scan_node(set_value_count, set_value_table, node->depth + 1, prefix_index, child_node);
+	return 1;
+}
+
+static size_t jsonl_set_values_scan_next_child(size_t set_value_count, const jsonl_set_value_t* set_value_table, const jsonl_internal_set_values_scan_node_t* node, size_t set_value_index)
+{
+	// Children that write values are visited in order of their first modification that writes a value, like the ordered children of a plan node.
+	// The child is returned as the index of that modification, so (size_t)~0 starts the search and is returned after the last child.
+	for (size_t i = (set_value_index != (size_t)~0) ? (set_value_index + 1) : 0; i < set_value_count; ++i)
+	{
+		if (!set_value_table[i].value || set_value_table[i].path_length <= node->depth || !jsonl_set_values_scan_has_prefix(set_value_table, i, node->prefix_index, node->depth))
+			continue;
+		int first_value = 1;
+		for (size_t j = 0; first_value && j != i; ++j)
+			if (set_value_table[j].value && set_value_table[j].path_length > node->depth &&
+				!jsonl_set_values_plan_component_compare(set_value_table[j].path + node->depth, j, set_value_table[i].path + node->depth, i) &&
+				jsonl_set_values_scan_has_prefix(set_value_table, j, node->prefix_index, node->depth))
+				first_value = 0;
+		if (first_value)
+			return i;
+	}
+	return (size_t)~0;
+}
+
+static size_t jsonl_internal_set_values_create_scanned_value(size_t set_value_count, const jsonl_set_value_t* set_value_table, const jsonl_internal_set_values_scan_node_t* node, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	JSONL_ASSERT(node->first_value_index != (size_t)~0);
+	if (node->set_value_index != (size_t)~0)
+		return jsonl_internal_copy_value(set_value_table[node->set_value_index].value, parent, value_buffer_size, value_buffer);
+	return jsonl_internal_set_values_create_scanned_path(set_value_count, set_value_table, node, set_value_table[node->first_value_index].path[node->depth].container_type, parent, value_buffer_size, value_buffer);
+}
+
+static size_t jsonl_internal_set_values_create_scanned_path(size_t set_value_count, const jsonl_set_value_t* set_value_table, const jsonl_internal_set_values_scan_node_t* node, int container_type, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	jsonl_internal_set_values_scan_node_t child_node;
+	size_t object_size = jsonl_round_size(sizeof(jsonl_value_t));
+	if (container_type == JSONL_TYPE_OBJECT)
+	{
+		size_t child_value_count = 0;
+		for (size_t i = jsonl_set_values_scan_next_child(set_value_count, set_value_table, node, (size_t)~0); i != (size_t)~0; i = jsonl_set_values_scan_next_child(set_value_count, set_value_table, node, i))
+			if (set_value_table[i].path[node->depth].container_type == JSONL_TYPE_OBJECT)
+				++child_value_count;
+		size_t object_table_size = jsonl_round_size(child_value_count * sizeof(*value_buffer->object.table));
+		uintptr_t index_content = (uintptr_t)value_buffer + object_size + object_table_size;
+		object_table_size += jsonl_object_index_size(child_value_count);
+		if (object_size <= value_buffer_size)
+		{
+			value_buffer->object.value_count = child_value_count;
+			*(void**)&value_buffer->object.table = (void*)((uintptr_t)value_buffer + object_size);
+		}
+		for (size_t c = 0, i = jsonl_set_values_scan_next_child(set_value_count, set_value_table, node, (size_t)~0); i != (size_t)~0; i = jsonl_set_values_scan_next_child(set_value_count, set_value_table, node, i))
+			if (set_value_table[i].path[node->depth].container_type == JSONL_TYPE_OBJECT)
+			{
+				const jsonl_path_component_t* path_component = set_value_table[i].path + node->depth;
+				size_t name_size = jsonl_round_size(path_component->name.length + 1);
+				if (object_size + object_table_size + name_size <= value_buffer_size)
+				{
+					value_buffer->object.table[c].name_length = path_component->name.length;
+					value_buffer->object.table[c].name = (char*)((uintptr_t)value_buffer + object_size + object_table_size);
+					jsonl_copy_memory((void*)((uintptr_t)value_buffer + object_size + object_table_size), path_component->name.value, path_component->name.length);
+					jsonl_terminator_string((char*)((uintptr_t)value_buffer + object_size + object_table_size + path_component->name.length));
+				}
+				object_table_size += name_size;
+				++c;
+			}
+		object_size += object_table_size;
+		for (size_t c = 0, i = jsonl_set_values_scan_next_child(set_value_count, set_value_table, node, (size_t)~0); i != (size_t)~0; i = jsonl_set_values_scan_next_child(set_value_count, set_value_table, node, i))
+			if (set_value_table[i].path[node->depth].container_type == JSONL_TYPE_OBJECT)
+			{
+				if (object_size <= value_buffer_size)
+					value_buffer->object.table[c].value = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+				size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
+				jsonl_set_values_scan_node(set_value_count, set_value_table, node->depth + 1, i, &child_node);
+				size_t child_value_size = jsonl_internal_set_values_create_scanned_value(set_value_count, set_value_table, &child_node, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+				if (!child_value_size)
+					return 0;
+				object_size += child_value_size;
+				++c;
+			}
+		if (object_size <= value_buffer_size)
+			jsonl_create_object_index(value_buffer, (void*)index_content, 0);
+	}
+	else
+	{
+		JSONL_ASSERT(container_type == JSONL_TYPE_ARRAY);
+		size_t set_child_value_count = 0;
+		size_t append_child_value_count = 0;
+		for (size_t i = 0; i != set_value_count; ++i)
+			if (set_value_table[i].value && set_value_table[i].path_length > node->depth && set_value_table[i].path[node->depth].container_type == JSONL_TYPE_ARRAY &&
+				jsonl_set_values_scan_has_prefix(set_value_table, i, node->prefix_index, node->depth))
+			{
+				if (set_value_table[i].path[node->depth].index == (size_t)~0)
+					++append_child_value_count;
+				else if (set_value_table[i].path[node->depth].index + 1 > set_child_value_count)
+					set_child_value_count = set_value_table[i].path[node->depth].index + 1;
+			}
+		size_t child_value_count = set_child_value_count + append_child_value_count;
+		size_t array_table_size = jsonl_round_size(child_value_count * sizeof(*value_buffer->array.table));
+		if (object_size + array_table_size <= value_buffer_size)
+		{
+			value_buffer->array.value_count = child_value_count;
+			*(void**)&value_buffer->array.table = (void*)((uintptr_t)value_buffer + object_size);
+		}
+		object_size += array_table_size;
+		for (size_t i = 0; i != set_child_value_count; ++i)
+		{
+			size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
+			if (remaining_buffer_size)
+				value_buffer->array.table[i] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+			size_t child_value_size = (jsonl_set_values_scan_find_element_child(set_value_count, set_value_table, node, i, &child_node) && child_node.first_value_index != (size_t)~0) ?
+				jsonl_internal_set_values_create_scanned_value(set_value_count, set_value_table, &child_node, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size)) :
+				jsonl_internal_create_null_value(value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+			if (!child_value_size)
+				return 0;
+			object_size += child_value_size;
+		}
+		for (size_t c = set_child_value_count, i = 0; i != set_value_count; ++i)
+			if (set_value_table[i].value && set_value_table[i].path_length > node->depth && set_value_table[i].path[node->depth].container_type == JSONL_TYPE_ARRAY && set_value_table[i].path[node->depth].index == (size_t)~0 &&
+				jsonl_set_values_scan_has_prefix(set_value_table, i, node->prefix_index, node->depth))
+			{
+				size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
+				if (remaining_buffer_size)
+					value_buffer->array.table[c] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+				jsonl_set_values_scan_node(set_value_count, set_value_table, node->depth + 1, i, &child_node);
+				size_t child_value_size = jsonl_internal_set_values_create_scanned_value(set_value_count, set_value_table, &child_node, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+				if (!child_value_size)
+					return 0;
+				object_size += child_value_size;
+				++c;
+			}
+	}
+	if (object_size <= value_buffer_size)
+	{
+		value_buffer->size = object_size;
+		value_buffer->parent = (jsonl_value_t*)parent;
+		value_buffer->type = container_type;
+	}
+	return object_size;
+}
+
+static size_t jsonl_internal_set_values_without_plan(size_t set_value_count, const jsonl_set_value_t* set_value_table, const jsonl_internal_set_values_scan_node_t* node, const jsonl_value_t* source_value, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	// This works like jsonl_internal_set_values_with_plan without sharing, but the nodes of the path trie are found by searching the set value table.
+	if (node->set_value_index != (size_t)~0)
+		return jsonl_internal_copy_value(set_value_table[node->set_value_index].value, parent, value_buffer_size, value_buffer);
+	if (!node->has_child)
+		return jsonl_internal_copy_value(source_value, parent, value_buffer_size, value_buffer);
+	for (size_t i = 0; i != set_value_count; ++i)
+		if (set_value_table[i].value && set_value_table[i].path_length > node->depth && set_value_table[i].path[node->depth].container_type != source_value->type &&
+			jsonl_set_values_scan_has_prefix(set_value_table, i, node->prefix_index, node->depth))
+			return jsonl_internal_set_values_create_scanned_path(set_value_count, set_value_table, node, set_value_table[i].path[node->depth].container_type, parent, value_buffer_size, value_buffer);
+
+	jsonl_internal_set_values_scan_node_t child_node;
+	size_t object_size = jsonl_round_size(sizeof(jsonl_value_t));
+	switch (source_value->type)
+	{
+		case JSONL_TYPE_OBJECT:
+		{
+			size_t remove_value_count = 0;
+			size_t add_value_count = 0;
+			for (size_t i = 0; i != source_value->object.value_count; ++i)
+				if (jsonl_set_values_scan_find_member_child(set_value_count, set_value_table, node, source_value->object.table[i].name_length, source_value->object.table[i].name, &child_node) && child_node.remove)
+					++remove_value_count;
+			for (size_t i = jsonl_set_values_scan_next_child(set_value_count, set_value_table, node, (size_t)~0); i != (size_t)~0; i = jsonl_set_values_scan_next_child(set_value_count, set_value_table, node, i))
+				if (set_value_table[i].path[node->depth].container_type == JSONL_TYPE_OBJECT &&
+					jsonl_find_object_member(source_value, set_value_table[i].path[node->depth].name.length, set_value_table[i].path[node->depth].name.value) == (size_t)~0)
+					++add_value_count;
+
+			size_t child_value_count = (source_value->object.value_count - remove_value_count) + add_value_count;
+			size_t object_table_size = jsonl_round_size(child_value_count * sizeof(*value_buffer->object.table));
+			uintptr_t index_content = (uintptr_t)value_buffer + object_size + object_table_size;
+			object_table_size += jsonl_object_index_size(child_value_count);
+			if (object_size <= value_buffer_size)
+			{
+				value_buffer->object.value_count = child_value_count;
+				*(void**)&value_buffer->object.table = (void*)((uintptr_t)value_buffer + object_size);
+			}
+			size_t c = 0;
+			for (size_t i = 0; i != source_value->object.value_count; ++i)
+				if (!jsonl_set_values_scan_find_member_child(set_value_count, set_value_table, node, source_value->object.table[i].name_length, source_value->object.table[i].name, &child_node) || !child_node.remove)
+				{
+					size_t name_size = jsonl_round_size(source_value->object.table[i].name_length + 1);
+					if (object_size + object_table_size + name_size <= value_buffer_size)
+					{
+						value_buffer->object.table[c].name_length = source_value->object.table[i].name_length;
+						value_buffer->object.table[c].name = (char*)((uintptr_t)value_buffer + object_size + object_table_size);
+						jsonl_copy_memory((void*)((uintptr_t)value_buffer + object_size + object_table_size), source_value->object.table[i].name, source_value->object.table[i].name_length + 1);
+					}
+					object_table_size += name_size;
+					++c;
+				}
+			for (size_t i = jsonl_set_values_scan_next_child(set_value_count, set_value_table, node, (size_t)~0); i != (size_t)~0; i = jsonl_set_values_scan_next_child(set_value_count, set_value_table, node, i))
+			{
+				const jsonl_path_component_t* path_component = set_value_table[i].path + node->depth;
+				if (path_component->container_type == JSONL_TYPE_OBJECT && jsonl_find_object_member(source_value, path_component->name.length, path_component->name.value) == (size_t)~0)
+				{
+					size_t name_size = jsonl_round_size(path_component->name.length + 1);
+					if (object_size + object_table_size + name_size <= value_buffer_size)
+					{
+						value_buffer->object.table[c].name_length = path_component->name.length;
+						value_buffer->object.table[c].name = (char*)((uintptr_t)value_buffer + object_size + object_table_size);
+						jsonl_copy_memory((void*)((uintptr_t)value_buffer + object_size + object_table_size), path_component->name.value, path_component->name.length);
+						jsonl_terminator_string((char*)((uintptr_t)value_buffer + object_size + object_table_size + path_component->name.length));
+					}
+					object_table_size += name_size;
+					++c;
+				}
+			}
+			JSONL_ASSERT(c == child_value_count);
+			object_size += object_table_size;
+			c = 0;
+			for (size_t i = 0; i != source_value->object.value_count; ++i)
+			{
+				int has_child_node = jsonl_set_values_scan_find_member_child(set_value_count, set_value_table, node, source_value->object.table[i].name_length, source_value->object.table[i].name, &child_node);
+				if (!has_child_node || !child_node.remove)
+				{
+					if (object_size <= value_buffer_size)
+						value_buffer->object.table[c].value = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
 					size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
-					if (remaining_buffer_size)
+					size_t child_value_size = has_child_node ?
+						jsonl_internal_set_values_without_plan(set_value_count, set_value_table, &child_node, source_value->object.table[i].value, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size)) :
+						jsonl_internal_copy_value(source_value->object.table[i].value, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+					if (!child_value_size)
+						return 0;
+					object_size += child_value_size;
+					++c;
+				}
+			}
+			for (size_t i = jsonl_set_values_scan_next_child(set_value_count, set_value_table, node, (size_t)~0); i != (size_t)~0; i = jsonl_set_values_scan_next_child(set_value_count, set_value_table, node, i))
+			{
+				const jsonl_path_component_t* path_component = set_value_table[i].path + node->depth;
+				if (path_component->container_type == JSONL_TYPE_OBJECT && jsonl_find_object_member(source_value, path_component->name.length, path_component->name.value) == (size_t)~0)
+				{
+					if (object_size <= value_buffer_size)
 						value_buffer->object.table[c].value = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-					size_t child_value_size = jsonl_internal_set_values(set_value_count, set_value_table, &next_path, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+					size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
+					jsonl_set_values_scan_node(set_value_count, set_value_table, node->depth + 1, i, &child_node);
+					size_t child_value_size = jsonl_internal_set_values_create_scanned_value(set_value_count, set_value_table, &child_node, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+					if (!child_value_size)
+						return 0;
+					object_size += child_value_size;
+					++c;
+				}
+			}
+			if (object_size <= value_buffer_size)
+				jsonl_create_object_index(value_buffer, (void*)index_content, (!remove_value_count && !add_value_count) ? source_value->object.index : 0);
+			break;
+		}
+		case JSONL_TYPE_ARRAY:
+		{
+			size_t remove_child_value_count = 0;
+			size_t set_child_value_count = 0;
+			size_t append_child_value_count = 0;
+			for (size_t i = 0; i != set_value_count; ++i)
+			{
+				if (set_value_table[i].path_length <= node->depth || set_value_table[i].path[node->depth].container_type != JSONL_TYPE_ARRAY || !jsonl_set_values_scan_has_prefix(set_value_table, i, node->prefix_index, node->depth))
+					continue;
+				size_t index = set_value_table[i].path[node->depth].index;
+				if (set_value_table[i].value)
+				{
+					if (index == (size_t)~0)
+						++append_child_value_count;
+					else if (index + 1 > set_child_value_count)
+						set_child_value_count = index + 1;
+				}
+				else if (set_value_table[i].path_length == node->depth + 1 && index < source_value->array.value_count)
+				{
+					// Removals of the same element are counted once, like the single child of a plan node.
+					int first_remove = 1;
+					for (size_t j = 0; first_remove && j != i; ++j)
+						if (!set_value_table[j].value && set_value_table[j].path_length == node->depth + 1 && set_value_table[j].path[node->depth].container_type == JSONL_TYPE_ARRAY &&
+							set_value_table[j].path[node->depth].index == index && jsonl_set_values_scan_has_prefix(set_value_table, j, node->prefix_index, node->depth))
+							first_remove = 0;
+					if (first_remove)
+						++remove_child_value_count;
+				}
+			}
+
+			size_t child_value_count = source_value->array.value_count - remove_child_value_count;
+			if (child_value_count < set_child_value_count)
+				child_value_count = set_child_value_count;
+			size_t fixed_child_value_count = child_value_count;
+			child_value_count += append_child_value_count;
+
+			size_t array_table_size = jsonl_round_size(child_value_count * sizeof(*value_buffer->array.table));
+			if (object_size + array_table_size <= value_buffer_size)
+			{
+				value_buffer->array.value_count = child_value_count;
+				*(void**)&value_buffer->array.table = (void*)((uintptr_t)value_buffer + object_size);
+			}
+			object_size += array_table_size;
+			for (size_t erased = 0, i = 0; i != fixed_child_value_count; ++i)
+			{
+				int has_child_node = jsonl_set_values_scan_find_element_child(set_value_count, set_value_table, node, i, &child_node);
+				if (!has_child_node || child_node.first_value_index == (size_t)~0)
+					for (jsonl_internal_set_values_scan_node_t erased_node; i + erased < source_value->array.value_count; ++erased)
+						if (!jsonl_set_values_scan_find_element_child(set_value_count, set_value_table, node, i + erased, &erased_node) || !erased_node.remove)
+							break;
+				size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
+				if (remaining_buffer_size)
+					value_buffer->array.table[i] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+				size_t child_value_size;
+				if (i + erased < source_value->array.value_count && (!has_child_node || child_node.set_value_index == (size_t)~0))
+					child_value_size = has_child_node ?
+						jsonl_internal_set_values_without_plan(set_value_count, set_value_table, &child_node, source_value->array.table[i + erased], value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size)) :
+						jsonl_internal_copy_value(source_value->array.table[i + erased], value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+				else if (has_child_node && child_node.first_value_index != (size_t)~0)
+					child_value_size = jsonl_internal_set_values_create_scanned_value(set_value_count, set_value_table, &child_node, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+				else
+					child_value_size = jsonl_internal_create_null_value(value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+				if (!child_value_size)
+					return 0;
+				object_size += child_value_size;
+			}
+			for (size_t c = fixed_child_value_count, i = 0; i != set_value_count; ++i)
+				if (set_value_table[i].value && set_value_table[i].path_length > node->depth && set_value_table[i].path[node->depth].container_type == JSONL_TYPE_ARRAY && set_value_table[i].path[node->depth].index == (size_t)~0 &&
+					jsonl_set_values_scan_has_prefix(set_value_table, i, node->prefix_index, node->depth))
+				{
+					size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
+					if (remaining_buffer_size)
+						value_buffer->array.table[c] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+					jsonl_set_values_scan_node(set_value_count, set_value_table, node->depth + 1, i, &child_node);
+					size_t child_value_size = jsonl_internal_set_values_create_scanned_value(set_value_count, set_value_table, &child_node, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
 					if (!child_value_size)
 						return 0;
 					object_size += child_value_size;
 					++c;
 				}
+			break;
+		}
+		default:
+			return jsonl_internal_copy_value(source_value, parent, value_buffer_size, value_buffer);
+	}
+	if (object_size <= value_buffer_size)
+	{
+		value_buffer->size = object_size;
+		value_buffer->parent = (jsonl_value_t*)parent;
+		value_buffer->type = source_value->type;
+	}
+	return object_size;
+}
+
+static JSONL_INLINE int jsonl_version_contains(const jsonl_version_t* version, const void* address)
+{
+	return (uintptr_t)address >= (uintptr_t)version && (uintptr_t)address - (uintptr_t)version < version->size;
+}
+
+static size_t jsonl_version_subtree_oldest_shared_epoch(const jsonl_version_t* version, const jsonl_value_t* value)
+{
+	size_t low = 0;
+	size_t high = version->subtree_count;
+	while (low != high)
+	{
+		size_t middle = low + ((high - low) / 2);
+		if (version->subtree_table[middle].value == value)
+			return version->subtree_table[middle].oldest_shared_epoch;
+		if ((uintptr_t)version->subtree_table[middle].value < (uintptr_t)value)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return version->epoch;
+}
+
+static size_t jsonl_version_shared_value_epoch(const jsonl_version_t* base_version, const jsonl_value_t* value)
+{
+	// Most shared values are usually in the oldest version, so it is checked before the versions between it and the base version.
+	if (jsonl_version_contains(base_version->oldest_shared_version, value))
+		return jsonl_version_subtree_oldest_shared_epoch(base_version->oldest_shared_version, value);
+	for (const jsonl_version_t* version = base_version;; version = version->base_version)
+	{
+		if (jsonl_version_contains(version, value))
+			return jsonl_version_subtree_oldest_shared_epoch(version, value);
+		if (!version->base_version || version->epoch <= base_version->oldest_shared_epoch)
+			break;
+	}
+	// Every shared value is in a version the base version refers to, but the oldest epoch of the base version is a safe bound for any value.
+	return base_version->oldest_shared_epoch;
+}
+
+static size_t jsonl_internal_create_version_subtree_table(const jsonl_version_t* version, const jsonl_version_t* base_version, const jsonl_value_t* value, jsonl_version_subtree_t* subtree_table, size_t* subtree_count)
+{
+	size_t oldest_shared_epoch = version->epoch;
+	size_t first_subtree_index = *subtree_count;
+	size_t child_count = (value->type == JSONL_TYPE_OBJECT) ? value->object.value_count : ((value->type == JSONL_TYPE_ARRAY) ? value->array.value_count : 0);
+	for (size_t i = 0; i != child_count; ++i)
+	{
+		const jsonl_value_t* child_value = (value->type == JSONL_TYPE_OBJECT) ? value->object.table[i].value : value->array.table[i];
+		size_t child_oldest_shared_epoch = jsonl_version_contains(version, child_value) ?
+			jsonl_internal_create_version_subtree_table(version, base_version, child_value, subtree_table, subtree_count) :
+			jsonl_version_shared_value_epoch(base_version, child_value);
+		if (child_oldest_shared_epoch < oldest_shared_epoch)
+			oldest_shared_epoch = child_oldest_shared_epoch;
+	}
+	if (oldest_shared_epoch != version->epoch)
+	{
+		// The value is before its child values in the buffer, so it is inserted before the entries of its child values to keep the table sorted by address.
+		for (size_t i = *subtree_count; i != first_subtree_index; --i)
+			subtree_table[i] = subtree_table[i - 1];
+		subtree_table[first_subtree_index].value = value;
+		subtree_table[first_subtree_index].oldest_shared_epoch = oldest_shared_epoch;
+		*subtree_count += 1;
+	}
+	return oldest_shared_epoch;
+}
+
+size_t jsonl_create_version(const jsonl_value_t* value_tree, size_t epoch, size_t version_buffer_size, jsonl_version_t* version_buffer)
+{
+	size_t version_size = jsonl_round_size(sizeof(jsonl_version_t));
+	size_t remaining_buffer_size = (version_size <= version_buffer_size) ? (version_buffer_size - version_size) : 0;
+	jsonl_value_t* version_value_tree = (jsonl_value_t*)((uintptr_t)version_buffer + version_size);
+	size_t value_tree_size = jsonl_internal_copy_value(value_tree, 0, remaining_buffer_size, version_value_tree);
+	if (!value_tree_size)
+		return 0;
+	version_size += value_tree_size;
+	if (version_size <= version_buffer_size)
+	{
+		version_buffer->size = version_size;
+		version_buffer->epoch = epoch;
+		version_buffer->oldest_shared_epoch = epoch;
+		version_buffer->value_tree = version_value_tree;
+		version_buffer->base_version = 0;
+		version_buffer->oldest_shared_version = version_buffer;
+		version_buffer->subtree_count = 0;
+		version_buffer->subtree_table = 0;
+	}
+	return version_size;
+}
+
+size_t jsonl_create_next_version(const jsonl_version_t* base_version, const jsonl_set_values_plan_t* plan, size_t version_buffer_size, jsonl_version_t* version_buffer)
+{
+	// Only values created for nodes of the plan can share values, so the subtree table can not have more entries than the plan has nodes.
+	size_t version_size = jsonl_round_size(sizeof(jsonl_version_t));
+	jsonl_version_subtree_t* subtree_table = (jsonl_version_subtree_t*)((uintptr_t)version_buffer + version_size);
+	version_size += jsonl_round_size(plan->node_count * sizeof(jsonl_version_subtree_t));
+	size_t remaining_buffer_size = (version_size <= version_buffer_size) ? (version_buffer_size - version_size) : 0;
+	jsonl_value_t* version_value_tree = (jsonl_value_t*)((uintptr_t)version_buffer + version_size);
+	size_t value_tree_size = jsonl_set_values_shared(base_version->value_tree, plan, remaining_buffer_size, version_value_tree);
+	if (!value_tree_size)
+		return 0;
+	version_size += value_tree_size;
+	if (version_size <= version_buffer_size)
+	{
+		version_buffer->size = version_size;
+		version_buffer->epoch = base_version->epoch + 1;
+		version_buffer->value_tree = version_value_tree;
+		version_buffer->base_version = base_version;
+		size_t subtree_count = 0;
+		size_t oldest_shared_epoch = jsonl_internal_create_version_subtree_table(version_buffer, base_version, version_value_tree, subtree_table, &subtree_count);
+		JSONL_ASSERT(subtree_count <= plan->node_count);
+		const jsonl_version_t* oldest_shared_version = version_buffer;
+		if (oldest_shared_epoch == base_version->oldest_shared_epoch)
+			oldest_shared_version = base_version->oldest_shared_version;
+		else if (oldest_shared_epoch != version_buffer->epoch)
+		{
+			oldest_shared_version = base_version;
+			while (oldest_shared_version->epoch != oldest_shared_epoch && oldest_shared_version->epoch > base_version->oldest_shared_epoch && oldest_shared_version->base_version)
+				oldest_shared_version = oldest_shared_version->base_version;
+			if (oldest_shared_version->epoch != oldest_shared_epoch)
+			{
+				oldest_shared_epoch = base_version->oldest_shared_epoch;
+				oldest_shared_version = base_version->oldest_shared_version;
+			}
+		}
+		version_buffer->oldest_shared_epoch = oldest_shared_epoch;
+		version_buffer->oldest_shared_version = oldest_shared_version;
+		version_buffer->subtree_count = subtree_count;
+		version_buffer->subtree_table = subtree_table;
+	}
+	return version_size;
+}
+
+static uint64_t jsonl_internal_create_tree_hash(const jsonl_value_t* value, jsonl_tree_hash_node_t* node_table, size_t node_index, size_t* node_count)
+{
+	uint64_t hash = jsonl_mix_hash_64((uint64_t)value->type);
+	node_table[node_index].child_index = 0;
+	switch (value->type)
+	{
+		case JSONL_TYPE_OBJECT:
+		{
+			// Members are summed, so objects that differ only by order of members have the same hash.
+			size_t child_index = *node_count;
+			*node_count += value->object.value_count;
+			node_table[node_index].child_index = child_index;
+			uint64_t member_hash_sum = 0;
+			for (size_t i = 0; i != value->object.value_count; ++i)
+			{
+				uint64_t name_hash = jsonl_hash_bytes_64((uint64_t)0xCBF29CE484222325, value->object.table[i].name_length, value->object.table[i].name);
+				uint64_t child_hash = jsonl_internal_create_tree_hash(value->object.table[i].value, node_table, child_index + i, node_count);
+				member_hash_sum += jsonl_mix_hash_64(name_hash ^ jsonl_mix_hash_64(child_hash + (uint64_t)0x9E3779B97F4A7C15));
+			}
+			hash = jsonl_mix_hash_64(hash ^ member_hash_sum ^ (uint64_t)value->object.value_count);
+			break;
+		}
+		case JSONL_TYPE_ARRAY:
+		{
+			size_t child_index = *node_count;
+			*node_count += value->array.value_count;
+			node_table[node_index].child_index = child_index;
+			for (size_t i = 0; i != value->array.value_count; ++i)
+				hash = jsonl_mix_hash_64(hash + jsonl_internal_create_tree_hash(value->array.table[i], node_table, child_index + i, node_count));
+			break;
+		}
+		case JSONL_TYPE_STRING:
+			hash = jsonl_mix_hash_64(hash ^ jsonl_hash_bytes_64((uint64_t)0xCBF29CE484222325, value->string.length, value->string.value));
+			break;
+		case JSONL_TYPE_NUMBER:
+		{
+			// Zero is hashed without its sign, because negative zero is equal to zero.
+#ifdef JSONL_FIXED_POINT_NUMBER_FORMAT
+			int negative = value->number.sign && (value->number.integer || value->number.fraction);
+			hash = jsonl_mix_hash_64(hash ^ jsonl_mix_hash_64(value->number.integer + (uint64_t)negative) ^ value->number.fraction);
+#else
+			double number = (value->number.value != 0.0) ? value->number.value : 0.0;
+			uint64_t number_bits = 0;
+			jsonl_copy_memory(&number_bits, &number, sizeof(double));
+			hash = jsonl_mix_hash_64(hash ^ number_bits);
+#endif
+			break;
+		}
+		case JSONL_TYPE_BOOLEAN:
+			hash = jsonl_mix_hash_64(hash ^ (value->boolean.value ? (uint64_t)1 : (uint64_t)2));
+			break;
+		default:
+			break;
+	}
+	node_table[node_index].hash = hash;
+	return hash;
+}
+
+static size_t jsonl_count_tree_values(const jsonl_value_t* value)
+{
+	size_t value_count = 1;
+	if (value->type == JSONL_TYPE_OBJECT)
+		for (size_t i = 0; i != value->object.value_count; ++i)
+			value_count += jsonl_count_tree_values(value->object.table[i].value);
+	else if (value->type == JSONL_TYPE_ARRAY)
+		for (size_t i = 0; i != value->array.value_count; ++i)
+			value_count += jsonl_count_tree_values(value->array.table[i]);
+	return value_count;
+}
+
+static void jsonl_writer_write_json_pointer_components(jsonl_writer_t* writer, const jsonl_internal_path_t* path)
+{
+	if (!path->depth)
+		return;
+	jsonl_writer_write_json_pointer_components(writer, path->parent);
+	jsonl_writer_write_data(writer, 1, "/");
+	if (path->path_component.container_type == JSONL_TYPE_ARRAY)
+	{
+		char index_text[24];
+		size_t index_length = 0;
+		for (size_t index = path->path_component.index; !index_length || index; index /= 10)
+			index_text[sizeof(index_text) - ++index_length] = (char)('0' + (index % 10));
+		jsonl_writer_write_data(writer, index_length, index_text + sizeof(index_text) - index_length);
+		return;
+	}
+	const char* name = path->path_component.name.value;
+	const char* end = name + path->path_component.name.length;
+	for (const char* read = name; read != end; ++read)
+		if (*read == '~' || *read == '/')
+		{
+			jsonl_writer_write_escaped_string(writer, (size_t)(read - name), name);
+			jsonl_writer_write_data(writer, 2, (*read == '~') ? "~0" : "~1");
+			name = read + 1;
+		}
+	jsonl_writer_write_escaped_string(writer, (size_t)(end - name), name);
+}
+
+static void jsonl_diff_emit(jsonl_internal_diff_context_t* context, const jsonl_internal_path_t* path, int operation, const jsonl_value_t* value)
+{
+	if (context->writer)
+	{
+		static const char* operation_name_table[] = { "add", "remove", "replace" };
+		const char* operation_name = operation_name_table[operation - JSONL_JSON_PATCH_ADD];
+		jsonl_writer_t* writer = context->writer;
+		jsonl_writer_begin_object(writer);
+		jsonl_writer_key(writer, 2, "op");
+		jsonl_writer_string(writer, jsonl_string_length(operation_name), operation_name);
+		jsonl_writer_key(writer, 4, "path");
+		if (jsonl_writer_begin_value(writer))
+		{
+			jsonl_writer_write_data(writer, 1, "\"");
+			jsonl_writer_write_json_pointer_components(writer, path);
+			jsonl_writer_write_data(writer, 1, "\"");
+		}
+		if (operation != JSONL_JSON_PATCH_REMOVE)
+		{
+			jsonl_writer_key(writer, 5, "value");
+			jsonl_writer_value(writer, value);
+		}
+		jsonl_writer_end(writer);
+		return;
+	}
+	if (context->set_value_table)
+	{
+		jsonl_path_component_t* path_table = context->path_component_table + context->path_component_count;
+		for (const jsonl_internal_path_t* iterator = path; iterator->depth; iterator = iterator->parent)
+			path_table[iterator->depth - 1] = iterator->path_component;
+		jsonl_set_value_t* set_value = context->set_value_table + context->set_value_count;
+		set_value->path_length = path->depth;
+		set_value->path = path_table;
+		set_value->value = (operation != JSONL_JSON_PATCH_REMOVE) ? value : 0;
+	}
+	context->set_value_count++;
+	context->path_component_count += path->depth;
+}
+
+static void jsonl_internal_diff(jsonl_internal_diff_context_t* context, size_t node_a, const jsonl_value_t* value_a, size_t node_b, const jsonl_value_t* value_b, const jsonl_internal_path_t* path)
+{
+	const jsonl_tree_hash_node_t* node_table_a = context->tree_hash_a->node_table;
+	const jsonl_tree_hash_node_t* node_table_b = context->tree_hash_b->node_table;
+	if (node_table_a[node_a].hash == node_table_b[node_b].hash)
+		return;
+	if (value_a->type != value_b->type || (value_a->type != JSONL_TYPE_OBJECT && value_a->type != JSONL_TYPE_ARRAY))
+	{
+		jsonl_diff_emit(context, path, JSONL_JSON_PATCH_REPLACE, value_b);
+		return;
+	}
+
+	jsonl_internal_path_t child_path;
+	child_path.parent = (jsonl_internal_path_t*)path;
+	child_path.depth = path->depth + 1;
+	child_path.path_component.container_type = value_a->type;
+	size_t child_a = node_table_a[node_a].child_index;
+	size_t child_b = node_table_b[node_b].child_index;
+	if (value_a->type == JSONL_TYPE_OBJECT)
+	{
+		for (size_t i = 0; i != value_a->object.value_count; ++i)
+			if (jsonl_find_object_member(value_b, value_a->object.table[i].name_length, value_a->object.table[i].name) == (size_t)~0)
+			{
+				child_path.path_component.name.length = value_a->object.table[i].name_length;
+				child_path.path_component.name.value = value_a->object.table[i].name;
+				jsonl_diff_emit(context, &child_path, JSONL_JSON_PATCH_REMOVE, 0);
+			}
+		for (size_t i = 0; i != value_b->object.value_count; ++i)
+		{
+			child_path.path_component.name.length = value_b->object.table[i].name_length;
+			child_path.path_component.name.value = value_b->object.table[i].name;
+			size_t member_index = jsonl_find_object_member(value_a, value_b->object.table[i].name_length, value_b->object.table[i].name);
+			if (member_index == (size_t)~0)
+				jsonl_diff_emit(context, &child_path, JSONL_JSON_PATCH_ADD, value_b->object.table[i].value);
+			else
+				jsonl_internal_diff(context, child_a + member_index, value_a->object.table[member_index].value, child_b + i, value_b->object.table[i].value, &child_path);
+		}
+		return;
+	}
+
+	// Equal elements at both ends are skipped and the elements between them are compared by position.
+	// Extra elements of the first array are removed from the end of the changed range and missing elements are written to the end of it,
+	// which keeps indices of the modifications valid both for jsonl_set_values and for sequentially applied JSON Patch operations.
+	size_t count_a = value_a->array.value_count;
+	size_t count_b = value_b->array.value_count;
+	size_t common_count = (count_a < count_b) ? count_a : count_b;
+	size_t prefix_count = 0;
+	while (prefix_count != common_count && node_table_a[child_a + prefix_count].hash == node_table_b[child_b + prefix_count].hash)
+		++prefix_count;
+	size_t suffix_count = 0;
+	while (prefix_count + suffix_count != common_count && node_table_a[child_a + count_a - 1 - suffix_count].hash == node_table_b[child_b + count_b - 1 - suffix_count].hash)
+		++suffix_count;
+	size_t changed_count_a = count_a - prefix_count - suffix_count;
+	size_t changed_count_b = count_b - prefix_count - suffix_count;
+	if (changed_count_a >= changed_count_b)
+	{
+		for (size_t i = prefix_count; i != prefix_count + changed_count_b; ++i)
+		{
+			child_path.path_component.index = i;
+			jsonl_internal_diff(context, child_a + i, value_a->array.table[i], child_b + i, value_b->array.table[i], &child_path);
+		}
+		for (size_t i = prefix_count + changed_count_a; i-- != prefix_count + changed_count_b;)
+		{
+			child_path.path_component.index = i;
+			jsonl_diff_emit(context, &child_path, JSONL_JSON_PATCH_REMOVE, 0);
+		}
+	}
+	else
+	{
+		for (size_t i = prefix_count; i != prefix_count + changed_count_a; ++i)
+		{
+			child_path.path_component.index = i;
+			jsonl_internal_diff(context, child_a + i, value_a->array.table[i], child_b + i, value_b->array.table[i], &child_path);
+		}
+		for (size_t i = prefix_count + changed_count_a; i != count_b; ++i)
+		{
+			child_path.path_component.index = i;
+			jsonl_diff_emit(context, &child_path, (i < count_a) ? JSONL_JSON_PATCH_REPLACE : JSONL_JSON_PATCH_ADD, value_b->array.table[i]);
+		}
+	}
+}
+
+size_t jsonl_create_tree_hash(const jsonl_value_t* value_tree, size_t tree_hash_buffer_size, jsonl_tree_hash_t* tree_hash_buffer)
+{
+	size_t node_count = jsonl_count_tree_values(value_tree);
+	size_t tree_hash_size = jsonl_round_size(sizeof(jsonl_tree_hash_t));
+	jsonl_tree_hash_node_t* node_table = (jsonl_tree_hash_node_t*)((uintptr_t)tree_hash_buffer + tree_hash_size);
+	tree_hash_size += jsonl_round_size(node_count * sizeof(jsonl_tree_hash_node_t));
+	if (tree_hash_size > tree_hash_buffer_size)
+		return tree_hash_size;
+	size_t used_node_count = 1;
+	jsonl_internal_create_tree_hash(value_tree, node_table, 0, &used_node_count);
+	JSONL_ASSERT(used_node_count == node_count);
+	tree_hash_buffer->size = tree_hash_size;
+	tree_hash_buffer->value_tree = value_tree;
+	tree_hash_buffer->node_count = node_count;
+	tree_hash_buffer->node_table = node_table;
+	return tree_hash_size;
+}
+
+size_t jsonl_diff(const jsonl_tree_hash_t* tree_hash_a, const jsonl_tree_hash_t* tree_hash_b, size_t diff_buffer_size, jsonl_diff_t* diff_buffer)
+{
+	jsonl_internal_path_t root_path;
+	root_path.parent = 0;
+	root_path.depth = 0;
+	root_path.path_component.container_type = 0;
+
+	jsonl_internal_diff_context_t context;
+	context.tree_hash_a = tree_hash_a;
+	context.tree_hash_b = tree_hash_b;
+	context.set_value_count = 0;
+	context.path_component_count = 0;
+	context.set_value_table = 0;
+	context.path_component_table = 0;
+	context.writer = 0;
+	jsonl_internal_diff(&context, 0, tree_hash_a->value_tree, 0, tree_hash_b->value_tree, &root_path);
+
+	size_t diff_size = jsonl_round_size(sizeof(jsonl_diff_t));
+	jsonl_set_value_t* set_value_table = (jsonl_set_value_t*)((uintptr_t)diff_buffer + diff_size);
+	diff_size += jsonl_round_size(context.set_value_count * sizeof(jsonl_set_value_t));
+	jsonl_path_component_t* path_component_table = (jsonl_path_component_t*)((uintptr_t)diff_buffer + diff_size);
+	diff_size += jsonl_round_size(context.path_component_count * sizeof(jsonl_path_component_t));
+	if (diff_size > diff_buffer_size)
+		return diff_size;
+
+	size_t set_value_count = context.set_value_count;
+	context.set_value_count = 0;
+	context.path_component_count = 0;
+	context.set_value_table = set_value_table;
+	context.path_component_table = path_component_table;
+	jsonl_internal_diff(&context, 0, tree_hash_a->value_tree, 0, tree_hash_b->value_tree, &root_path);
+	JSONL_ASSERT(context.set_value_count == set_value_count);
+	diff_buffer->size = diff_size;
+	diff_buffer->set_value_count = set_value_count;
+	diff_buffer->set_value_table = set_value_table;
+	return diff_size;
+}
+
+int jsonl_write_json_patch_diff(const jsonl_tree_hash_t* tree_hash_a, const jsonl_tree_hash_t* tree_hash_b, jsonl_writer_t* writer)
+{
+	jsonl_internal_path_t root_path;
+	root_path.parent = 0;
+	root_path.depth = 0;
+	root_path.path_component.container_type = 0;
+
+	jsonl_internal_diff_context_t context;
+	context.tree_hash_a = tree_hash_a;
+	context.tree_hash_b = tree_hash_b;
+	context.set_value_count = 0;
+	context.path_component_count = 0;
+	context.set_value_table = 0;
+	context.path_component_table = 0;
+	context.writer = writer;
+	if (!jsonl_writer_begin_array(writer))
+		return 0;
+	jsonl_internal_diff(&context, 0, tree_hash_a->value_tree, 0, tree_hash_b->value_tree, &root_path);
+	return jsonl_writer_end(writer);
+}
+
+int jsonl_value_equal(const jsonl_value_t* value_a, const jsonl_value_t* value_b)
+{
+	if (value_a == value_b)
+		return 1;
+	if (value_a->type != value_b->type)
+		return 0;
+	switch (value_a->type)
+	{
+		case JSONL_TYPE_OBJECT:
+		{
+			if (value_a->object.value_count != value_b->object.value_count)
+				return 0;
+			for (size_t i = 0; i != value_a->object.value_count; ++i)
+			{
+				size_t member_index = jsonl_find_matching_object_member(value_a, i, value_b);
+				if (member_index == (size_t)~0 || !jsonl_value_equal(value_a->object.table[i].value, value_b->object.table[member_index].value))
+					return 0;
+			}
+			return 1;
+		}
+		case JSONL_TYPE_ARRAY:
+		{
+			if (value_a->array.value_count != value_b->array.value_count)
+				return 0;
+			for (size_t i = 0; i != value_a->array.value_count; ++i)
+				if (!jsonl_value_equal(value_a->array.table[i], value_b->array.table[i]))
+					return 0;
+			return 1;
+		}
+		case JSONL_TYPE_STRING:
+			return value_a->string.length == value_b->string.length && jsonl_memory_compare(value_a->string.value, value_b->string.value, value_a->string.length);
+		case JSONL_TYPE_NUMBER:
+			return jsonl_number_equal(&value_a->number, &value_b->number);
+		case JSONL_TYPE_BOOLEAN:
+			return !value_a->boolean.value == !value_b->boolean.value;
+		default:
+			return 1;
+	}
+}
+
+static int jsonl_internal_tree_hash_value_equal(const jsonl_tree_hash_node_t* node_table_a, size_t node_index_a, const jsonl_value_t* value_a, const jsonl_tree_hash_node_t* node_table_b, size_t node_index_b, const jsonl_value_t* value_b)
+{
+	// Equal values always have equal hashes, so the structure is compared only when the hashes match.
+	if (value_a == value_b)
+		return 1;
+	if (node_table_a[node_index_a].hash != node_table_b[node_index_b].hash || value_a->type != value_b->type)
+		return 0;
+	size_t child_index_a = node_table_a[node_index_a].child_index;
+	size_t child_index_b = node_table_b[node_index_b].child_index;
+	switch (value_a->type)
+	{
+		case JSONL_TYPE_OBJECT:
+		{
+			if (value_a->object.value_count != value_b->object.value_count)
+				return 0;
+			for (size_t i = 0; i != value_a->object.value_count; ++i)
+			{
+				size_t member_index = jsonl_find_matching_object_member(value_a, i, value_b);
+				if (member_index == (size_t)~0 || !jsonl_internal_tree_hash_value_equal(node_table_a, child_index_a + i, value_a->object.table[i].value, node_table_b, child_index_b + member_index, value_b->object.table[member_index].value))
+					return 0;
+			}
+			return 1;
+		}
+		case JSONL_TYPE_ARRAY:
+		{
+			if (value_a->array.value_count != value_b->array.value_count)
+				return 0;
+			for (size_t i = 0; i != value_a->array.value_count; ++i)
+				if (!jsonl_internal_tree_hash_value_equal(node_table_a, child_index_a + i, value_a->array.table[i], node_table_b, child_index_b + i, value_b->array.table[i]))
+					return 0;
+			return 1;
+		}
+		default:
+			return jsonl_value_equal(value_a, value_b);
+	}
+}
+
+int jsonl_tree_hash_equal(const jsonl_tree_hash_t* tree_hash_a, const jsonl_tree_hash_t* tree_hash_b)
+{
+	return jsonl_internal_tree_hash_value_equal(tree_hash_a->node_table, 0, tree_hash_a->value_tree, tree_hash_b->node_table, 0, tree_hash_b->value_tree);
+}
+
+static int jsonl_internal_compact_value_equal(const jsonl_tree_hash_node_t* node_table, size_t node_index_a, const jsonl_value_t* value_a, size_t node_index_b, const jsonl_value_t* value_b)
+{
+	// Shared values must print identically, so unlike jsonl_value_equal the members of objects are compared in order.
+	if (value_a == value_b)
+		return 1;
+	if (node_table[node_index_a].hash != node_table[node_index_b].hash || value_a->type != value_b->type)
+		return 0;
+	size_t child_index_a = node_table[node_index_a].child_index;
+	size_t child_index_b = node_table[node_index_b].child_index;
+	switch (value_a->type)
+	{
+		case JSONL_TYPE_OBJECT:
+		{
+			if (value_a->object.value_count != value_b->object.value_count)
+				return 0;
+			for (size_t i = 0; i != value_a->object.value_count; ++i)
+			{
+				size_t name_length = value_a->object.table[i].name_length;
+				if (name_length != value_b->object.table[i].name_length ||
+					(value_a->object.table[i].name != value_b->object.table[i].name && !jsonl_memory_compare(value_a->object.table[i].name, value_b->object.table[i].name, name_length)) ||
+					!jsonl_internal_compact_value_equal(node_table, child_index_a + i, value_a->object.table[i].value, child_index_b + i, value_b->object.table[i].value))
+					return 0;
+			}
+			return 1;
+		}
+		case JSONL_TYPE_ARRAY:
+		{
+			if (value_a->array.value_count != value_b->array.value_count)
+				return 0;
+			for (size_t i = 0; i != value_a->array.value_count; ++i)
+				if (!jsonl_internal_compact_value_equal(node_table, child_index_a + i, value_a->array.table[i], child_index_b + i, value_b->array.table[i]))
+					return 0;
+			return 1;
+		}
+		default:
+			return jsonl_value_equal(value_a, value_b);
+	}
+}
+
+static size_t jsonl_internal_compact_value(const jsonl_internal_compact_context_t* context, size_t node_index, const jsonl_value_t* value, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer, jsonl_value_t** compact_value)
+{
+	*compact_value = 0;
+	uint64_t hash = context->node_table[node_index].hash;
+	for (size_t entry_index = (size_t)hash & context->entry_mask;; entry_index = (entry_index + 1) & context->entry_mask)
+	{
+		jsonl_internal_compact_entry_t* entry = context->entry_table + entry_index;
+		if (!entry->source_value)
+		{
+			entry->hash = hash;
+			entry->node_index = node_index;
+			entry->source_value = value;
+			entry->value = value_buffer;
+			break;
+		}
+		if (jsonl_internal_compact_value_equal(context->node_table, entry->node_index, entry->source_value, node_index, value))
+		{
+			*compact_value = entry->value;
+			return 0;
+		}
+	}
+
+	size_t child_index = context->node_table[node_index].child_index;
+	size_t object_size = jsonl_round_size(sizeof(jsonl_value_t));
+	switch (value->type)
+	{
+		case JSONL_TYPE_OBJECT:
+		{
+			size_t object_table_size = jsonl_round_size(value->object.value_count * sizeof(*value->object.table));
+			uintptr_t index_content = (uintptr_t)value_buffer + object_size + object_table_size;
+			object_table_size += jsonl_object_index_size(value->object.value_count);
+			if (object_size <= value_buffer_size)
+			{
+				value_buffer->object.value_count = value->object.value_count;
+				*(void**)&value_buffer->object.table = (void*)((uintptr_t)value_buffer + object_size);
+			}
+			for (size_t i = 0; i != value->object.value_count; ++i)
+			{
+				size_t name_size = jsonl_round_size(value->object.table[i].name_length + 1);
+				if (object_size + object_table_size + name_size <= value_buffer_size)
+				{
+					value_buffer->object.table[i].name_length = value->object.table[i].name_length;
+					value_buffer->object.table[i].name = (char*)((uintptr_t)value_buffer + object_size + object_table_size);
+					jsonl_copy_memory((void*)((uintptr_t)value_buffer + object_size + object_table_size), value->object.table[i].name, value->object.table[i].name_length + 1);
+				}
+				object_table_size += name_size;
+			}
+			object_size += object_table_size;
+			for (size_t i = 0; i != value->object.value_count; ++i)
+			{
+				jsonl_value_t* sub_value;
+				size_t remaining_buffer_size = object_size < value_buffer_size ? value_buffer_size - object_size : 0;
+				size_t sub_value_size = jsonl_internal_compact_value(context, child_index + i, value->object.table[i].value, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size), &sub_value);
+				if (!sub_value)
+					return 0;
+				if (object_size <= value_buffer_size)
+					value_buffer->object.table[i].value = sub_value;
+				object_size += sub_value_size;
+			}
+			if (object_size <= value_buffer_size)
+				jsonl_create_object_index(value_buffer, (void*)index_content, value->object.index);
+			break;
+		}
+		case JSONL_TYPE_ARRAY:
+		{
+			size_t array_table_size = jsonl_round_size(value->array.value_count * sizeof(jsonl_value_t*));
+			if (object_size <= value_buffer_size)
+			{
+				value_buffer->array.value_count = value->array.value_count;
+				*(void**)&value_buffer->array.table = (void*)((uintptr_t)value_buffer + object_size);
+			}
+			object_size += array_table_size;
+			for (size_t i = 0; i != value->array.value_count; ++i)
+			{
+				jsonl_value_t* sub_value;
+				size_t remaining_buffer_size = object_size < value_buffer_size ? value_buffer_size - object_size : 0;
+				size_t sub_value_size = jsonl_internal_compact_value(context, child_index + i, value->array.table[i], value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size), &sub_value);
+				if (!sub_value)
+					return 0;
+				if (object_size <= value_buffer_size)
+					value_buffer->array.table[i] = sub_value;
+				object_size += sub_value_size;
+			}
+			break;
+		}
+		case JSONL_TYPE_STRING:
+		case JSONL_TYPE_NUMBER:
+		case JSONL_TYPE_BOOLEAN:
+		case JSONL_TYPE_NULL:
+			object_size = jsonl_internal_copy_value(value, parent, value_buffer_size, value_buffer);
+			*compact_value = value_buffer;
+			return object_size;
+		default:
+			return 0;
+	}
+
+	if (object_size <= value_buffer_size)
+	{
+		value_buffer->size = object_size;
+		value_buffer->parent = (jsonl_value_t*)parent;
+		value_buffer->type = value->type;
+	}
+	*compact_value = value_buffer;
+	return object_size;
+}
+
+size_t jsonl_compact_tree(const jsonl_tree_hash_t* tree_hash, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	size_t entry_count = 2;
+	while (entry_count < tree_hash->node_count * 2)
+		entry_count <<= 1;
+	size_t entry_table_size = jsonl_round_size(entry_count * sizeof(jsonl_internal_compact_entry_t));
+	if (value_buffer_size < entry_table_size)
+	{
+		// Without space for the table of values the size of the compacted tree is not known, a copy of the tree is never smaller.
+		size_t value_tree_size = jsonl_internal_copy_value(tree_hash->value_tree, 0, 0, 0);
+		return value_tree_size ? (entry_table_size + value_tree_size) : 0;
+	}
+
+	// The table of values is stored temporarily at the end of the buffer.
+	size_t value_tree_buffer_size = (value_buffer_size - entry_table_size) & ~jsonl_value_alignment_minus_one;
+	jsonl_internal_compact_context_t context;
+	context.node_table = tree_hash->node_table;
+	context.entry_mask = entry_count - 1;
+	context.entry_table = (jsonl_internal_compact_entry_t*)((uintptr_t)value_buffer + value_tree_buffer_size);
+	for (size_t i = 0; i != entry_count; ++i)
+		context.entry_table[i].source_value = 0;
+
+	jsonl_value_t* compact_value_tree;
+	size_t value_tree_size = jsonl_internal_compact_value(&context, 0, tree_hash->value_tree, 0, value_tree_buffer_size, value_buffer, &compact_value_tree);
+	if (!compact_value_tree)
+		return 0;
+	// The returned size includes the table, so the same size can always be given again as the size of the buffer.
+	return entry_table_size + value_tree_size;
+}
+
+size_t jsonl_set_values(const jsonl_value_t* value_tree, size_t set_value_count, const jsonl_set_value_t* set_value_table, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	size_t plan_buffer[JSONL_SET_VALUES_STACK_PLAN_SIZE / sizeof(size_t)];
+	size_t plan_size = jsonl_create_set_values_plan(set_value_count, set_value_table, sizeof(plan_buffer), (jsonl_set_values_plan_t*)plan_buffer);
+	if (!plan_size)
+		return 0;
+	if (plan_size <= sizeof(plan_buffer))
+		return jsonl_set_values_with_plan(value_tree, (const jsonl_set_values_plan_t*)plan_buffer, value_buffer_size, value_buffer);
+
+	// Modifications that do not fit to the plan on the stack are searched from the table at the values on their paths, so no other memory is needed.
+	jsonl_internal_set_values_scan_node_t root_node;
+	jsonl_set_values_scan_node(set_value_count, set_value_table, 0, (size_t)~0, &root_node);
+	return jsonl_internal_set_values_without_plan(set_value_count, set_value_table, &root_node, value_tree, 0, value_buffer_size, value_buffer);
+}
+
+static JSONL_INLINE int jsonl_builder_is_valid_handle(const jsonl_builder_t* builder, size_t value)
+{
+	return value && value <= builder->arena_used - sizeof(jsonl_internal_builder_node_t) && !(value & jsonl_value_alignment_minus_one);
+}
+
+static JSONL_INLINE jsonl_internal_builder_node_t* jsonl_builder_node(const jsonl_builder_t* builder, size_t value)
+{
+	JSONL_ASSERT(value && value < builder->arena_used);
+	return (jsonl_internal_builder_node_t*)((uintptr_t)builder->arena + value);
+}
+
+static size_t jsonl_builder_allocate(jsonl_builder_t* builder, size_t size)
+{
+	if (builder->error)
+		return 0;
+	size = jsonl_round_size(size);
+	if (size > builder->arena_size - builder->arena_used)
+	{
+		size_t required_size = builder->arena_used + size;
+		if (!builder->reallocate_callback || required_size < size)
+		{
+			builder->error = 1;
+			return 0;
+		}
+		size_t new_arena_size = (builder->arena_size < JSONL_BUILDER_MINIMUM_ARENA_SIZE) ? JSONL_BUILDER_MINIMUM_ARENA_SIZE : builder->arena_size;
+		while (new_arena_size < required_size)
+			new_arena_size = (new_arena_size * 2 > new_arena_size) ? (new_arena_size * 2) : required_size;
+		void* new_arena = builder->reallocate_callback(builder->reallocate_context, builder->arena, builder->arena_size, new_arena_size);
+		if (!new_arena)
+		{
+			builder->error = 1;
+			return 0;
+		}
+		builder->arena_size = new_arena_size;
+		builder->arena = new_arena;
+	}
+	size_t offset = builder->arena_used;
+	builder->arena_used += size;
+	return offset;
+}
+
+static size_t jsonl_builder_allocate_string(jsonl_builder_t* builder, size_t string_length, const char* string)
+{
+	// The string may be inside the arena and the arena may move during the allocation.
+	int string_in_arena = (uintptr_t)string >= (uintptr_t)builder->arena && (uintptr_t)string < (uintptr_t)builder->arena + builder->arena_used;
+	size_t string_offset = (size_t)((uintptr_t)string - (uintptr_t)builder->arena);
+	size_t offset = jsonl_builder_allocate(builder, string_length + 1);
+	if (offset)
+	{
+		if (string_in_arena)
+			string = (const char*)((uintptr_t)builder->arena + string_offset);
+		char* string_copy = (char*)((uintptr_t)builder->arena + offset);
+		jsonl_copy_memory(string_copy, string, string_length);
+		string_copy[string_length] = 0;
+	}
+	return offset;
+}
+
+static void jsonl_builder_clear_node(jsonl_internal_builder_node_t* node, int value_type)
+{
+	node->type = value_type;
+	switch (value_type)
+	{
+		case JSONL_TYPE_OBJECT:
+		case JSONL_TYPE_ARRAY:
+			node->container.value_count = 0;
+			node->container.capacity = 0;
+			node->container.table = 0;
+			break;
+		case JSONL_TYPE_STRING:
+			node->string.length = 0;
+			node->string.capacity = 0;
+			node->string.value = 0;
+			break;
+		case JSONL_TYPE_NUMBER:
+#ifdef JSONL_FIXED_POINT_NUMBER_FORMAT
+			node->number.sign = 0;
+			node->number.integer = 0;
+			node->number.fraction = 0;
+#else
+			node->number.value = 0.0;
+#endif
+			break;
+		case JSONL_TYPE_BOOLEAN:
+			node->boolean = 0;
+			break;
+		default:
+			break;
+	}
+}
+
+static size_t jsonl_builder_create_node(jsonl_builder_t* builder, size_t parent, int value_type)
+{
+	if (value_type < JSONL_TYPE_OBJECT || value_type > JSONL_TYPE_NULL)
+		builder->error = 1;
+	size_t value = jsonl_builder_allocate(builder, sizeof(jsonl_internal_builder_node_t));
+	if (value)
+	{
+		jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, value);
+		node->parent = parent;
+		jsonl_builder_clear_node(node, value_type);
+	}
+	return value;
+}
+
+static size_t jsonl_builder_reserve_child(jsonl_builder_t* builder, size_t container_value, size_t entry_size)
+{
+	jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, container_value);
+	if (node->container.value_count == node->container.capacity)
+	{
+		// Tables grow by doubling and the old table is left unused in the arena, which keeps appending linear time.
+		size_t new_capacity = node->container.capacity ? (node->container.capacity * 2) : JSONL_BUILDER_MINIMUM_TABLE_CAPACITY;
+		if (new_capacity < node->container.capacity)
+		{
+			builder->error = 1;
+			return 0;
+		}
+		size_t new_table = jsonl_builder_allocate(builder, new_capacity * entry_size);
+		if (!new_table)
+			return 0;
+		node = jsonl_builder_node(builder, container_value);
+		if (node->container.value_count)
+			jsonl_copy_memory((void*)((uintptr_t)builder->arena + new_table), (const void*)((uintptr_t)builder->arena + node->container.table), node->container.value_count * entry_size);
+		node->container.capacity = new_capacity;
+		node->container.table = new_table;
+	}
+	return node->container.table + node->container.value_count++ * entry_size;
+}
+
+static size_t jsonl_internal_builder_finalize(const jsonl_builder_t* builder, size_t value, const jsonl_value_t* parent, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	const jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, value);
+	size_t object_size = jsonl_round_size(sizeof(jsonl_value_t));
+	switch (node->type)
+	{
+		case JSONL_TYPE_OBJECT:
+		{
+			const jsonl_internal_builder_member_t* member_table = (const jsonl_internal_builder_member_t*)((uintptr_t)builder->arena + node->container.table);
+			size_t value_count = node->container.value_count;
+			size_t object_table_size = jsonl_round_size(value_count * sizeof(*value_buffer->object.table));
+			uintptr_t index_content = (uintptr_t)value_buffer + object_size + object_table_size;
+			object_table_size += jsonl_object_index_size(value_count);
+			if (object_size <= value_buffer_size)
+			{
+				value_buffer->object.value_count = value_count;
+				*(void**)&value_buffer->object.table = (void*)((uintptr_t)value_buffer + object_size);
+			}
+			for (size_t i = 0; i != value_count; ++i)
+			{
+				size_t name_size = jsonl_round_size(member_table[i].name_length + 1);
+				if (object_size + object_table_size + name_size <= value_buffer_size)
+				{
+					value_buffer->object.table[i].name_length = member_table[i].name_length;
+					value_buffer->object.table[i].name = (char*)((uintptr_t)value_buffer + object_size + object_table_size);
+					jsonl_copy_memory(value_buffer->object.table[i].name, (const void*)((uintptr_t)builder->arena + member_table[i].name), member_table[i].name_length);
+					jsonl_terminator_string(value_buffer->object.table[i].name + member_table[i].name_length);
+				}
+				object_table_size += name_size;
 			}
-			for (size_t c = 0, i = 0; c != add_value_count; ++i)
-				if (set_value_table[i].value)
+			object_size += object_table_size;
+			for (size_t i = 0; i != value_count; ++i)
+			{
+				if (object_size <= value_buffer_size)
+					value_buffer->object.table[i].value = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+				size_t remaining_buffer_size = object_size < value_buffer_size ? value_buffer_size - object_size : 0;
+				size_t sub_value_size = jsonl_internal_builder_finalize(builder, member_table[i].value, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+				if (!sub_value_size)
+					return 0;
+				object_size += sub_value_size;
+			}
+			if (object_size <= value_buffer_size)
+				jsonl_create_object_index(value_buffer, (void*)index_content, 0);
+			break;
+		}
+		case JSONL_TYPE_ARRAY:
+		{
+			const size_t* element_table = (const size_t*)((uintptr_t)builder->arena + node->container.table);
+			size_t value_count = node->container.value_count;
+			if (object_size <= value_buffer_size)
+			{
+				value_buffer->array.value_count = value_count;
+				*(void**)&value_buffer->array.table = (void*)((uintptr_t)value_buffer + object_size);
+			}
+			object_size += jsonl_round_size(value_count * sizeof(jsonl_value_t*));
+			for (size_t i = 0; i != value_count; ++i)
+			{
+				if (object_size <= value_buffer_size)
+					value_buffer->array.table[i] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
+				size_t remaining_buffer_size = object_size < value_buffer_size ? value_buffer_size - object_size : 0;
+				size_t sub_value_size = jsonl_internal_builder_finalize(builder, element_table[i], value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
+				if (!sub_value_size)
+					return 0;
+				object_size += sub_value_size;
+			}
+			break;
+		}
+		case JSONL_TYPE_STRING:
+		{
+			size_t data_size = jsonl_round_size(node->string.length + 1);
+			if (object_size + data_size <= value_buffer_size)
+			{
+				value_buffer->string.length = node->string.length;
+				value_buffer->string.value = (char*)((uintptr_t)value_buffer + object_size);
+				if (node->string.length)
+					jsonl_copy_memory(value_buffer->string.value, (const void*)((uintptr_t)builder->arena + node->string.value), node->string.length);
+				jsonl_terminator_string(value_buffer->string.value + node->string.length);
+			}
+			object_size += data_size;
+			break;
+		}
+		case JSONL_TYPE_NUMBER:
+		{
+			if (object_size <= value_buffer_size)
+				value_buffer->number = node->number;
+			break;
+		}
+		case JSONL_TYPE_BOOLEAN:
+		{
+			if (object_size <= value_buffer_size)
+				value_buffer->boolean.value = node->boolean;
+			break;
+		}
+		case JSONL_TYPE_NULL:
+		{
+			break;
+		}
+		default:
+			return 0;
+	}
+
+	if (object_size <= value_buffer_size)
+	{
+		value_buffer->size = object_size;
+		value_buffer->parent = (jsonl_value_t*)parent;
+		value_buffer->type = node->type;
+	}
+	return object_size;
+}
+
+static size_t jsonl_builder_find_member(const jsonl_builder_t* builder, size_t object_value, size_t name_length, const char* name)
+{
+	const jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, object_value);
+	const jsonl_internal_builder_member_t* member_table = (const jsonl_internal_builder_member_t*)((uintptr_t)builder->arena + node->container.table);
+	size_t name_hash = jsonl_hash_name(name_length, name);
+	for (size_t i = 0; i != node->container.value_count; ++i)
+		if (member_table[i].name_hash == name_hash && member_table[i].name_length == name_length && jsonl_memory_compare((const void*)((uintptr_t)builder->arena + member_table[i].name), name, name_length))
+			return i;
+	return (size_t)~0;
+}
+
+static size_t jsonl_builder_get_child(const jsonl_builder_t* builder, size_t value, const jsonl_path_component_t* path_component)
+{
+	const jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, value);
+	if (node->type == JSONL_TYPE_OBJECT && path_component->container_type != JSONL_TYPE_ARRAY)
+	{
+		size_t member_index = jsonl_builder_find_member(builder, value, path_component->name.length, path_component->name.value);
+		if (member_index == (size_t)~0)
+			return 0;
+		return ((const jsonl_internal_builder_member_t*)((uintptr_t)builder->arena + node->container.table))[member_index].value;
+	}
+	else if (node->type == JSONL_TYPE_ARRAY && path_component->container_type != JSONL_TYPE_OBJECT)
+	{
+		if (path_component->index >= node->container.value_count)
+			return 0;
+		return ((const size_t*)((uintptr_t)builder->arena + node->container.table))[path_component->index];
+	}
+	return 0;
+}
+
+static int jsonl_builder_import_value(jsonl_builder_t* builder, size_t value, const jsonl_value_t* source_value)
+{
+	switch (source_value->type)
+	{
+		case JSONL_TYPE_OBJECT:
+		case JSONL_TYPE_ARRAY:
+		{
+			size_t value_count = (source_value->type == JSONL_TYPE_OBJECT) ? source_value->object.value_count : source_value->array.value_count;
+			size_t entry_size = (source_value->type == JSONL_TYPE_OBJECT) ? sizeof(jsonl_internal_builder_member_t) : sizeof(size_t);
+			if (value_count && ((source_value->type == JSONL_TYPE_OBJECT) ? !source_value->object.table : !source_value->array.table))
+				builder->error = 1;
+			size_t table = value_count ? jsonl_builder_allocate(builder, value_count * entry_size) : 0;
+			if (builder->error)
+				return 0;
+			jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, value);
+			jsonl_builder_clear_node(node, source_value->type);
+			node->container.capacity = value_count;
+			node->container.table = table;
+			for (size_t i = 0; i != value_count; ++i)
+			{
+				const jsonl_value_t* source_child = (source_value->type == JSONL_TYPE_OBJECT) ? source_value->object.table[i].value : source_value->array.table[i];
+				size_t name = 0;
+				if (source_value->type == JSONL_TYPE_OBJECT)
+					name = jsonl_builder_allocate_string(builder, source_value->object.table[i].name_length, source_value->object.table[i].name);
+				size_t child = jsonl_builder_create_node(builder, value, source_child->type);
+				if (!child || !jsonl_builder_import_value(builder, child, source_child))
+					return 0;
+				if (source_value->type == JSONL_TYPE_OBJECT)
 				{
-					JSONL_ASSERT(i < set_value_count);
-					int value_path_match = jsonl_internal_set_values_is_set_value_in_path(path, set_value_table + i);
-					if (value_path_match)
-					{
-						int set_value_in_child_value = 0;
-						if (source_value->type == set_value_table[i].path[path->depth].container_type)
-							for (size_t j = 0; !set_value_in_child_value && j != source_value->object.value_count; ++j)
-								if (source_value->object.table[j].name_length == set_value_table[i].path[path->depth].name.length && jsonl_memory_compare(source_value->object.table[j].name, set_value_table[i].path[path->depth].name.value, source_value->object.table[j].name_length))
-									set_value_in_child_value = 1;
-						if (!set_value_in_child_value)
-						{
-							if (set_value_table[i].path_length == path->depth + 1)
-							{
-								size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
-								if (remaining_buffer_size)
-									value_buffer->object.table[(source_value->object.value_count - remove_value_count) + c].value = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-								size_t child_value_size = jsonl_internal_copy_value(set_value_table[i].value, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
-								if (!child_value_size)
-									return 0;
-								object_size += child_value_size;
-								++c;
-							}
-							else
-							{
-								int set_value_already_counted = 0;
-								for (size_t j = 0; j != i; ++j)
-									if (jsonl_internal_set_values_input_path_compare(set_value_table + j, set_value_table + i, path->depth + 1))
-										set_value_already_counted = 1;
-								if (!set_value_already_counted)
-								{
-									size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
-									if (remaining_buffer_size)
-										value_buffer->object.table[(source_value->object.value_count - remove_value_count) + c].value = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-									size_t child_value_size = jsonl_internal_set_values_create_path(i, set_value_count, set_value_table, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size), path->depth + 1, value_buffer);
-									if (!child_value_size)
-										return 0;
-									object_size += child_value_size;
-									++c;
-								}
-							}
-						}
-					}
+					jsonl_internal_builder_member_t* member = (jsonl_internal_builder_member_t*)((uintptr_t)builder->arena + table) + i;
+					member->name_hash = jsonl_hash_name(source_value->object.table[i].name_length, source_value->object.table[i].name);
+					member->name_length = source_value->object.table[i].name_length;
+					member->name = name;
+					member->value = child;
 				}
+				else
+					((size_t*)((uintptr_t)builder->arena + table))[i] = child;
+
+				// The count is updated with every child so the value stays consistent even if the import fails.
+				jsonl_builder_node(builder, value)->container.value_count = i + 1;
+			}
+			return 1;
+		}
+		case JSONL_TYPE_STRING:
+			return jsonl_builder_set_string(builder, value, source_value->string.length, source_value->string.value);
+		case JSONL_TYPE_NUMBER:
+			return jsonl_builder_set_number(builder, value, &source_value->number);
+		case JSONL_TYPE_BOOLEAN:
+			return jsonl_builder_set_boolean(builder, value, source_value->boolean.value);
+		case JSONL_TYPE_NULL:
+			return jsonl_builder_set_null(builder, value);
+		default:
+			builder->error = 1;
+			return 0;
+	}
+}
+
+int jsonl_builder_initialize(jsonl_builder_t* builder, size_t arena_size, void* arena, jsonl_reallocate_callback_t reallocate_callback, void* reallocate_context)
+{
+	if (arena_size && !arena)
+		return 0;
+	if ((uintptr_t)arena & (uintptr_t)jsonl_value_alignment_minus_one)
+		return 0;
+	builder->arena_size = arena_size;
+	builder->arena_used = 0;
+	builder->arena = arena;
+	builder->reallocate_callback = reallocate_callback;
+	builder->reallocate_context = reallocate_context;
+	builder->root = 0;
+	builder->error = 0;
+
+	// The first alignment unit of the arena is never used for values, so zero is not a valid handle.
+	jsonl_builder_allocate(builder, 1);
+	return !builder->error;
+}
+
+size_t jsonl_builder_create_root(jsonl_builder_t* builder, int value_type)
+{
+	size_t value = jsonl_builder_create_node(builder, 0, value_type);
+	if (value)
+		builder->root = value;
+	return value;
+}
+
+size_t jsonl_builder_add_member(jsonl_builder_t* builder, size_t object_value, size_t name_length, const char* name, int value_type)
+{
+	if (builder->error || !jsonl_builder_is_valid_handle(builder, object_value) || jsonl_builder_node(builder, object_value)->type != JSONL_TYPE_OBJECT)
+	{
+		builder->error = 1;
+		return 0;
+	}
+	size_t name_offset = jsonl_builder_allocate_string(builder, name_length, name);
+	size_t value = jsonl_builder_create_node(builder, object_value, value_type);
+	size_t member_offset = jsonl_builder_reserve_child(builder, object_value, sizeof(jsonl_internal_builder_member_t));
+	if (!name_offset || !value || !member_offset)
+		return 0;
+	jsonl_internal_builder_member_t* member = (jsonl_internal_builder_member_t*)((uintptr_t)builder->arena + member_offset);
+	member->name_hash = jsonl_hash_name(name_length, (const char*)((uintptr_t)builder->arena + name_offset));
+	member->name_length = name_length;
+	member->name = name_offset;
+	member->value = value;
+	return value;
+}
+
+size_t jsonl_builder_push_element(jsonl_builder_t* builder, size_t array_value, int value_type)
+{
+	if (builder->error || !jsonl_builder_is_valid_handle(builder, array_value) || jsonl_builder_node(builder, array_value)->type != JSONL_TYPE_ARRAY)
+	{
+		builder->error = 1;
+		return 0;
+	}
+	size_t value = jsonl_builder_create_node(builder, array_value, value_type);
+	size_t element_offset = jsonl_builder_reserve_child(builder, array_value, sizeof(size_t));
+	if (!value || !element_offset)
+		return 0;
+	*(size_t*)((uintptr_t)builder->arena + element_offset) = value;
+	return value;
+}
+
+int jsonl_builder_set_string(jsonl_builder_t* builder, size_t value, size_t string_length, const char* string)
+{
+	if (!jsonl_builder_is_valid_handle(builder, value))
+		builder->error = 1;
+	if (builder->error)
+		return 0;
+	jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, value);
+	if (node->type == JSONL_TYPE_STRING && string_length <= node->string.capacity)
+	{
+		// The new string fits to the storage of the old string, so it is overwritten in place.
+		char* string_storage = (char*)((uintptr_t)builder->arena + node->string.value);
+		jsonl_copy_memory(string_storage, string, string_length);
+		string_storage[string_length] = 0;
+		node->string.length = string_length;
+		return 1;
+	}
+	size_t string_offset = jsonl_builder_allocate_string(builder, string_length, string);
+	if (!string_offset)
+		return 0;
+	node = jsonl_builder_node(builder, value);
+	node->type = JSONL_TYPE_STRING;
+	node->string.length = string_length;
+	node->string.capacity = string_length;
+	node->string.value = string_offset;
+	return 1;
+}
+
+int jsonl_builder_set_number(jsonl_builder_t* builder, size_t value, const jsonl_number_value_t* number_value)
+{
+	if (!jsonl_builder_is_valid_handle(builder, value))
+		builder->error = 1;
+	if (builder->error)
+		return 0;
+	jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, value);
+	node->type = JSONL_TYPE_NUMBER;
+	node->number = *number_value;
+	return 1;
+}
+
+int jsonl_builder_set_boolean(jsonl_builder_t* builder, size_t value, int boolean_value)
+{
+	if (!jsonl_builder_is_valid_handle(builder, value))
+		builder->error = 1;
+	if (builder->error)
+		return 0;
+	jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, value);
+	node->type = JSONL_TYPE_BOOLEAN;
+	node->boolean = boolean_value ? 1 : 0;
+	return 1;
+}
+
+int jsonl_builder_set_null(jsonl_builder_t* builder, size_t value)
+{
+	if (!jsonl_builder_is_valid_handle(builder, value))
+		builder->error = 1;
+	if (builder->error)
+		return 0;
+	jsonl_builder_node(builder, value)->type = JSONL_TYPE_NULL;
+	return 1;
+}
+
+size_t jsonl_builder_set_member(jsonl_builder_t* builder, size_t object_value, size_t name_length, const char* name, int value_type)
+{
+	if (builder->error || !jsonl_builder_is_valid_handle(builder, object_value) || jsonl_builder_node(builder, object_value)->type != JSONL_TYPE_OBJECT)
+	{
+		builder->error = 1;
+		return 0;
+	}
+	size_t member_index = jsonl_builder_find_member(builder, object_value, name_length, name);
+	if (member_index == (size_t)~0)
+		return jsonl_builder_add_member(builder, object_value, name_length, name, value_type);
+	size_t value = ((const jsonl_internal_builder_member_t*)((uintptr_t)builder->arena + jsonl_builder_node(builder, object_value)->container.table))[member_index].value;
+	return jsonl_builder_reset(builder, value, value_type) ? value : 0;
+}
+
+size_t jsonl_builder_insert_element(jsonl_builder_t* builder, size_t array_value, size_t index, int value_type)
+{
+	if (builder->error || !jsonl_builder_is_valid_handle(builder, array_value) || jsonl_builder_node(builder, array_value)->type != JSONL_TYPE_ARRAY || index > jsonl_builder_node(builder, array_value)->container.value_count)
+	{
+		builder->error = 1;
+		return 0;
+	}
+	size_t value = jsonl_builder_create_node(builder, array_value, value_type);
+	if (!value || !jsonl_builder_reserve_child(builder, array_value, sizeof(size_t)))
+		return 0;
+	jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, array_value);
+	size_t* element_table = (size_t*)((uintptr_t)builder->arena + node->container.table);
+	for (size_t i = node->container.value_count - 1; i != index; --i)
+		element_table[i] = element_table[i - 1];
+	element_table[index] = value;
+	return value;
+}
+
+int jsonl_builder_remove_member(jsonl_builder_t* builder, size_t object_value, size_t name_length, const char* name)
+{
+	if (builder->error || !jsonl_builder_is_valid_handle(builder, object_value) || jsonl_builder_node(builder, object_value)->type != JSONL_TYPE_OBJECT)
+	{
+		builder->error = 1;
+		return 0;
+	}
+	size_t member_index = jsonl_builder_find_member(builder, object_value, name_length, name);
+	if (member_index == (size_t)~0)
+		return 0;
+	jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, object_value);
+	jsonl_internal_builder_member_t* member_table = (jsonl_internal_builder_member_t*)((uintptr_t)builder->arena + node->container.table);
+	for (size_t i = member_index + 1; i != node->container.value_count; ++i)
+		member_table[i - 1] = member_table[i];
+	node->container.value_count--;
+	return 1;
+}
+
+int jsonl_builder_remove_element(jsonl_builder_t* builder, size_t array_value, size_t index)
+{
+	if (builder->error || !jsonl_builder_is_valid_handle(builder, array_value) || jsonl_builder_node(builder, array_value)->type != JSONL_TYPE_ARRAY)
+	{
+		builder->error = 1;
+		return 0;
+	}
+	jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, array_value);
+	if (index >= node->container.value_count)
+		return 0;
+	size_t* element_table = (size_t*)((uintptr_t)builder->arena + node->container.table);
+	for (size_t i = index + 1; i != node->container.value_count; ++i)
+		element_table[i - 1] = element_table[i];
+	node->container.value_count--;
+	return 1;
+}
+
+int jsonl_builder_reset(jsonl_builder_t* builder, size_t value, int value_type)
+{
+	if (!jsonl_builder_is_valid_handle(builder, value) || value_type < JSONL_TYPE_OBJECT || value_type > JSONL_TYPE_NULL)
+		builder->error = 1;
+	if (builder->error)
+		return 0;
+	jsonl_builder_clear_node(jsonl_builder_node(builder, value), value_type);
+	return 1;
+}
+
+int jsonl_builder_set_value(jsonl_builder_t* builder, size_t value, const jsonl_value_t* value_tree)
+{
+	if (!jsonl_builder_is_valid_handle(builder, value))
+		builder->error = 1;
+	if (builder->error)
+		return 0;
+	return jsonl_builder_import_value(builder, value, value_tree);
+}
+
+size_t jsonl_builder_load(jsonl_builder_t* builder, const jsonl_value_t* value_tree)
+{
+	size_t root = jsonl_builder_create_root(builder, JSONL_TYPE_NULL);
+	if (!root || !jsonl_builder_import_value(builder, root, value_tree))
+		return 0;
+	return root;
+}
+
+size_t jsonl_builder_get_value(const jsonl_builder_t* builder, size_t parent_value, size_t path_length, const jsonl_path_component_t* path_table, int required_value_type)
+{
+	if (builder->error || !jsonl_builder_is_valid_handle(builder, parent_value))
+		return 0;
+	size_t value = parent_value;
+	for (size_t i = 0; value && i != path_length; ++i)
+		value = jsonl_builder_get_child(builder, value, path_table + i);
+	if (!value || (required_value_type && jsonl_builder_node(builder, value)->type != required_value_type))
+		return 0;
+	return value;
+}
+
+int jsonl_builder_read_value(const jsonl_builder_t* builder, size_t value, jsonl_value_t* value_buffer)
+{
+	if (builder->error || !jsonl_builder_is_valid_handle(builder, value))
+		return 0;
+	const jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, value);
+	value_buffer->size = 0;
+	value_buffer->parent = 0;
+	value_buffer->type = node->type;
+	switch (node->type)
+	{
+		case JSONL_TYPE_OBJECT:
+			value_buffer->object.value_count = node->container.value_count;
+			value_buffer->object.table = 0;
+			value_buffer->object.index = 0;
 			break;
-		}
 		case JSONL_TYPE_ARRAY:
-		{
-			size_t remove_child_value_count = 0;
-			size_t set_child_value_count = 0;
-			size_t append_child_value_count = 0;
-			size_t set_child_value_highest_index = (size_t)~0;
-			for (size_t i = 0; i != set_value_count; ++i)
-			{
-				int value_path_match = jsonl_internal_set_values_is_set_value_in_path(path, set_value_table + i);
-				if (value_path_match && set_value_table[i].path_length > path->depth)
-				{
-					if (set_value_table[i].path[path->depth].index != (size_t)~0)
-					{
-						if (set_value_table[i].path_length == path->depth + 1)
-						{
-							if (set_value_table[i].value)
-							{
-								if (set_child_value_highest_index == (size_t)~0 || set_value_table[i].path[path->depth].index > set_child_value_highest_index)
-									set_child_value_highest_index = set_value_table[i].path[path->depth].index;
-								++set_child_value_count;
-							}
-							else if (set_value_table[i].path[path->depth].index < source_value->array.value_count)
-								++remove_child_value_count;
-						}
-						else
-						{
-							if (set_value_table[i].value)
-							{
-								int set_value_already_counted = 0;
-								for (size_t j = 0; !set_value_already_counted && j != i; ++j)
-									if (set_value_table[j].path_length == set_value_table[i].path_length &&
-										jsonl_internal_set_values_input_path_compare(set_value_table + j, set_value_table + i, path->depth) &&
-										set_value_table[j].path[path->depth].container_type == JSONL_TYPE_ARRAY &&
-										set_value_table[j].path[path->depth].index == set_value_table[i].path[path->depth].index)
-										set_value_already_counted = 1;
-								if (!set_value_already_counted)
-								{
-									if (set_child_value_highest_index == (size_t)~0 || set_value_table[i].path[path->depth].index > set_child_value_highest_index)
-										set_child_value_highest_index = set_value_table[i].path[path->depth].index;
-									++set_child_value_count;
-								}
-							}
-						}
-					}
-					else
-					{
-						if (set_value_table[i].value)
-							++append_child_value_count;
-					}
-				}
-			}
-			JSONL_ASSERT(remove_child_value_count <= source_value->array.value_count);
-			JSONL_ASSERT(set_child_value_count <= set_value_count);
-			JSONL_ASSERT(append_child_value_count <= set_value_count);
+			value_buffer->array.value_count = node->container.value_count;
+			value_buffer->array.table = 0;
+			break;
+		case JSONL_TYPE_STRING:
+			value_buffer->string.length = node->string.length;
+			value_buffer->string.value = node->string.value ? (char*)((uintptr_t)builder->arena + node->string.value) : (char*)"";
+			break;
+		case JSONL_TYPE_NUMBER:
+			value_buffer->number = node->number;
+			break;
+		case JSONL_TYPE_BOOLEAN:
+			value_buffer->boolean.value = node->boolean;
+			break;
+		default:
+			break;
+	}
+	return 1;
+}
 
-			size_t child_value_count = source_value->array.value_count - remove_child_value_count;
-			if (set_child_value_highest_index != (size_t)~0 && child_value_count < set_child_value_highest_index + 1)
-				child_value_count = set_child_value_highest_index + 1;
-			child_value_count += append_child_value_count;
+size_t jsonl_builder_finalize(const jsonl_builder_t* builder, size_t value_buffer_size, jsonl_value_t* value_buffer)
+{
+	if (builder->error || !builder->root)
+		return 0;
+	return jsonl_internal_builder_finalize(builder, builder->root, 0, value_buffer_size, value_buffer);
+}
 
-			size_t array_table_size = jsonl_round_size(child_value_count * sizeof(*value_buffer->array.table));
-			if (object_size + array_table_size <= value_buffer_size)
-			{
-				value_buffer->array.value_count = child_value_count;
-				*(void**)&value_buffer->array.table = (void*)((uintptr_t)value_buffer + object_size);
-			}
-			object_size += array_table_size;
-			for (size_t erased = 0, i = 0; i != (child_value_count - append_child_value_count); ++i)
-			{
-				size_t overwrite_set_value_index = (size_t)~0;
-				for (size_t set_value_index = 0; overwrite_set_value_index == (size_t)~0 && set_value_index != set_value_count; ++set_value_index)
-					if (set_value_table[set_value_index].value)
-					{
-						int value_path_match = jsonl_internal_set_values_is_set_value_in_path(path, set_value_table + set_value_index);
-						if (value_path_match)
-						{
-							if (source_value->type == set_value_table[set_value_index].path[path->depth].container_type)
-							{
-								if (set_value_table[set_value_index].path[path->depth].index == i)
-								{
+static int jsonl_builder_resolve_json_pointer(jsonl_builder_t* builder, const jsonl_value_t* json_pointer, jsonl_internal_patch_target_t* target)
+{
+	target->parent = 0;
+	target->index = (size_t)~0;
+	target->append = 0;
+	target->name_length = 0;
+	target->name = 0;
+	size_t json_pointer_length = json_pointer->string.length;
+	if (!json_pointer_length)
+		return 1;
+	if (*json_pointer->string.value != '/')
+		return 0;
 
-									overwrite_set_value_index = set_value_index;
-								}
-							}
-						}
-					}
-				if (overwrite_set_value_index == (size_t)~0)
-				{
-					for (int continue_erase = 1; continue_erase && i + erased < source_value->array.value_count;)
-					{
-						continue_erase = 0;
-						for (size_t set_value_index = 0; !continue_erase && set_value_index != set_value_count; ++set_value_index)
-							if (!set_value_table[set_value_index].value)
-							{
-								int value_path_match = jsonl_internal_set_values_is_set_value_in_path(path, set_value_table + set_value_index);
-								if (value_path_match)
-								{
-									if (source_value->type == set_value_table[set_value_index].path[path->depth].container_type)
-									{
-										if (set_value_table[set_value_index].path[path->depth].index == i + erased)
-										{
-											++erased;
-											continue_erase = 1;
-										}
-									}
-								}
-							}
-					}
+	// Decoded tokens are never longer than the pointer, so one scratch block holds each of them in turn.
+	size_t name = jsonl_builder_allocate(builder, json_pointer_length);
+	if (!name)
+		return 0;
+	const char* end = json_pointer->string.value + json_pointer_length;
+	const char* read = json_pointer->string.value;
+	for (size_t value = builder->root;;)
+	{
+		JSONL_ASSERT(read != end && *read == '/');
+		++read;
+		size_t token_size = 0;
+		while (read + token_size != end && read[token_size] != '/')
+			++token_size;
+		jsonl_path_component_t path_component;
+		path_component.container_type = 0;
+		if (!jsonl_decode_json_pointer_token(token_size, read, json_pointer_length, (char*)((uintptr_t)builder->arena + name), &path_component.name.length))
+			return 0;
+		if (read + token_size == end)
+		{
+			int container_type = jsonl_builder_node(builder, value)->type;
+			if (container_type != JSONL_TYPE_OBJECT && container_type != JSONL_TYPE_ARRAY)
+				return 0;
+			target->parent = value;
+			target->index = jsonl_decode_array_index(token_size, read);
+			target->append = token_size == 1 && *read == '-';
+			target->name_length = path_component.name.length;
+			target->name = name;
+			return 1;
+		}
+		path_component.name.value = (char*)((uintptr_t)builder->arena + name);
+		if (jsonl_builder_node(builder, value)->type == JSONL_TYPE_ARRAY)
+			path_component.index = jsonl_decode_array_index(token_size, read);
+		value = jsonl_builder_get_child(builder, value, &path_component);
+		if (!value)
+			return 0;
+		read += token_size;
+	}
+}
 
-					if (i + erased < source_value->array.value_count)
-					{
-						next_path.path_component.index = i;
-						next_path.value_type = source_value->array.table[i + erased]->type;
-						next_path.source_value = source_value->array.table[i + erased];
-						size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
-						if (remaining_buffer_size)
-							value_buffer->array.table[i] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-						size_t child_value_size = jsonl_internal_set_values(set_value_count, set_value_table, &next_path, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
-						if (!child_value_size)
-							return 0;
-						object_size += child_value_size;
-					}
-					else
-					{
-						size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
-						if (remaining_buffer_size)
-							value_buffer->array.table[i] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-						size_t child_value_size = jsonl_internal_create_null_value(value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
-						if (!child_value_size)
-							return 0;
-						object_size += child_value_size;
-					}
-				}
-				else
-				{
-					JSONL_ASSERT(set_value_table[overwrite_set_value_index].path[path->depth].index != (size_t)~0);
-					JSONL_ASSERT(set_value_table[overwrite_set_value_index].value);
+static size_t jsonl_builder_get_patch_target(const jsonl_builder_t* builder, const jsonl_internal_patch_target_t* target)
+{
+	if (!target->parent)
+		return builder->root;
+	jsonl_path_component_t path_component;
+	path_component.container_type = 0;
+	if (jsonl_builder_node(builder, target->parent)->type == JSONL_TYPE_ARRAY)
+		path_component.index = target->index;
+	else
+	{
+		path_component.name.length = target->name_length;
+		path_component.name.value = (char*)((uintptr_t)builder->arena + target->name);
+	}
+	return jsonl_builder_get_child(builder, target->parent, &path_component);
+}
 
-					if (set_value_table[overwrite_set_value_index].path_length > path->depth + 1)
-					{
-						if (i + erased < source_value->array.value_count)
-						{
-							next_path.path_component.index = i;
-							next_path.value_type = source_value->array.table[i + erased]->type;
-							next_path.source_value = source_value->array.table[i + erased];
-							size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
-							if (remaining_buffer_size)
-								value_buffer->array.table[i] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-							size_t child_value_size = jsonl_internal_set_values(set_value_count, set_value_table, &next_path, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
-							if (!child_value_size)
-								return 0;
-							object_size += child_value_size;
-						}
-						else
-						{
-							size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
-							if (remaining_buffer_size)
-								value_buffer->array.table[i] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-							size_t child_value_size = jsonl_internal_set_values_create_path(overwrite_set_value_index, set_value_count, set_value_table, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size), path->depth + 1, value_buffer);
-							if (!child_value_size)
-								return 0;
-							object_size += child_value_size;
-						}
-					}
-					else
-					{
-						size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
-						if (remaining_buffer_size)
-							value_buffer->array.table[i] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-						size_t child_value_size = jsonl_internal_copy_value(set_value_table[overwrite_set_value_index].value, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
-						if (!child_value_size)
-							return 0;
-						object_size += child_value_size;
-					}
-				}
-			}
-			for (size_t append_set_value_index_offset = 0, c = 0, i = 0; c != append_child_value_count; ++i)
+static int jsonl_builder_link_patch_target(jsonl_builder_t* builder, const jsonl_internal_patch_target_t* target, size_t value)
+{
+	jsonl_builder_node(builder, value)->parent = target->parent;
+	if (!target->parent)
+	{
+		builder->root = value;
+		return 1;
+	}
+	if (jsonl_builder_node(builder, target->parent)->type == JSONL_TYPE_OBJECT)
+	{
+		size_t member_index = jsonl_builder_find_member(builder, target->parent, target->name_length, (const char*)((uintptr_t)builder->arena + target->name));
+		if (member_index != (size_t)~0)
+		{
+			((jsonl_internal_builder_member_t*)((uintptr_t)builder->arena + jsonl_builder_node(builder, target->parent)->container.table))[member_index].value = value;
+			return 1;
+		}
+		size_t name_offset = jsonl_builder_allocate_string(builder, target->name_length, (const char*)((uintptr_t)builder->arena + target->name));
+		size_t member_offset = jsonl_builder_reserve_child(builder, target->parent, sizeof(jsonl_internal_builder_member_t));
+		if (!name_offset || !member_offset)
+			return 0;
+		jsonl_internal_builder_member_t* member = (jsonl_internal_builder_member_t*)((uintptr_t)builder->arena + member_offset);
+		member->name_hash = jsonl_hash_name(target->name_length, (const char*)((uintptr_t)builder->arena + name_offset));
+		member->name_length = target->name_length;
+		member->name = name_offset;
+		member->value = value;
+		return 1;
+	}
+	size_t index = target->append ? jsonl_builder_node(builder, target->parent)->container.value_count : target->index;
+	if (index > jsonl_builder_node(builder, target->parent)->container.value_count || !jsonl_builder_reserve_child(builder, target->parent, sizeof(size_t)))
+		return 0;
+	jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, target->parent);
+	size_t* element_table = (size_t*)((uintptr_t)builder->arena + node->container.table);
+	for (size_t i = node->container.value_count - 1; i != index; --i)
+		element_table[i] = element_table[i - 1];
+	element_table[index] = value;
+	return 1;
+}
+
+static int jsonl_builder_unlink_patch_target(jsonl_builder_t* builder, const jsonl_internal_patch_target_t* target)
+{
+	if (!target->parent)
+		return 0;
+	if (jsonl_builder_node(builder, target->parent)->type == JSONL_TYPE_OBJECT)
+		return jsonl_builder_remove_member(builder, target->parent, target->name_length, (const char*)((uintptr_t)builder->arena + target->name));
+	return jsonl_builder_remove_element(builder, target->parent, target->index);
+}
+
+static size_t jsonl_builder_copy_node(jsonl_builder_t* builder, size_t parent, size_t source_value)
+{
+	int value_type = jsonl_builder_node(builder, source_value)->type;
+	size_t value = jsonl_builder_create_node(builder, parent, value_type);
+	if (!value)
+		return 0;
+	switch (value_type)
+	{
+		case JSONL_TYPE_OBJECT:
+		case JSONL_TYPE_ARRAY:
+		{
+			size_t value_count = jsonl_builder_node(builder, source_value)->container.value_count;
+			size_t entry_size = (value_type == JSONL_TYPE_OBJECT) ? sizeof(jsonl_internal_builder_member_t) : sizeof(size_t);
+			size_t table = value_count ? jsonl_builder_allocate(builder, value_count * entry_size) : 0;
+			if (builder->error)
+				return 0;
+			jsonl_builder_node(builder, value)->container.capacity = value_count;
+			jsonl_builder_node(builder, value)->container.table = table;
+			for (size_t i = 0; i != value_count; ++i)
 			{
-				size_t append_set_value_index = (size_t)~0;
-				for (size_t set_value_index = append_set_value_index_offset; append_set_value_index == (size_t)~0 && set_value_index != set_value_count; ++set_value_index)
-					if (set_value_table[set_value_index].value)
-					{
-						int value_path_match = jsonl_internal_set_values_is_set_value_in_path(path, set_value_table + set_value_index);
-						if (value_path_match)
-						{
-							if (source_value->type == set_value_table[set_value_index].path[path->depth].container_type)
-							{
-								if (set_value_table[set_value_index].path[path->depth].index == (size_t)~0)
-								{
-									append_set_value_index = set_value_index;
-									append_set_value_index_offset = set_value_index + 1;
-								}
-							}
-						}
-					}
-				if (append_set_value_index != (size_t)~0)
+				size_t source_table = jsonl_builder_node(builder, source_value)->container.table;
+				size_t source_child = (value_type == JSONL_TYPE_OBJECT) ?
+					((const jsonl_internal_builder_member_t*)((uintptr_t)builder->arena + source_table))[i].value :
+					((const size_t*)((uintptr_t)builder->arena + source_table))[i];
+				size_t child = jsonl_builder_copy_node(builder, value, source_child);
+				if (!child)
+					return 0;
+				source_table = jsonl_builder_node(builder, source_value)->container.table;
+				if (value_type == JSONL_TYPE_OBJECT)
 				{
-					if (set_value_table[append_set_value_index].path_length > path->depth + 1)
-					{
-						size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
-						if (remaining_buffer_size)
-							value_buffer->array.table[(child_value_count - append_child_value_count) + c] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-						size_t child_value_size = jsonl_internal_set_values_create_path(append_set_value_index, set_value_count, set_value_table, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size), path->depth + 1, value_buffer);
-						if (!child_value_size)
-							return 0;
-						object_size += child_value_size;
-					}
-					else
-					{
-						next_path.path_component.index = (child_value_count - append_child_value_count) + c;
-						next_path.value_type = set_value_table[append_set_value_index].value->type;
-						next_path.source_value = set_value_table[append_set_value_index].value;
-						size_t remaining_buffer_size = (object_size <= value_buffer_size) ? (value_buffer_size - object_size) : 0;
-						if (remaining_buffer_size)
-							value_buffer->array.table[(child_value_count - append_child_value_count) + c] = (jsonl_value_t*)((uintptr_t)value_buffer + object_size);
-						size_t child_value_size = jsonl_internal_copy_value(set_value_table[append_set_value_index].value, value_buffer, remaining_buffer_size, (jsonl_value_t*)((uintptr_t)value_buffer + object_size));
-						if (!child_value_size)
-							return 0;
-						object_size += child_value_size;
-					}
-					++c;
+					// Member names are never modified in place, so the copy refers to the names of the source.
+					jsonl_internal_builder_member_t* member = (jsonl_internal_builder_member_t*)((uintptr_t)builder->arena + table) + i;
+					*member = ((const jsonl_internal_builder_member_t*)((uintptr_t)builder->arena + source_table))[i];
+					member->value = child;
 				}
+				else
+					((size_t*)((uintptr_t)builder->arena + table))[i] = child;
+				jsonl_builder_node(builder, value)->container.value_count = i + 1;
 			}
-			break;
+			return value;
 		}
 		case JSONL_TYPE_STRING:
 		{
-			size_t data_size = jsonl_round_size(source_value->string.length + 1);
-			if (object_size + data_size <= value_buffer_size)
-			{
-				value_buffer->string.length = source_value->string.length;
-				value_buffer->string.value = (char*)((uintptr_t)value_buffer + object_size);
-				jsonl_copy_memory((char*)((uintptr_t)value_buffer + object_size), source_value->string.value, source_value->string.length + 1);
-			}
-			object_size += data_size;
-			break;
+			const jsonl_internal_builder_node_t* source_node = jsonl_builder_node(builder, source_value);
+			return jsonl_builder_set_string(builder, value, source_node->string.length, (const char*)((uintptr_t)builder->arena + source_node->string.value)) ? value : 0;
 		}
 		case JSONL_TYPE_NUMBER:
 		{
-			if (object_size <= value_buffer_size)
-			{
-#ifdef JSONL_FIXED_POINT_NUMBER_FORMAT
-				value_buffer->number.sign = source_value->number.sign;
-				value_buffer->number.integer = source_value->number.integer;
-				value_buffer->number.fraction = source_value->number.fraction;
-#else
-				value_buffer->number.value = source_value->number.value;
-#endif
-			}
-			break;
+			jsonl_number_value_t number_value = jsonl_builder_node(builder, source_value)->number;
+			return jsonl_builder_set_number(builder, value, &number_value) ? value : 0;
 		}
 		case JSONL_TYPE_BOOLEAN:
+			return jsonl_builder_set_boolean(builder, value, jsonl_builder_node(builder, source_value)->boolean) ? value : 0;
+		default:
+			return value;
+	}
+}
+
+static int jsonl_builder_value_equal(const jsonl_builder_t* builder, size_t value, const jsonl_value_t* value_tree)
+{
+	const jsonl_internal_builder_node_t* node = jsonl_builder_node(builder, value);
+	if (node->type != value_tree->type)
+		return 0;
+	switch (node->type)
+	{
+		case JSONL_TYPE_OBJECT:
 		{
-			if (object_size <= value_buffer_size)
-				value_buffer->boolean.value = source_value->boolean.value;
-			break;
+			if (node->container.value_count != value_tree->object.value_count)
+				return 0;
+			const jsonl_internal_builder_member_t* member_table = (const jsonl_internal_builder_member_t*)((uintptr_t)builder->arena + node->container.table);
+			for (size_t i = 0; i != value_tree->object.value_count; ++i)
+			{
+				size_t member_index = jsonl_builder_find_member(builder, value, value_tree->object.table[i].name_length, value_tree->object.table[i].name);
+				if (member_index == (size_t)~0 || !jsonl_builder_value_equal(builder, member_table[member_index].value, value_tree->object.table[i].value))
+					return 0;
+			}
+			return 1;
 		}
-		case JSONL_TYPE_NULL:
+		case JSONL_TYPE_ARRAY:
 		{
-			break;
+			if (node->container.value_count != value_tree->array.value_count)
+				return 0;
+			const size_t* element_table = (const size_t*)((uintptr_t)builder->arena + node->container.table);
+			for (size_t i = 0; i != value_tree->array.value_count; ++i)
+				if (!jsonl_builder_value_equal(builder, element_table[i], value_tree->array.table[i]))
+					return 0;
+			return 1;
 		}
+		case JSONL_TYPE_STRING:
+			return node->string.length == value_tree->string.length && (!node->string.length || jsonl_memory_compare((const void*)((uintptr_t)builder->arena + node->string.value), value_tree->string.value, node->string.length));
+		case JSONL_TYPE_NUMBER:
+			return jsonl_number_equal(&node->number, &value_tree->number);
+		case JSONL_TYPE_BOOLEAN:
+			return node->boolean == (value_tree->boolean.value ? 1 : 0);
 		default:
+			return 1;
+	}
+}
+
+static const jsonl_value_t* jsonl_get_json_patch_member(const jsonl_value_t* operation, size_t name_length, const char* name, int required_value_type)
+{
+	size_t member_index = jsonl_find_object_member(operation, name_length, name);
+	if (member_index == (size_t)~0)
+		return 0;
+	const jsonl_value_t* value = operation->object.table[member_index].value;
+	if (required_value_type && value->type != required_value_type)
+		return 0;
+	return value;
+}
+
+static int jsonl_builder_apply_json_patch_operation(jsonl_builder_t* builder, const jsonl_value_t* operation)
+{
+	if (operation->type != JSONL_TYPE_OBJECT)
+		return 0;
+	const jsonl_value_t* operation_name = jsonl_get_json_patch_member(operation, 2, "op", JSONL_TYPE_STRING);
+	const jsonl_value_t* path = jsonl_get_json_patch_member(operation, 4, "path", JSONL_TYPE_STRING);
+	const jsonl_value_t* from = jsonl_get_json_patch_member(operation, 4, "from", JSONL_TYPE_STRING);
+	const jsonl_value_t* value_tree = jsonl_get_json_patch_member(operation, 5, "value", 0);
+	if (!operation_name || !path)
+		return 0;
+	int operation_code = 0;
+	static const char* operation_name_table[] = { "add", "remove", "replace", "move", "copy", "test" };
+	for (int i = 0; !operation_code && i != (int)(sizeof(operation_name_table) / sizeof(*operation_name_table)); ++i)
+		if (operation_name->string.length == jsonl_string_length(operation_name_table[i]) && jsonl_memory_compare(operation_name->string.value, operation_name_table[i], operation_name->string.length))
+			operation_code = JSONL_JSON_PATCH_ADD + i;
+	if (!operation_code || ((operation_code == JSONL_JSON_PATCH_MOVE || operation_code == JSONL_JSON_PATCH_COPY) ? !from : (!value_tree && operation_code != JSONL_JSON_PATCH_REMOVE)))
+		return 0;
+
+	jsonl_internal_patch_target_t target;
+	size_t value = 0;
+	if (operation_code == JSONL_JSON_PATCH_MOVE || operation_code == JSONL_JSON_PATCH_COPY)
+	{
+		// A value can not be moved into itself, which is when "from" is a proper prefix of "path".
+		if (operation_code == JSONL_JSON_PATCH_MOVE && from->string.length < path->string.length && path->string.value[from->string.length] == '/' && jsonl_memory_compare(from->string.value, path->string.value, from->string.length))
+			return 0;
+		jsonl_internal_patch_target_t source_target;
+		if (!jsonl_builder_resolve_json_pointer(builder, from, &source_target))
+			return 0;
+		value = jsonl_builder_get_patch_target(builder, &source_target);
+		if (!value)
+			return 0;
+		if (operation_code == JSONL_JSON_PATCH_MOVE)
+		{
+			if (from->string.length == path->string.length && jsonl_memory_compare(from->string.value, path->string.value, from->string.length))
+				return 1;
+			if (!jsonl_builder_unlink_patch_target(builder, &source_target))
+				return 0;
+		}
+		else
+			value = jsonl_builder_copy_node(builder, 0, value);
+		if (!value)
 			return 0;
 	}
-	if (object_size <= value_buffer_size)
+	if (!jsonl_builder_resolve_json_pointer(builder, path, &target))
+		return 0;
+	switch (operation_code)
 	{
-		value_buffer->size = object_size;
-		value_buffer->parent = (jsonl_value_t*)parent;
-		value_buffer->type = source_value->type;
+		case JSONL_JSON_PATCH_ADD:
+			value = jsonl_builder_create_node(builder, 0, JSONL_TYPE_NULL);
+			if (!value || !jsonl_builder_import_value(builder, value, value_tree))
+				return 0;
+			return jsonl_builder_link_patch_target(builder, &target, value);
+		case JSONL_JSON_PATCH_REMOVE:
+			return jsonl_builder_unlink_patch_target(builder, &target);
+		case JSONL_JSON_PATCH_REPLACE:
+			value = jsonl_builder_get_patch_target(builder, &target);
+			return value && jsonl_builder_import_value(builder, value, value_tree);
+		case JSONL_JSON_PATCH_MOVE:
+		case JSONL_JSON_PATCH_COPY:
+			return jsonl_builder_link_patch_target(builder, &target, value);
+		case JSONL_JSON_PATCH_TEST:
+			value = jsonl_builder_get_patch_target(builder, &target);
+			return value && jsonl_builder_value_equal(builder, value, value_tree);
+		default:
+			return 0;
 	}
-	return object_size;
 }
 
-size_t jsonl_set_values(const jsonl_value_t* value_tree, size_t set_value_count, const jsonl_set_value_t* set_value_table, size_t value_buffer_size, jsonl_value_t* value_buffer)
+static int jsonl_builder_merge_patch(jsonl_builder_t* builder, size_t value, const jsonl_value_t* patch)
 {
-	for (size_t i = 0; i != set_value_count; ++i)
-		if (!set_value_table[i].path_length && !set_value_table[i].value)
+	if (patch->type != JSONL_TYPE_OBJECT)
+		return jsonl_builder_import_value(builder, value, patch);
+	if (jsonl_builder_node(builder, value)->type != JSONL_TYPE_OBJECT && !jsonl_builder_reset(builder, value, JSONL_TYPE_OBJECT))
+		return 0;
+	for (size_t i = 0; i != patch->object.value_count; ++i)
+	{
+		const jsonl_value_t* patch_value = patch->object.table[i].value;
+		size_t name_length = patch->object.table[i].name_length;
+		const char* name = patch->object.table[i].name;
+		if (patch_value->type == JSONL_TYPE_NULL)
+		{
+			jsonl_builder_remove_member(builder, value, name_length, name);
+			continue;
+		}
+		size_t member_index = jsonl_builder_find_member(builder, value, name_length, name);
+		size_t child = (member_index != (size_t)~0) ?
+			((const jsonl_internal_builder_member_t*)((uintptr_t)builder->arena + jsonl_builder_node(builder, value)->container.table))[member_index].value :
+			jsonl_builder_add_member(builder, value, name_length, name, JSONL_TYPE_NULL);
+		if (!child || !jsonl_builder_merge_patch(builder, child, patch_value))
 			return 0;
+	}
+	return 1;
+}
 
-	jsonl_internal_path_t root_path;
-	root_path.parent = 0;
-	root_path.depth = 0;
-	root_path.path_component.container_type = 0;
-	root_path.value_type = value_tree->type;
-	root_path.source_value = value_tree;
+int jsonl_builder_apply_json_patch(jsonl_builder_t* builder, const jsonl_value_t* patch)
+{
+	if (builder->error || !builder->root || patch->type != JSONL_TYPE_ARRAY)
+	{
+		builder->error = 1;
+		return 0;
+	}
+	for (size_t i = 0; i != patch->array.value_count; ++i)
+		if (!jsonl_builder_apply_json_patch_operation(builder, patch->array.table[i]))
+		{
+			// Operations before the failing one are already applied, so the tree is not left in usable state.
+			builder->error = 1;
+			return 0;
+		}
+	return 1;
+}
 
-	return jsonl_internal_set_values(set_value_count, set_value_table, &root_path, 0, value_buffer_size, value_buffer);
+int jsonl_builder_apply_merge_patch(jsonl_builder_t* builder, size_t value, const jsonl_value_t* patch)
+{
+	if (!jsonl_builder_is_valid_handle(builder, value))
+		builder->error = 1;
+	if (builder->error)
+		return 0;
+	if (!jsonl_builder_merge_patch(builder, value, patch))
+	{
+		builder->error = 1;
+		return 0;
+	}
+	return 1;
 }
 
 #ifdef __cplusplus
@@ -105,6 +105,51 @@ typedef struct jsonl_number_value_t
 } jsonl_number_value_t;
 #endif
 
+typedef struct jsonl_object_index_bucket_t
+{
+	size_t hash;
+	size_t member_index;
+} jsonl_object_index_bucket_t;
+/*
+	Structure
+		jsonl_object_index_bucket_t
+
+	Description
+		The jsonl_object_index_bucket_t structure defines format of one bucket of jsonl_object_index_t.
+
+	Members
+		hash
+			This member specifies the hash of the member name in this bucket.
+
+		member_index
+			This member specifies index of the member in the object table.
+			If the member_index is (size_t)~0 the bucket is empty and the member hash is not used.
+*/
+
+typedef struct jsonl_object_index_t
+{
+	size_t bucket_count;
+	jsonl_object_index_bucket_t* bucket_table;
+} jsonl_object_index_t;
+/*
+	Structure
+		jsonl_object_index_t
+
+	Description
+		The jsonl_object_index_t structure defines format of hash index used for finding members of large objects.
+		The index is an open addressing hash table with linear probing that maps hashes of member names to indices in the object table.
+
+		Hash of a name is computed with 64 bit FNV-1a hash function over the bytes of the name and truncated to size of size_t.
+
+	Members
+		bucket_count
+			This member specifies number of buckets in the bucket table.
+			The bucket count is always power of two and greater than the number of members in the object.
+
+		bucket_table
+			This member is a pointer to beginning of the table of buckets.
+*/
+
 typedef struct jsonl_value_t
 {
 	size_t size;
@@ -117,7 +162,7 @@ typedef struct jsonl_value_t
 			size_t value_count;
 			struct jsonl_value_t** table;
 		} array;
-		struct jsonl_object_t
+		struct
 		{
 			size_t value_count;
 			struct
@@ -126,6 +171,7 @@ typedef struct jsonl_value_t
 				char* name;
 				struct jsonl_value_t* value;
 			}* table;
+			jsonl_object_index_t* index;
 		} object;
 		struct
 		{
@@ -151,6 +197,12 @@ typedef struct jsonl_value_t
 		size
 			This member specifies size of this structure in bytes.
 			The size includes contents pointed by member variables and sizes of child values.
+			For values created by jsonl_set_values_shared and jsonl_compact_tree functions the size does not include sizes of shared child values.
+
+		parent
+			This member is a pointer to the parent value or zero if this value is the root value.
+			Values shared by jsonl_set_values_shared function point to parents in the tree they were originally created in.
+			Values shared by jsonl_compact_tree function point to the parent of their first occurrence.
 
 		type
 			This member specifies the type of this value.
@@ -193,6 +245,14 @@ typedef struct jsonl_value_t
 			The member name specifies beginning address of null terminated UTF-8 string that specifies name in a name value pair.
 			The member value specifies address of a child value.
 
+		object.index
+			Value of this member is only valid if type of this value is an object.
+			A pointer to hash index of the members of this object or zero if this object does not have an index.
+			Objects with at least JSONL_OBJECT_INDEX_MINIMUM_VALUE_COUNT members receive an index when they are created by this library.
+			The default value of JSONL_OBJECT_INDEX_MINIMUM_VALUE_COUNT is 16. Small objects are searched linearly.
+			To disable creation of indices compile with JSONL_NO_OBJECT_INDEX defined.
+			Values given to this library as input may set this member to zero.
+
 		string.length
 			Value of this member is only valid if type of this value is a string.
 			The size of this string in bytes not including null terminating character or padding bytes.
@@ -270,6 +330,217 @@ size_t jsonl_parse_text(size_t json_text_size, const char* json_text, size_t val
 		the buffer will contain value tree representing the contents of the JSON text.
 */
 
+#define JSONL_PARSE_FLAG_INTERN_NAMES 0x1
+
+typedef struct jsonl_parse_limits_t
+{
+	size_t maximum_text_size;
+	size_t maximum_depth;
+	size_t maximum_value_count;
+	size_t maximum_string_length;
+	size_t maximum_value_buffer_size;
+	uint64_t maximum_step_count;
+} jsonl_parse_limits_t;
+/*
+	Structure
+		jsonl_parse_limits_t
+
+	Description
+		The jsonl_parse_limits_t structure defines limits for resources used by jsonl_parse_text_with_options function.
+		Parsing fails as soon as any of the limits is crossed, so the limits bound the time used for parsing untrusted JSON text
+		also when only the required buffer size is queried.
+		Every member that is zero means no limit.
+
+	Members
+		maximum_text_size
+			This member specifies the maximum size of the JSON text in bytes. Larger text is rejected before it is read.
+		maximum_depth
+			This member specifies the maximum nesting depth of objects and arrays. The depth of the root container is 1.
+		maximum_value_count
+			This member specifies the maximum number of values in the value tree including the root value.
+			The members of a container are counted before any of them is parsed.
+		maximum_string_length
+			This member specifies the maximum length of decoded string value or member name in bytes.
+		maximum_value_buffer_size
+			This member specifies the maximum size of the value tree in bytes.
+			Parsing fails as soon as the parts of the tree created so far need more memory,
+			so querying the required buffer size does not read the whole text, if the tree would not fit in the buffer available to the caller.
+		maximum_step_count
+			This member specifies the maximum number of bytes of JSON text read by the parser.
+			Bytes are counted again every time the parser reads them to find the end of a value, to count members of a container or to decode a value.
+			The parser finds the end of every container before parsing its contents, so deeply nested text is read many times.
+			The limit is checked after each read, so the parser may read at most the size of the text over the limit.
+*/
+
+typedef struct jsonl_parse_options_t
+{
+	int flags;
+	size_t scratch_buffer_size;
+	void* scratch_buffer;
+	const jsonl_parse_limits_t* limits;
+} jsonl_parse_options_t;
+/*
+	Structure
+		jsonl_parse_options_t
+
+	Description
+		The jsonl_parse_options_t structure defines optional behavior of jsonl_parse_text_with_options function.
+
+	Members
+		flags
+			This member specifies the optional features used by the parser.
+			This member can be zero or combination of the following flags.
+
+				JSONL_PARSE_FLAG_INTERN_NAMES
+					Identical names of object members share single stored string in the value tree.
+					Names are identical when they are written identically in the JSON text.
+					The shared names are found using hash table that is located in the scratch buffer.
+					When the scratch buffer is full, new names are stored normally.
+					Because shared names are stored only once, size of a value may not include all names of its members,
+					but all the names are always located inside the value tree buffer.
+					Members with shared names can be compared by comparing the addresses of their names.
+					Functions that search members by name compare the lengths of the names before the addresses, so an address is matched only with the length of its name.
+
+		scratch_buffer_size
+			This member specifies the size of buffer pointed by member scratch_buffer in bytes.
+			Every name in the hash table of shared names uses five times size of pointer bytes and the table is kept at most half full.
+
+		scratch_buffer
+			This member is a pointer to a buffer used as temporary memory by the parser.
+			The contents of the buffer are undefined after parsing.
+			This member can be zero, if none of the flags require scratch buffer.
+
+		limits
+			This member is a pointer to structure that specifies the resource limits for parsing.
+			This member can be zero, if parsing is not limited.
+*/
+
+size_t jsonl_parse_text_with_options(size_t json_text_size, const char* json_text, const jsonl_parse_options_t* options, size_t value_buffer_size, jsonl_value_t* value_buffer);
+/*
+	Function
+		jsonl_parse_text_with_options
+
+	Description
+		This function works like jsonl_parse_text, but parsing can be controlled with options.
+
+		When the required buffer size is queried and the value tree is created using separate calls,
+		the options and the contents of the JSON text must be the same for both calls.
+
+	Parameters
+		json_text_size
+			This parameter specifies the size of JSON text in bytes.
+		json_text
+			This parameter is a pointer to buffer that contains the JSON text.
+		options
+			This parameter is a pointer to structure that specifies the options for parsing.
+			If this parameter is zero, this function is identical to jsonl_parse_text.
+		value_buffer_size
+			This parameter specifies the size of buffer pointed by parameter value_buffer in bytes.
+		value_buffer
+			This parameter is a pointer to a buffer that receives the value tree if size of the buffer is sufficiently large.
+
+	Return
+		If the JSON text is successfully parsed, the return value is size of value three in bytes and zero otherwise.
+		The return value is also zero, if any of the limits specified by the options is crossed.
+
+		If the returned size is not zero and not greater than the size of the value tree buffer,
+		the buffer will contain value tree representing the contents of the JSON text.
+*/
+
+#ifdef JSONL_PARSE_STATISTICS
+typedef struct jsonl_parse_stats_t
+{
+	uint64_t scanned_byte_count;
+	size_t value_count_table[JSONL_TYPE_NULL + 1];
+	size_t maximum_depth;
+	uint64_t string_byte_count;
+	size_t escape_count;
+	size_t node_buffer_size;
+	size_t table_buffer_size;
+	size_t string_buffer_size;
+	uint64_t scan_time;
+	uint64_t count_time;
+	uint64_t decode_time;
+	uint64_t index_time;
+	uint64_t total_time;
+} jsonl_parse_stats_t;
+/*
+	Structure
+		jsonl_parse_stats_t
+
+	Description
+		The jsonl_parse_stats_t structure receives statistics of single call to jsonl_parse_text_with_statistics function.
+		The structure and the function are only available when the library is compiled with JSONL_PARSE_STATISTICS defined.
+		Without JSONL_PARSE_STATISTICS the parser contains no statistics code at all.
+
+		The statistics are the same for the call that queries the required buffer size and the call that creates the value tree.
+		If parsing fails, the statistics describe the part of the text that was parsed before the error.
+
+	Members
+		scanned_byte_count
+			This member specifies the number of bytes of JSON text read by the parser.
+			Bytes are counted the same way as for member maximum_step_count of jsonl_parse_limits_t structure.
+			The ratio of this member to the size of the JSON text shows how many times the text is rescanned.
+			The parser finds the end of every container before parsing its contents, so the ratio grows with the depth of nesting.
+		value_count_table
+			This member specifies the number of values of every type in the value tree. The table is indexed with the JSONL_TYPE_ constants.
+		maximum_depth
+			This member specifies the maximum nesting depth of objects and arrays. The depth of the root container is 1.
+		string_byte_count
+			This member specifies the total length of decoded string values and member names in bytes.
+		escape_count
+			This member specifies the number of escape sequences in string values and member names.
+		node_buffer_size
+			This member specifies the bytes of the value tree buffer used by jsonl_value_t structures.
+		table_buffer_size
+			This member specifies the bytes of the value tree buffer used by member tables, element tables and object indices.
+		string_buffer_size
+			This member specifies the bytes of the value tree buffer used by string values and member names including terminators and padding.
+			The sum of members node_buffer_size, table_buffer_size and string_buffer_size is the size of the value tree.
+		scan_time
+			This member specifies the time spent in finding the ends of values.
+		count_time
+			This member specifies the time spent in counting members of objects and elements of arrays.
+		decode_time
+			This member specifies the time spent in decoding strings, member names, numbers and booleans.
+		index_time
+			This member specifies the time spent in creating object indices.
+		total_time
+			This member specifies the time spent in the whole call.
+
+		The times are in units of the clock read by JSONL_PARSE_STATISTICS_CLOCK() macro.
+		The library can be compiled with the macro defined as function like macro without parameters that returns uint64_t time stamp.
+		If the macro is not defined, the processor time stamp counter is used with GCC and Clang on x86 and the times are zero on other targets.
+*/
+
+size_t jsonl_parse_text_with_statistics(size_t json_text_size, const char* json_text, const jsonl_parse_options_t* options, jsonl_parse_stats_t* statistics, size_t value_buffer_size, jsonl_value_t* value_buffer);
+/*
+	Function
+		jsonl_parse_text_with_statistics
+
+	Description
+		This function works like jsonl_parse_text_with_options and collects statistics of the parsing.
+		The function is only available when the library is compiled with JSONL_PARSE_STATISTICS defined.
+
+	Parameters
+		json_text_size
+			This parameter specifies the size of JSON text in bytes.
+		json_text
+			This parameter is a pointer to buffer that contains the JSON text.
+		options
+			This parameter is a pointer to structure that specifies the options for parsing or zero for default options.
+		statistics
+			This parameter is a pointer to structure that receives the statistics.
+		value_buffer_size
+			This parameter specifies the size of buffer pointed by parameter value_buffer in bytes.
+		value_buffer
+			This parameter is a pointer to a buffer that receives the value tree if size of the buffer is sufficiently large.
+
+	Return
+		The return value is the same as the return value of jsonl_parse_text_with_options function.
+*/
+#endif
+
 size_t jsonl_print(const jsonl_value_t* value_tree, size_t json_text_buffer_size, char* json_text_buffer);
 /*
 	Function
@@ -300,170 +571,2130 @@ size_t jsonl_print(const jsonl_value_t* value_tree, size_t json_text_buffer_size
 		The printed JSON text is non null terminated.
 */
 
-typedef struct jsonl_path_component_t
+#define JSONL_PRINT_MODE_PRETTY    0
+#define JSONL_PRINT_MODE_COMPACT   1
+#define JSONL_PRINT_MODE_CANONICAL 2
+
+typedef struct jsonl_print_options_t
 {
-	int container_type;
-	union
-	{
-		size_t index;
-		struct
-		{
-			size_t length;
-			char* value;
-		} name;
-	};
-} jsonl_path_component_t;
+	int mode;
+	size_t indent_width;
+	char indent_character;
+} jsonl_print_options_t;
 /*
 	Structure
-		jsonl_path_component_t
+		jsonl_print_options_t
 
 	Description
-		The jsonl_path_component_t structure defines format of path component in a tree of JSON data.
-		These components can be value names in an object or indices in an array.
-		Array of jsonl_path_component_t structures can be used to create a path to any value in JSON data.
+		The jsonl_print_options_t structure defines format of JSON text printed by jsonl_print_with_options function.
 
 	Members
-		container_type
-			This variable specifies the type of this path component.
-			This member can be one of the following constants. Other types are not allowed.
+		mode
+			This member specifies the format of the printed JSON text.
+			This member can be one of the following constants.
 
-				JSONL_TYPE_OBJECT
-					The specified path is in an object.
+				JSONL_PRINT_MODE_PRETTY
+					Every value of objects and arrays is printed on its own line and indented by its depth.
+					Names and values are separated by " : ".
+					This is the format used by jsonl_print function with indent width of one and tab as indent character.
+
+				JSONL_PRINT_MODE_COMPACT
+					The JSON text is printed without any white space.
+					This is the smallest and the fastest format to print.
+
+				JSONL_PRINT_MODE_CANONICAL
+					The JSON text is printed in the canonical format of RFC 8785 JSON Canonicalization Scheme,
+					so equal JSON trees are printed as identical text that is suitable for hashing.
+					Object members are sorted by names compared as UTF-16 code units, there is no white space,
+					strings are escaped only where required and numbers are printed in the shortest form that
+					identifies the same double like ECMAScript Number.prototype.toString does.
+					Members are sorted using the unwritten part of the text buffer, no other memory is needed.
+					Object names are expected to be unique.
+					This mode is only supported by jsonl_print_with_options function.
+
+		indent_width
+			This member specifies number of indent characters printed for every level of depth.
+			This member is only used in JSONL_PRINT_MODE_PRETTY mode.
+
+		indent_character
+			This member specifies character used for indentation.
+			This member can be either tab '\t' or space ' '.
+			This member is only used in JSONL_PRINT_MODE_PRETTY mode.
+*/
 
-				JSONL_TYPE_ARRAY
-					The specified path is in an array.
+size_t jsonl_print_with_options(const jsonl_value_t* value_tree, const jsonl_print_options_t* options, size_t json_text_buffer_size, char* json_text_buffer);
+/*
+	Function
+		jsonl_print_with_options
 
-		index
-			Value of this member is only valid if type of this path component is array.
-			This is true when, value of container_type member is JSONL_TYPE_ARRAY.
-			This variable specifies the array index of this path component.
-			If this member is set to (size_t)~0, this component will be appended to the end off the array.
-			If this member is (size_t)~0 when removing a value, nothing will be removed.
+	Description
+		This function works like jsonl_print, but format of the JSON text is specified by options.
 
-		name.length
-			Value of this member is only valid if type of this path component is object.
-			This is true when, value of container_type member is JSONL_TYPE_OBJECT.
-			This member specifies the size of this path component name in bytes not including null terminating character.
+	Parameters
+		value_tree
+			This parameter is a pointer to JSON value to be printed.
+		options
+			This parameter is a pointer to structure that specifies the format of the JSON text.
+			If this parameter is zero, this function is identical to jsonl_print.
+		json_text_buffer_size
+			This parameter specifies the size of buffer pointed by parameter json_text_buffer in bytes.
 
-		name.value
-			Value of this member is only valid if type of this path component is object.
-			This is true when, value of container_type member is JSONL_TYPE_OBJECT.
-			This member is a pointer to beginning of the path component name.
-			The length of this string is specified by name.length member.
-			The format of the string is null terminated UTF-8.
+			If the buffer is not large enough to hold the resulting JSON text, the function returns required buffer size in bytes.
+		json_text_buffer
+			This parameter is a pointer to buffer, that will receive the resulting JSON text in UTF-8 format.
+
+			If the buffer size is zero, this parameter is ignored.
+
+	Return
+		If the JSON text is successfully printed, the return value is size of JSON text in bytes and zero otherwise.
+		Zero is returned if the options are not valid.
+		The printed JSON text is non null terminated.
 */
 
-typedef struct jsonl_set_value_t
+#define JSONL_PRINT_MINIMUM_CHUNK_SIZE 64
+
+typedef int (*jsonl_write_callback_t)(void* context, size_t size, const char* data);
+/*
+	Type
+		jsonl_write_callback_t
+
+	Description
+		This type is a pointer to function that receives printed JSON text from jsonl_print_to_writer function.
+		The function is called with the next piece of the JSON text every time the chunk buffer is full and once more at the end of printing.
+
+	Parameters
+		context
+			This parameter is the write context pointer given to jsonl_print_to_writer function.
+		size
+			This parameter specifies the size of the data in bytes.
+		data
+			This parameter is a pointer to the next piece of the JSON text.
+			The data is only valid until the function returns.
+
+	Return
+		The function returns nonzero if the data was written successfully and zero otherwise.
+		If the function returns zero, printing is stopped.
+*/
+
+size_t jsonl_print_to_writer(const jsonl_value_t* value_tree, const jsonl_print_options_t* options, size_t chunk_buffer_size, char* chunk_buffer, jsonl_write_callback_t write_callback, void* write_context);
+/*
+	Function
+		jsonl_print_to_writer
+
+	Description
+		This function prints contents of given JSON value in JSON text format in a single pass and passes the JSON text to callback function in chunks.
+		The memory used for printing is bounded by the size of the chunk buffer regardless of the size of the JSON text.
+		The JSON text written is identical to JSON text printed by jsonl_print_with_options function with same options.
+
+	Parameters
+		value_tree
+			This parameter is a pointer to JSON value to be printed.
+		options
+			This parameter is a pointer to structure that specifies the format of the JSON text.
+			If this parameter is zero, the format is same as the format of jsonl_print function.
+		chunk_buffer_size
+			This parameter specifies the size of buffer pointed by parameter chunk_buffer in bytes.
+			The size must be at least JSONL_PRINT_MINIMUM_CHUNK_SIZE bytes.
+		chunk_buffer
+			This parameter is a pointer to buffer that is used to collect the JSON text before it is passed to the write callback.
+		write_callback
+			This parameter is a pointer to function that receives the JSON text.
+		write_context
+			This parameter is a pointer that is passed to the write callback as is.
+
+	Return
+		If the JSON text is successfully printed, the return value is size of JSON text in bytes and zero otherwise.
+		Zero is returned if the options are not valid, the chunk buffer is too small or the write callback fails.
+*/
+
+#define JSONL_WRITER_MAXIMUM_DEPTH 64
+
+typedef struct jsonl_writer_t
 {
-	size_t path_length;
-	const jsonl_path_component_t* path;
-	const jsonl_value_t* value;
-} jsonl_set_value_t;
+	jsonl_print_options_t options;
+	size_t printed_size;
+	size_t chunk_size;
+	size_t chunk_buffer_size;
+	char* chunk_buffer;
+	jsonl_write_callback_t write_callback;
+	void* write_context;
+	int error;
+	int overflow;
+	int key_written;
+	size_t depth;
+	uint8_t nesting_stack[JSONL_WRITER_MAXIMUM_DEPTH + 1];
+} jsonl_writer_t;
 /*
 	Structure
-		jsonl_set_value_t
+		jsonl_writer_t
 
 	Description
-		The jsonl_set_value_t structure defines format of single modification to JSON tree.
-		This modification can be writing specific JSON value, appending to an array or removing specific JSON value.
+		The jsonl_writer_t structure holds the state of a streaming JSON writer.
+		The writer prints JSON text directly from calls like jsonl_writer_begin_object, jsonl_writer_key and jsonl_writer_string without creating a JSON value tree.
+		The structure is initialized by jsonl_writer_initialize function and its members should not be modified by the caller.
 
-		To write specific JSON value, set member value to address of new value.
-		The specified location will receive copy of value pointed by member value.
-		If this value already exists it will be overwritten.
-		If path to specified location does not exits it will be created.
+	Members
+		options
+			This member specifies the format of the printed JSON text.
 
-		To append JSON value to an array set index in the target array to (size_t)~0.
-		Otherwise appending works identically to writing specific JSON value.
-		If the target array does not exist it will also be created.
+		printed_size
+			This member specifies the total size of the JSON text printed so far in bytes.
 
-		To remove specific JSON value, set set member value zero.
-		The JSON value in specified location will be removed if it exists.
-		If array index (size_t)~0 is used in any part of the path nothing will be removed.
-		This is because index (size_t)~0 refers to location in array past all exiting values.
+		chunk_size
+			This member specifies the size of the JSON text currently in the buffer in bytes.
 
-	Members
-		path_length
-			This member specifies length of the path in JSON data tree in number of components.
+		chunk_buffer_size
+			This member specifies the size of the buffer in bytes.
 
-		path
-			This member is a pointer to beginning of table components.
-			The first component in the table is located in the root of JSON tree.
-			Number of component in this table is specified by member path_length.
+		chunk_buffer
+			This member is a pointer to the buffer that receives the JSON text.
 
-		value
-			This member is a pointer to JSON value that will be copied to specified location.
-			This member can be set to zero for removing a value.
+		write_callback
+			This member is a pointer to function that receives the JSON text every time the buffer is full.
+			If this member is zero, the buffer receives the whole JSON text.
+
+		write_context
+			This member is the pointer passed to the write callback.
+
+		error
+			This member is nonzero if the writer was used incorrectly or the write callback failed.
+			After an error all functions of the writer fail.
+
+		overflow
+			This member is nonzero if the writer has no write callback and the JSON text did not fit to the buffer.
+			The writer continues to count the size of the JSON text after the buffer is full.
+
+		key_written
+			This member is nonzero if a name of an object member is written and the value of the member is not written yet.
+
+		depth
+			This member specifies the number of objects and arrays that are currently open.
+
+		nesting_stack
+			This member holds state of every open object and array.
+			The first entry of the stack holds the state of the root value.
 */
 
-const jsonl_value_t* jsonl_get_value(const jsonl_value_t* parent_value, size_t path_length, const jsonl_path_component_t* path_table, int required_value_type);
+int jsonl_writer_initialize(jsonl_writer_t* writer, const jsonl_print_options_t* options, size_t buffer_size, char* buffer, jsonl_write_callback_t write_callback, void* write_context);
 /*
 	Function
-		jsonl_get_value
+		jsonl_writer_initialize
 
 	Description
-		This function gets address of a child value from given JSON value.
-		
+		This function initializes a writer for writing one JSON value.
+		The writer either prints the JSON text to a buffer or passes it in chunks to write callback function.
+
 	Parameters
-		parent_value
-			This parameter is a pointer to parent JSON object.
-			This function returns zero if type of this JSON value is not object.
-		path_length
-			Length of the path to child value.
-		path_table
-			Table of path components for specifying the path to child value.
-			The length of the path is specified by path_length parameter.
-		required_value_type
-			This parameter specifies required type for the child value.
-			If type of the child value is not type specified by this parameter, this function returns zero.
-			If this parameter is zero. It is ignored and type of the child value is not checked.
+		writer
+			This parameter is a pointer to the writer structure to be initialized.
+		options
+			This parameter is a pointer to structure that specifies the format of the JSON text.
+			If this parameter is zero, the format is same as the format of jsonl_print function.
+		buffer_size
+			This parameter specifies the size of buffer pointed by parameter buffer in bytes.
+			If the write callback is not zero, the size must be at least JSONL_PRINT_MINIMUM_CHUNK_SIZE bytes.
+		buffer
+			This parameter is a pointer to buffer that receives the JSON text.
+			If the write callback is zero, the JSON text is printed to this buffer like with jsonl_print function.
+			Otherwise the buffer is used to collect chunks of the JSON text before they are passed to the write callback.
+		write_callback
+			This parameter is a pointer to function that receives the JSON text or zero.
+		write_context
+			This parameter is a pointer that is passed to the write callback as is.
 
 	Return
-		The function returns address of child value from given JSON value when specified child value is found, otherwise zero is returned.
+		If the writer is successfully initialized, the return value is nonzero and zero otherwise.
+		Zero is returned if the options are not valid or the buffer is too small for the write callback.
 */
 
-size_t jsonl_set_values(const jsonl_value_t* value_tree, size_t set_value_count, const jsonl_set_value_t* set_value_table, size_t value_buffer_size, jsonl_value_t* value_buffer);
+int jsonl_writer_begin_object(jsonl_writer_t* writer);
 /*
 	Function
-		jsonl_set_values
+		jsonl_writer_begin_object
 
 	Description
-		This function makes list of modifications to JSON tree.
-		The modifications are given as a table of jsonl_set_value_t structures.
-		Everyone of these structures specifies single modification.
-
-		None of the modifications must be overlapping.
-		The result of this function is undefined if any of the modification overlap.
+		This function begins writing a new object.
+		Members of the object are written with jsonl_writer_key function followed by a value and the object is ended with jsonl_writer_end function.
 
 	Parameters
-		value_tree
-			This parameter is a pointer to JSON tree to be modified.
-			The JSON value pointed by this parameter is not modified, the modifications will be made to copy created from it.
-		set_value_count
-			This parameter specifies number of modifications to make.
-		set_value_table
-			This parameter is a pointer to table of structures to specify the modifications to make.
+		writer
+			This parameter is a pointer to the writer.
 
-			In these structures parent and size members are ignored from the structure pointed by member value.
-		value_buffer_size
-			This parameter specifies the size of buffer pointed by parameter value_buffer in bytes.
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+		The function fails if a value can not be written at the current position or JSONL_WRITER_MAXIMUM_DEPTH objects and arrays are already open.
+*/
 
-			If the buffer is not large enough to hold the new modified tree data, the function returns required buffer size in bytes.
-			Required size of the buffer can't be zero for the new JSON tree.
+int jsonl_writer_begin_array(jsonl_writer_t* writer);
+/*
+	Function
+		jsonl_writer_begin_array
+
+	Description
+		This function begins writing a new array.
+		The array is ended with jsonl_writer_end function.
+
+	Parameters
+		writer
+			This parameter is a pointer to the writer.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+		The function fails if a value can not be written at the current position or JSONL_WRITER_MAXIMUM_DEPTH objects and arrays are already open.
+*/
+
+int jsonl_writer_end(jsonl_writer_t* writer);
+/*
+	Function
+		jsonl_writer_end
+
+	Description
+		This function ends the object or array that was begun last.
+
+	Parameters
+		writer
+			This parameter is a pointer to the writer.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+		The function fails if no object or array is open or a member name is written without a value.
+*/
+
+int jsonl_writer_key(jsonl_writer_t* writer, size_t name_length, const char* name);
+/*
+	Function
+		jsonl_writer_key
+
+	Description
+		This function writes name of the next member of the current object.
+		The name must be followed by exactly one value.
+
+	Parameters
+		writer
+			This parameter is a pointer to the writer.
+		name_length
+			This parameter specifies the length of the name in bytes.
+		name
+			This parameter is a pointer to the name in UTF-8 format.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+		The function fails if the current value is not an object or a name is already written without a value.
+*/
+
+int jsonl_writer_string(jsonl_writer_t* writer, size_t string_length, const char* string);
+/*
+	Function
+		jsonl_writer_string
+
+	Description
+		This function writes a string value.
+
+	Parameters
+		writer
+			This parameter is a pointer to the writer.
+		string_length
+			This parameter specifies the length of the string in bytes.
+		string
+			This parameter is a pointer to the string in UTF-8 format.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
+
+int jsonl_writer_number(jsonl_writer_t* writer, const jsonl_number_value_t* number_value);
+/*
+	Function
+		jsonl_writer_number
+
+	Description
+		This function writes a number value.
+		The number is formatted like numbers printed by jsonl_print function.
+		Numbers with magnitude of 2^64 or more, infinities and NaN can not be written and the function fails.
+
+	Parameters
+		writer
+			This parameter is a pointer to the writer.
+		number_value
+			This parameter is a pointer to the number value.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
+
+int jsonl_writer_boolean(jsonl_writer_t* writer, int boolean_value);
+/*
+	Function
+		jsonl_writer_boolean
+
+	Description
+		This function writes a boolean value.
+
+	Parameters
+		writer
+			This parameter is a pointer to the writer.
+		boolean_value
+			This parameter specifies the value. Nonzero value is written as true and zero as false.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
+
+int jsonl_writer_null(jsonl_writer_t* writer);
+/*
+	Function
+		jsonl_writer_null
+
+	Description
+		This function writes a null value.
+
+	Parameters
+		writer
+			This parameter is a pointer to the writer.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
+
+int jsonl_writer_value(jsonl_writer_t* writer, const jsonl_value_t* value_tree);
+/*
+	Function
+		jsonl_writer_value
+
+	Description
+		This function writes contents of given JSON value tree as one value.
+
+	Parameters
+		writer
+			This parameter is a pointer to the writer.
+		value_tree
+			This parameter is a pointer to JSON value to be written.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
+
+size_t jsonl_writer_finish(jsonl_writer_t* writer);
+/*
+	Function
+		jsonl_writer_finish
+
+	Description
+		This function completes writing and passes the rest of the JSON text to the write callback.
+
+	Parameters
+		writer
+			This parameter is a pointer to the writer.
+
+	Return
+		If the JSON text is successfully written, the return value is size of JSON text in bytes and zero otherwise.
+		Zero is returned if any of the previous calls failed or if the root value is not complete.
+
+		If the writer has no write callback and the return value is greater than the size of the buffer, the buffer did not receive the whole JSON text.
+		In that case the return value is the required buffer size in bytes.
+		The printed JSON text is non null terminated.
+*/
+
+#define JSONL_STRUCT_MAXIMUM_NAME_LENGTH 256
+
+#define JSONL_FIELD_TYPE_OBJECT  1
+#define JSONL_FIELD_TYPE_STRING  3
+#define JSONL_FIELD_TYPE_NUMBER  4
+#define JSONL_FIELD_TYPE_BOOLEAN 5
+#define JSONL_FIELD_TYPE_INTEGER 7
+#define JSONL_FIELD_TYPE_DOUBLE  8
+
+struct jsonl_struct_descriptor_t;
+
+typedef struct jsonl_field_descriptor_t
+{
+	size_t name_length;
+	const char* name;
+	size_t offset;
+	int type;
+	size_t size;
+	const struct jsonl_struct_descriptor_t* struct_descriptor;
+} jsonl_field_descriptor_t;
+/*
+	Structure
+		jsonl_field_descriptor_t
+
+	Description
+		The jsonl_field_descriptor_t structure binds one member of a JSON object to one field of a C structure.
+
+	Members
+		name_length
+			This member specifies length of the member name in bytes.
+		name
+			This member is a pointer to the member name. The name does not need to be null terminated.
+			The name can't be longer than JSONL_STRUCT_MAXIMUM_NAME_LENGTH bytes.
+		offset
+			This member specifies the offset of the field from the beginning of the structure in bytes.
+		type
+			This member specifies the type of the field.
+			This member can be one of the following constants.
+
+				JSONL_FIELD_TYPE_OBJECT
+					The field is a structure described by member struct_descriptor.
+
+				JSONL_FIELD_TYPE_STRING
+					The field is a char array of size specified by member size that receives null terminated string.
+					Strings that do not fit to the array with the terminating null character are errors.
+
+				JSONL_FIELD_TYPE_NUMBER
+					The field is a jsonl_number_value_t.
+
+				JSONL_FIELD_TYPE_BOOLEAN
+					The field is an integer of size specified by member size that is set to one or zero.
+					If the size is zero, the field is an int.
+
+				JSONL_FIELD_TYPE_INTEGER
+					The field is a signed integer of size specified by member size.
+					If the size is zero, the field is an int64_t.
+					The number must be an integer without fraction and exponent parts that fits to the field.
+
+				JSONL_FIELD_TYPE_DOUBLE
+					The field is a double. Only finite values whose magnitude is less than 2^64 can be printed.
+
+		size
+			This member specifies size of the char array of JSONL_FIELD_TYPE_STRING field in bytes.
+			For JSONL_FIELD_TYPE_BOOLEAN and JSONL_FIELD_TYPE_INTEGER fields this member is zero, 1, 2, 4 or 8.
+			For other types this member is ignored.
+		struct_descriptor
+			This member is a pointer to descriptor of the structure of JSONL_FIELD_TYPE_OBJECT field.
+			For other types this member is ignored.
+*/
+
+typedef struct jsonl_struct_descriptor_t
+{
+	size_t size;
+	size_t field_count;
+	const jsonl_field_descriptor_t* field_table;
+	uint64_t hash_seed;
+	size_t hash_mask;
+	const size_t* hash_table;
+	size_t longest_name_length;
+} jsonl_struct_descriptor_t;
+/*
+	Structure
+		jsonl_struct_descriptor_t
+
+	Description
+		The jsonl_struct_descriptor_t structure describes fields of a C structure for jsonl_decode_struct and jsonl_writer_struct functions.
+		Field names are looked up by a perfect hash, so finding the field of a member takes one hash and one name comparison.
+
+	Members
+		size
+			This member specifies the size of the descriptor in bytes.
+		field_count
+			This member specifies number of fields in the field table.
+		field_table
+			This member is a pointer to the field table the descriptor was created from.
+		hash_seed
+			This member specifies seed of the hash function that maps every field name to a different slot of the hash table.
+			The slot of a name is computed with 64 bit FNV-1a hash function whose offset basis is xored with the seed.
+			The hash is then mixed with the 64 bit finalizer of MurmurHash3 and masked with member hash_mask.
+			Descriptors can be created without jsonl_create_struct_descriptor function, for example at compile time,
+			as long as no two names map to the same slot and the hash table and longest name length match the field table.
+		hash_mask
+			This member specifies number of slots in the hash table minus one.
+		hash_table
+			This member is a pointer to the hash table. Each slot contains index of a field or (size_t)~0 if the slot is empty.
+		longest_name_length
+			This member specifies length of the longest field name in bytes.
+*/
+
+size_t jsonl_create_struct_descriptor(size_t field_count, const jsonl_field_descriptor_t* field_table, size_t descriptor_buffer_size, jsonl_struct_descriptor_t* descriptor_buffer);
+/*
+	Function
+		jsonl_create_struct_descriptor
+
+	Description
+		This function creates descriptor of a C structure and finds a perfect hash for its field names.
+		Descriptors are meant to be created once for each message type and used for decoding and printing any number of messages.
+
+	Parameters
+		field_count
+			This parameter specifies number of fields in the field table.
+		field_table
+			This parameter is a pointer to the field table. The table is not copied and must stay valid while the descriptor is used.
+			Field names must be unique.
+			Finding the perfect hash compares hashes of every pair of names, so creating a descriptor for a large field table is slow.
+		descriptor_buffer_size
+			This parameter specifies the size of buffer pointed by parameter descriptor_buffer in bytes.
+
+			If the buffer is not large enough to hold the descriptor, the function returns required buffer size in bytes.
+		descriptor_buffer
+			This parameter is a pointer to a buffer that receives the descriptor if size of the buffer is sufficiently large.
+
+			If the buffer size is zero, this parameter is ignored.
+
+	Return
+		If the descriptor is successfully created, the return value is size of the descriptor in bytes and zero otherwise.
+
+		If the returned size is not zero and not greater than the size of the descriptor buffer,
+		the buffer will contain the descriptor.
+*/
+
+size_t jsonl_decode_struct(const jsonl_struct_descriptor_t* struct_descriptor, size_t json_text_size, const char* json_text, void* structure);
+/*
+	Function
+		jsonl_decode_struct
+
+	Description
+		This function decodes JSON object directly to fields of a C structure without creating a JSON tree.
+
+		Members that have no field in the descriptor are skipped and fields that have no member in the JSON text are not modified.
+		Members whose value is null do not modify their fields.
+
+	Parameters
+		struct_descriptor
+			This parameter is a pointer to descriptor of the structure.
+		json_text_size
+			This parameter specifies size of the JSON text in bytes.
+		json_text
+			This parameter is a pointer to the JSON text that contains one object.
+		structure
+			This parameter is a pointer to the structure that receives the decoded fields.
+			If the function fails, some of the fields may already be modified.
+
+	Return
+		If the object is successfully decoded, the return value is size of JSON text used by the object in bytes including white space that precedes it and zero otherwise.
+*/
+
+int jsonl_writer_struct(jsonl_writer_t* writer, const jsonl_struct_descriptor_t* struct_descriptor, const void* structure);
+/*
+	Function
+		jsonl_writer_struct
+
+	Description
+		This function writes fields of a C structure as next value of the writer.
+		Members are written in the order of the field table.
+
+	Parameters
+		writer
+			This parameter is a pointer to the writer.
+		struct_descriptor
+			This parameter is a pointer to descriptor of the structure.
+		structure
+			This parameter is a pointer to the structure to be written.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
+
+size_t jsonl_print_struct(const jsonl_struct_descriptor_t* struct_descriptor, const void* structure, const jsonl_print_options_t* options, size_t json_text_buffer_size, char* json_text_buffer);
+/*
+	Function
+		jsonl_print_struct
+
+	Description
+		This function prints fields of a C structure as JSON text like jsonl_print_with_options prints a JSON tree.
+
+	Parameters
+		struct_descriptor
+			This parameter is a pointer to descriptor of the structure.
+		structure
+			This parameter is a pointer to the structure to be printed.
+		options
+			This parameter is a pointer to the print options. Canonical mode is not supported.
+			If this parameter is zero, the format used by jsonl_print function is used.
+		json_text_buffer_size
+			This parameter specifies the size of buffer pointed by parameter json_text_buffer in bytes.
+		json_text_buffer
+			This parameter is a pointer to buffer that receives the JSON text if the buffer is sufficiently large.
+
+	Return
+		If the JSON text is successfully printed, the return value is size of JSON text in bytes and zero otherwise.
+		If the returned size is greater than the buffer size, the buffer does not contain complete JSON text.
+		The printed JSON text is non null terminated.
+*/
+
+typedef struct jsonl_path_component_t
+{
+	int container_type;
+	union
+	{
+		size_t index;
+		struct
+		{
+			size_t length;
+			char* value;
+		} name;
+	};
+} jsonl_path_component_t;
+/*
+	Structure
+		jsonl_path_component_t
+
+	Description
+		The jsonl_path_component_t structure defines format of path component in a tree of JSON data.
+		These components can be value names in an object or indices in an array.
+		Array of jsonl_path_component_t structures can be used to create a path to any value in JSON data.
+
+	Members
+		container_type
+			This variable specifies the type of this path component.
+			This member can be one of the following constants. Other types are not allowed.
+
+				JSONL_TYPE_OBJECT
+					The specified path is in an object.
+
+				JSONL_TYPE_ARRAY
+					The specified path is in an array.
+
+		index
+			Value of this member is only valid if type of this path component is array.
+			This is true when, value of container_type member is JSONL_TYPE_ARRAY.
+			This variable specifies the array index of this path component.
+			If this member is set to (size_t)~0, this component will be appended to the end off the array.
+			If this member is (size_t)~0 when removing a value, nothing will be removed.
+
+		name.length
+			Value of this member is only valid if type of this path component is object.
+			This is true when, value of container_type member is JSONL_TYPE_OBJECT.
+			This member specifies the size of this path component name in bytes not including null terminating character.
+
+		name.value
+			Value of this member is only valid if type of this path component is object.
+			This is true when, value of container_type member is JSONL_TYPE_OBJECT.
+			This member is a pointer to beginning of the path component name.
+			The length of this string is specified by name.length member.
+			The format of the string is null terminated UTF-8.
+*/
+
+typedef struct jsonl_set_value_t
+{
+	size_t path_length;
+	const jsonl_path_component_t* path;
+	const jsonl_value_t* value;
+} jsonl_set_value_t;
+/*
+	Structure
+		jsonl_set_value_t
+
+	Description
+		The jsonl_set_value_t structure defines format of single modification to JSON tree.
+		This modification can be writing specific JSON value, appending to an array or removing specific JSON value.
+
+		To write specific JSON value, set member value to address of new value.
+		The specified location will receive copy of value pointed by member value.
+		If this value already exists it will be overwritten.
+		If path to specified location does not exits it will be created.
+
+		To append JSON value to an array set index in the target array to (size_t)~0.
+		Otherwise appending works identically to writing specific JSON value.
+		If the target array does not exist it will also be created.
+
+		To remove specific JSON value, set set member value zero.
+		The JSON value in specified location will be removed if it exists.
+		If array index (size_t)~0 is used in any part of the path nothing will be removed.
+		This is because index (size_t)~0 refers to location in array past all exiting values.
+
+	Members
+		path_length
+			This member specifies length of the path in JSON data tree in number of components.
+
+		path
+			This member is a pointer to beginning of table components.
+			The first component in the table is located in the root of JSON tree.
+			Number of component in this table is specified by member path_length.
+
+		value
+			This member is a pointer to JSON value that will be copied to specified location.
+			This member can be set to zero for removing a value.
+*/
+
+const jsonl_value_t* jsonl_get_value(const jsonl_value_t* parent_value, size_t path_length, const jsonl_path_component_t* path_table, int required_value_type);
+/*
+	Function
+		jsonl_get_value
+
+	Description
+		This function gets address of a child value from given JSON value.
+		
+	Parameters
+		parent_value
+			This parameter is a pointer to parent JSON object.
+			This function returns zero if type of this JSON value is not object.
+		path_length
+			Length of the path to child value.
+		path_table
+			Table of path components for specifying the path to child value.
+			The length of the path is specified by path_length parameter.
+		required_value_type
+			This parameter specifies required type for the child value.
+			If type of the child value is not type specified by this parameter, this function returns zero.
+			If this parameter is zero. It is ignored and type of the child value is not checked.
+
+	Return
+		The function returns address of child value from given JSON value when specified child value is found, otherwise zero is returned.
+*/
+
+typedef struct jsonl_get_value_t
+{
+	size_t path_length;
+	const jsonl_path_component_t* path;
+	int required_value_type;
+} jsonl_get_value_t;
+/*
+	Structure
+		jsonl_get_value_t
+
+	Description
+		The jsonl_get_value_t structure defines format of single search made by jsonl_get_values function.
+
+	Members
+		path_length
+			This member specifies length of the path to the searched value in number of components.
+
+		path
+			This member is a pointer to beginning of table components.
+			Number of component in this table is specified by member path_length.
+
+		required_value_type
+			This member specifies required type for the searched value.
+			If this member is zero, type of the value is not checked.
+*/
+
+size_t jsonl_get_values(const jsonl_value_t* parent_value, size_t get_value_count, const jsonl_get_value_t* get_value_table, const jsonl_value_t** value_table);
+/*
+	Function
+		jsonl_get_values
+
+	Description
+		This function gets addresses of multiple child values from given JSON value in one traversal of the tree.
+		The paths are sorted to a prefix order, so that common prefixes of the paths are searched only once.
+		This function is equivalent to calling jsonl_get_value once for every path, but it is faster when the paths share prefixes.
+		This function does not allocate any memory, the table pointed by value_table is used for sorting the paths.
+
+	Parameters
+		parent_value
+			This parameter is a pointer to parent JSON value.
+		get_value_count
+			This parameter specifies number of values to search.
+		get_value_table
+			This parameter is a pointer to table of structures that specify the searched values.
+		value_table
+			This parameter is a pointer to table that receives the addresses of the searched values.
+			The table must be large enough to hold get_value_count pointers.
+			Every element of the table receives address of the value specified by the same element of the table pointed by get_value_table.
+			If the specified value is not found or the type of the value is not the required type, the element is set to zero.
+
+	Return
+		The function returns number of the values found.
+*/
+
+typedef struct jsonl_compiled_path_component_t
+{
+	int container_type;
+	size_t index;
+	size_t name_hash;
+	size_t name_length;
+	char* name;
+} jsonl_compiled_path_component_t;
+
+typedef struct jsonl_compiled_path_t
+{
+	size_t size;
+	size_t path_length;
+	jsonl_compiled_path_component_t* path_table;
+} jsonl_compiled_path_t;
+/*
+	Structure
+		jsonl_compiled_path_t
+
+	Description
+		The jsonl_compiled_path_t structure defines format of path that is prepared for repeated searches with jsonl_get_value_compiled function.
+		Compiled paths are created with functions jsonl_compile_path and jsonl_compile_json_pointer.
+		Compiled path does not contain any pointers to memory outside of the compiled path buffer and it can be used with any value tree.
+
+	Members
+		size
+			This member specifies size of this structure in bytes.
+			The size includes component table and names pointed by the components.
+
+		path_length
+			This member specifies length of the path in number of components.
+
+		path_table
+			This member is a pointer to beginning of table of path components.
+
+			The member container_type of the component can be JSONL_TYPE_OBJECT, JSONL_TYPE_ARRAY or zero.
+			If the container type is zero, the component matches either a member of an object by name or a value in an array by index.
+			Components created from JSON Pointer have zero container type, because JSON Pointer does not specify type of the containers.
+
+			The member index specifies the array index of the component.
+			If the component can not be used as array index, this member is (size_t)~0.
+
+			The member name_hash specifies 64 bit FNV-1a hash of the name truncated to size of size_t.
+			The hash is compared against hashes stored in object indices before comparing the names.
+			Objects without an index do not store hashes of their member names, so the hash is not used for them.
+
+			The member name_length specifies size of the name in bytes not including null terminating character.
+
+			The member name specifies beginning of null terminated UTF-8 name of the component.
+			If the container type is JSONL_TYPE_ARRAY the name is empty.
+*/
+
+size_t jsonl_compile_path(size_t path_length, const jsonl_path_component_t* path_table, size_t compiled_path_buffer_size, jsonl_compiled_path_t* compiled_path_buffer);
+/*
+	Function
+		jsonl_compile_path
+
+	Description
+		This function creates compiled path from table of path components.
+		The compiled path contains precomputed name hashes and it can be used with jsonl_get_value_compiled function.
+		This function does not allocate any memory.
+
+	Parameters
+		path_length
+			Length of the path in number of components.
+		path_table
+			Table of path components.
+			The length of the path is specified by path_length parameter.
+		compiled_path_buffer_size
+			This parameter specifies the size of buffer pointed by parameter compiled_path_buffer in bytes.
+
+			If the buffer is not large enough to hold the compiled path, the function returns required buffer size in bytes.
+		compiled_path_buffer
+			This parameter is a pointer to a buffer that receives the compiled path if size of the buffer is sufficiently large.
+
+			If the buffer size is zero, this parameter is ignored.
+
+	Return
+		If the path is successfully compiled, the return value is size of the compiled path in bytes and zero otherwise.
+
+		If the returned size is not zero and not greater than the size of the compiled path buffer,
+		the buffer will contain the compiled path.
+*/
+
+size_t jsonl_compile_json_pointer(size_t json_pointer_length, const char* json_pointer, size_t compiled_path_buffer_size, jsonl_compiled_path_t* compiled_path_buffer);
+/*
+	Function
+		jsonl_compile_json_pointer
+
+	Description
+		This function creates compiled path from JSON Pointer string specified in RFC 6901.
+		For example the pointer "/a/b/0" selects the first value of an array "b" that is member of object "a" in the root object.
+		Escape sequences "~0" and "~1" are decoded to characters '~' and '/'.
+		This function does not allocate any memory.
+
+	Parameters
+		json_pointer_length
+			This parameter specifies the length of JSON Pointer string in bytes.
+			Empty string is valid JSON Pointer and it specifies the whole value tree.
+		json_pointer
+			This parameter is a pointer to the JSON Pointer string.
+			The string may be optionally null terminated.
+		compiled_path_buffer_size
+			This parameter specifies the size of buffer pointed by parameter compiled_path_buffer in bytes.
+
+			If the buffer is not large enough to hold the compiled path, the function returns required buffer size in bytes.
+		compiled_path_buffer
+			This parameter is a pointer to a buffer that receives the compiled path if size of the buffer is sufficiently large.
+
+			If the buffer size is zero, this parameter is ignored.
+
+	Return
+		If the JSON Pointer is successfully compiled, the return value is size of the compiled path in bytes and zero otherwise.
+		Zero is returned if the JSON Pointer is not valid.
+
+		If the returned size is not zero and not greater than the size of the compiled path buffer,
+		the buffer will contain the compiled path.
+*/
+
+const jsonl_value_t* jsonl_get_value_compiled(const jsonl_value_t* parent_value, const jsonl_compiled_path_t* compiled_path, int required_value_type);
+/*
+	Function
+		jsonl_get_value_compiled
+
+	Description
+		This function gets address of a child value from given JSON value using compiled path.
+		This function works like jsonl_get_value, but names are first matched by precomputed hashes when the searched object has an index.
+
+		Objects with fewer than JSONL_OBJECT_INDEX_MINIMUM_VALUE_COUNT members have no index and they are searched linearly without the hashes.
+		The members of these objects are rejected by the length of the name before the names are compared, because hashing every member name would cost more than the comparisons.
+		Compiled paths give the most benefit for large objects.
+
+	Parameters
+		parent_value
+			This parameter is a pointer to parent JSON value.
+		compiled_path
+			This parameter is a pointer to compiled path for specifying the path to child value.
+		required_value_type
+			This parameter specifies required type for the child value.
+			If type of the child value is not type specified by this parameter, this function returns zero.
+			If this parameter is zero. It is ignored and type of the child value is not checked.
+
+	Return
+		The function returns address of child value from given JSON value when specified child value is found, otherwise zero is returned.
+*/
+
+size_t jsonl_set_values(const jsonl_value_t* value_tree, size_t set_value_count, const jsonl_set_value_t* set_value_table, size_t value_buffer_size, jsonl_value_t* value_buffer);
+/*
+	Function
+		jsonl_set_values
+
+	Description
+		This function makes list of modifications to JSON tree.
+		The modifications are given as a table of jsonl_set_value_t structures.
+		Everyone of these structures specifies single modification.
+
+		None of the modifications must be overlapping.
+		The result of this function is undefined if any of the modification overlap.
+
+		The plan of small lists of modifications is created in a fixed size buffer on the stack of JSONL_SET_VALUES_STACK_PLAN_SIZE bytes, 1 KiB by default,
+		and the modifications are applied like in jsonl_set_values_with_plan function.
+		Larger lists are applied without a plan by searching the table of modifications at every value on their paths, which takes time proportional to the square of the number of modifications.
+		To apply large lists or the same modifications more than once create the plan with jsonl_create_set_values_plan function and use jsonl_set_values_with_plan function instead.
+		Both ways create the same tree.
+
+	Parameters
+		value_tree
+			This parameter is a pointer to JSON tree to be modified.
+			The JSON value pointed by this parameter is not modified, the modifications will be made to copy created from it.
+		set_value_count
+			This parameter specifies number of modifications to make.
+		set_value_table
+			This parameter is a pointer to table of structures to specify the modifications to make.
+
+			In these structures parent and size members are ignored from the structure pointed by member value.
+		value_buffer_size
+			This parameter specifies the size of buffer pointed by parameter value_buffer in bytes.
+
+			If the buffer is not large enough to hold the new modified tree data, the function returns required buffer size in bytes.
+			Required size of the buffer can't be zero for the new JSON tree.
+		value_buffer
+			This parameter is a pointer to a buffer that receives the new JSON tree if size of the buffer is sufficiently large.
+			The whole tree is written to this buffer and will not contain any pointers to any memory outside of the value tree buffer.
+
+			All strings in the value tree are null terminated and aligned to size of pointer.
+
+			If the buffer is not large enough to hold the tree data, the contents of the tree value buffer are undefined.
+
+			If the buffer size is zero, this parameter is ignored.
+
+	Return
+		If the JSON tree is successfully modified, the return value is size of value three in bytes and zero otherwise.
+		Zero is returned for the same modifications as from jsonl_create_set_values_plan function.
+
+		If the returned size is not zero and not greater than the size of the value tree buffer,
+		the buffer will contain new modified JSON tree.
+*/
+
+typedef struct jsonl_set_values_plan_node_t
+{
+	const jsonl_path_component_t* component;
+	size_t set_value_index;
+	int remove;
+	size_t first_value_index;
+	size_t child_index;
+	size_t child_count;
+	size_t ordered_child_index;
+	size_t next_ordered_index;
+} jsonl_set_values_plan_node_t;
+/*
+	Structure
+		jsonl_set_values_plan_node_t
+
+	Description
+		The jsonl_set_values_plan_node_t structure defines format of single node in the path trie of a set values plan.
+		Every node corresponds to one path that is a prefix of a path of at least one modification.
+
+	Members
+		component
+			This member is a pointer to the path component from the parent node to this node.
+			The pointer points to the path table of one of the modifications.
+			For the root node this member is zero.
+
+		set_value_index
+			This member specifies index of the first modification in the set value table that writes a value to this path.
+			If there is no such modification, this member is (size_t)~0.
+
+		remove
+			This member is nonzero if a modification in the set value table removes the value at this path.
+
+		first_value_index
+			This member specifies the smallest index in the set value table of modifications that write a value to this path or below it.
+			If there is no such modification, this member is (size_t)~0.
+
+		child_index
+			This member specifies index of the first child node in the node table.
+			The child nodes are consecutive in the node table and sorted by their path components.
+
+		child_count
+			This member specifies number of child nodes.
+
+		ordered_child_index
+			This member specifies index of the child node with the smallest first_value_index or (size_t)~0 if there are no child nodes.
+
+		next_ordered_index
+			This member specifies index of the next sibling node in order of first_value_index or (size_t)~0 if this is the last sibling node.
+*/
+
+typedef struct jsonl_set_values_plan_t
+{
+	size_t size;
+	size_t set_value_count;
+	const jsonl_set_value_t* set_value_table;
+	size_t node_count;
+	jsonl_set_values_plan_node_t* node_table;
+} jsonl_set_values_plan_t;
+/*
+	Structure
+		jsonl_set_values_plan_t
+
+	Description
+		The jsonl_set_values_plan_t structure defines format of a set values plan created by jsonl_create_set_values_plan function.
+		The plan sorts the modifications into a path trie once, so applying them does not need to search the whole set value table at every value of the tree.
+		The plan refers to the set value table and the paths in it, so they must not be modified or freed while the plan is used.
+
+	Members
+		size
+			This member specifies the size of the plan in bytes.
+
+		set_value_count
+			This member specifies number of modifications in the set value table.
+
+		set_value_table
+			This member is a pointer to the set value table the plan was created from.
+
+		node_count
+			This member specifies number of nodes in the node table.
+
+		node_table
+			This member is a pointer to the node table.
+			The first node in the table is the root of the path trie.
+*/
+
+size_t jsonl_create_set_values_plan(size_t set_value_count, const jsonl_set_value_t* set_value_table, size_t plan_buffer_size, jsonl_set_values_plan_t* plan_buffer);
+/*
+	Function
+		jsonl_create_set_values_plan
+
+	Description
+		This function creates a plan for applying list of modifications to JSON trees with jsonl_set_values_with_plan function.
+		Creating the plan takes O(k log k) time for k modifications and applying it takes time linear to size of the tree and the modifications.
+		The same plan can be applied to any number of trees.
+
+	Parameters
+		set_value_count
+			This parameter specifies number of modifications.
+		set_value_table
+			This parameter is a pointer to table of structures to specify the modifications.
+			The modifications are interpreted like in jsonl_set_values function.
+		plan_buffer_size
+			This parameter specifies the size of buffer pointed by parameter plan_buffer in bytes.
+
+			If the buffer is not large enough to hold the plan, the function returns required buffer size in bytes.
+		plan_buffer
+			This parameter is a pointer to a buffer that receives the plan if size of the buffer is sufficiently large.
+
+			If the buffer size is zero, this parameter is ignored.
+
+	Return
+		If the plan is successfully created, the return value is size of the plan in bytes and zero otherwise.
+		Zero is returned if any path component has container type other than JSONL_TYPE_OBJECT or JSONL_TYPE_ARRAY or if the root value is removed.
+
+		If the returned size is not zero and not greater than the size of the plan buffer,
+		the buffer will contain the plan.
+*/
+
+size_t jsonl_set_values_with_plan(const jsonl_value_t* value_tree, const jsonl_set_values_plan_t* plan, size_t value_buffer_size, jsonl_value_t* value_buffer);
+/*
+	Function
+		jsonl_set_values_with_plan
+
+	Description
+		This function works like jsonl_set_values, but the modifications are given as a plan created by jsonl_create_set_values_plan function.
+		Values of the tree that are not on the path of any modification are copied without looking at the modifications.
+
+	Parameters
+		value_tree
+			This parameter is a pointer to JSON tree to be modified.
+			The JSON value pointed by this parameter is not modified, the modifications will be made to copy created from it.
+		plan
+			This parameter is a pointer to the plan.
+		value_buffer_size
+			This parameter specifies the size of buffer pointed by parameter value_buffer in bytes.
+
+			If the buffer is not large enough to hold the new modified tree data, the function returns required buffer size in bytes.
+		value_buffer
+			This parameter is a pointer to a buffer that receives the new JSON tree if size of the buffer is sufficiently large.
+
+			If the buffer size is zero, this parameter is ignored.
+
+	Return
+		If the JSON tree is successfully modified, the return value is size of value tree in bytes and zero otherwise.
+
+		If the returned size is not zero and not greater than the size of the value tree buffer,
+		the buffer will contain new modified JSON tree.
+*/
+
+size_t jsonl_set_values_shared(const jsonl_value_t* value_tree, const jsonl_set_values_plan_t* plan, size_t value_buffer_size, jsonl_value_t* value_buffer);
+/*
+	Function
+		jsonl_set_values_shared
+
+	Description
+		This function works like jsonl_set_values_with_plan, but values that are not modified are shared with the source tree instead of copied.
+		Only the values on paths of the modifications and the values written by the modifications are created to the value buffer,
+		so size of the new tree depends on the modifications and depth of the tree instead of size of the whole tree.
+		Member names and member indices of the created objects are copied, so the new tree refers to the source tree only through the shared values.
+
+		The new tree refers to values of the source tree, so the source tree must not be modified or freed while the new tree is used.
+		The parent members of the shared values point to parents in the tree the values were originally created in.
+		The size member of values created by this function does not include sizes of shared child values.
+
+	Parameters
+		value_tree
+			This parameter is a pointer to JSON tree to be modified.
+			The JSON value pointed by this parameter is not modified.
+		plan
+			This parameter is a pointer to the plan created by jsonl_create_set_values_plan function.
+		value_buffer_size
+			This parameter specifies the size of buffer pointed by parameter value_buffer in bytes.
+
+			If the buffer is not large enough to hold the new values, the function returns required buffer size in bytes.
+		value_buffer
+			This parameter is a pointer to a buffer that receives the new JSON tree if size of the buffer is sufficiently large.
+
+			If the buffer size is zero, this parameter is ignored.
+
+	Return
+		If the JSON tree is successfully modified, the return value is size of the new values in bytes and zero otherwise.
+
+		If the returned size is not zero and not greater than the size of the value tree buffer,
+		the buffer will contain new modified JSON tree.
+*/
+
+typedef struct jsonl_version_subtree_t
+{
+	const jsonl_value_t* value;
+	size_t oldest_shared_epoch;
+} jsonl_version_subtree_t;
+/*
+	Structure
+		jsonl_version_subtree_t
+
+	Description
+		The jsonl_version_subtree_t structure specifies the oldest version referred to by one value created to a version.
+
+	Members
+		value
+			This member is a pointer to the value in the version buffer.
+
+		oldest_shared_epoch
+			This member specifies the oldest epoch of the versions whose values are shared by the value or its child values.
+*/
+
+typedef struct jsonl_version_t
+{
+	size_t size;
+	size_t epoch;
+	size_t oldest_shared_epoch;
+	jsonl_value_t* value_tree;
+	const struct jsonl_version_t* base_version;
+	const struct jsonl_version_t* oldest_shared_version;
+	size_t subtree_count;
+	const jsonl_version_subtree_t* subtree_table;
+} jsonl_version_t;
+/*
+	Structure
+		jsonl_version_t
+
+	Description
+		The jsonl_version_t structure defines header of one version of a JSON tree that shares unmodified values with older versions.
+		The tree of the version is stored in the same buffer after the header.
+
+		Versions are reclaimed by their epochs.
+		The buffer of a version can be freed when no other version in use with greater epoch has oldest_shared_epoch less than or equal to epoch of that version.
+		A version is freed by freeing its buffer, no function needs to be called.
+
+		A simple way to follow the rule is to keep the versions in use in a queue ordered by epoch.
+		When a version is no longer used, it is marked unused, and while the first version of the queue is unused and
+		its epoch is less than the smallest oldest_shared_epoch of the versions in use, it is removed from the queue and freed.
+		When every value written by an old version has been modified again or removed in the newer versions,
+		oldest_shared_epoch of the newer versions advances past that version and it is freed.
+		Versions between the oldest and the newest version in use are kept, even if no version in use refers to them.
+
+	Members
+		size
+			This member specifies size of the version buffer in bytes.
+
+		epoch
+			This member specifies the epoch of this version.
+			Each new version created with jsonl_create_next_version function has epoch one greater than its base version.
+
+		oldest_shared_epoch
+			This member specifies the oldest epoch of versions whose values this version refers to.
+			It is the epoch of this version if the version does not refer to any other version.
+
+		value_tree
+			This member is a pointer to the root value of this version.
+
+		base_version
+			This member is a pointer to the version this version was created from or zero if the version was created with jsonl_create_version function.
+			Only the versions with epoch greater than or equal to oldest_shared_epoch are accessed through this pointer.
+
+		oldest_shared_version
+			This member is a pointer to the version of epoch oldest_shared_epoch.
+
+		subtree_count
+			This member specifies number of entries in the subtree table.
+
+		subtree_table
+			This member is a pointer to the table of values of this version that share values of older versions, sorted by address of the value.
+			Other values in the version buffer only refer to the version itself.
+*/
+
+size_t jsonl_create_version(const jsonl_value_t* value_tree, size_t epoch, size_t version_buffer_size, jsonl_version_t* version_buffer);
+/*
+	Function
+		jsonl_create_version
+
+	Description
+		This function creates first version of a JSON tree by copying the tree to the version buffer.
+		The created version does not refer to any other version.
+
+	Parameters
+		value_tree
+			This parameter is a pointer to JSON tree to be copied.
+		epoch
+			This parameter specifies the epoch of the version.
+		version_buffer_size
+			This parameter specifies the size of buffer pointed by parameter version_buffer in bytes.
+
+			If the buffer is not large enough to hold the version, the function returns required buffer size in bytes.
+		version_buffer
+			This parameter is a pointer to a buffer that receives the version if size of the buffer is sufficiently large.
+
+			If the buffer size is zero, this parameter is ignored.
+
+	Return
+		If the version is successfully created, the return value is size of the version in bytes and zero otherwise.
+
+		If the returned size is not zero and not greater than the size of the version buffer,
+		the buffer will contain the version.
+*/
+
+size_t jsonl_create_next_version(const jsonl_version_t* base_version, const jsonl_set_values_plan_t* plan, size_t version_buffer_size, jsonl_version_t* version_buffer);
+/*
+	Function
+		jsonl_create_next_version
+
+	Description
+		This function creates new version of a JSON tree by applying modifications to the base version with jsonl_set_values_shared function.
+		The new version shares all unmodified values with the base version and the versions the base version refers to.
+
+		The oldest epoch referred to by every created value that shares values is stored to the subtree table of the new version,
+		so the oldest shared epoch of the new version is found by looking up only the values shared by the created values.
+		The versions from the base version down to its oldest shared version must not have been freed.
+
+	Parameters
+		base_version
+			This parameter is a pointer to the version to be modified.
+			The version pointed by this parameter is not modified.
+		plan
+			This parameter is a pointer to the plan created by jsonl_create_set_values_plan function.
+		version_buffer_size
+			This parameter specifies the size of buffer pointed by parameter version_buffer in bytes.
+
+			If the buffer is not large enough to hold the version, the function returns required buffer size in bytes.
+		version_buffer
+			This parameter is a pointer to a buffer that receives the version if size of the buffer is sufficiently large.
+
+			If the buffer size is zero, this parameter is ignored.
+
+	Return
+		If the version is successfully created, the return value is size of the version in bytes and zero otherwise.
+
+		If the returned size is not zero and not greater than the size of the version buffer,
+		the buffer will contain the version.
+*/
+
+typedef struct jsonl_tree_hash_node_t
+{
+	uint64_t hash;
+	size_t child_index;
+} jsonl_tree_hash_node_t;
+/*
+	Structure
+		jsonl_tree_hash_node_t
+
+	Description
+		The jsonl_tree_hash_node_t structure defines the hash of one value of a JSON tree.
+
+	Members
+		hash
+			This member specifies the 64 bit hash of the value and all of its child values.
+			Hash of an object does not depend on order of its members.
+		child_index
+			This member specifies index of the first child value in the node table of the tree hash.
+			The nodes of the child values are stored consecutively in the same order as the child values in the object or the array.
+			If the value is not an object or an array, this member is zero.
+*/
+
+typedef struct jsonl_tree_hash_t
+{
+	size_t size;
+	const jsonl_value_t* value_tree;
+	size_t node_count;
+	jsonl_tree_hash_node_t* node_table;
+} jsonl_tree_hash_t;
+/*
+	Structure
+		jsonl_tree_hash_t
+
+	Description
+		The jsonl_tree_hash_t structure defines hashes of all values of a JSON tree used to compare JSON trees with jsonl_diff function.
+
+	Members
+		size
+			This member specifies the size of the tree hash in bytes.
+		value_tree
+			This member is a pointer to the JSON tree the hashes were created from.
+		node_count
+			This member specifies number of values in the JSON tree.
+		node_table
+			This member is a pointer to the table of value hashes.
+			The first node is the hash of the root value.
+*/
+
+size_t jsonl_create_tree_hash(const jsonl_value_t* value_tree, size_t tree_hash_buffer_size, jsonl_tree_hash_t* tree_hash_buffer);
+/*
+	Function
+		jsonl_create_tree_hash
+
+	Description
+		This function hashes every value of a JSON tree in one pass over the tree.
+
+		The tree hash of a snapshot can be kept and reused for comparing the snapshot against all of its successors.
+		The JSON tree must not be modified or freed while the tree hash is used.
+
+	Parameters
+		value_tree
+			This parameter is a pointer to JSON tree to be hashed.
+		tree_hash_buffer_size
+			This parameter specifies the size of buffer pointed by parameter tree_hash_buffer in bytes.
+
+			If the buffer is not large enough to hold the tree hash, the function returns required buffer size in bytes.
+		tree_hash_buffer
+			This parameter is a pointer to a buffer that receives the tree hash if size of the buffer is sufficiently large.
+
+			If the buffer size is zero, this parameter is ignored.
+
+	Return
+		If the tree hash is successfully created, the return value is size of the tree hash in bytes and zero otherwise.
+
+		If the returned size is not zero and not greater than the size of the tree hash buffer,
+		the buffer will contain the tree hash.
+*/
+
+typedef struct jsonl_diff_t
+{
+	size_t size;
+	size_t set_value_count;
+	jsonl_set_value_t* set_value_table;
+} jsonl_diff_t;
+/*
+	Structure
+		jsonl_diff_t
+
+	Description
+		The jsonl_diff_t structure defines modifications that transform one JSON tree to another.
+
+	Members
+		size
+			This member specifies the size of the diff in bytes.
+		set_value_count
+			This member specifies number of modifications in the set value table.
+		set_value_table
+			This member is a pointer to table of modifications in the format accepted by jsonl_set_values and jsonl_create_set_values_plan functions.
+			Paths are stored in the diff buffer, names and values point to the compared JSON trees.
+*/
+
+size_t jsonl_diff(const jsonl_tree_hash_t* tree_hash_a, const jsonl_tree_hash_t* tree_hash_b, size_t diff_buffer_size, jsonl_diff_t* diff_buffer);
+/*
+	Function
+		jsonl_diff
+
+	Description
+		This function creates modifications that transform the first JSON tree to the second JSON tree.
+
+		Values with equal hashes are assumed to be equal and are not visited, so the cost of the comparison depends mostly on size of the changes.
+		Object members are matched by name. Arrays are compared by skipping equal elements at both ends and comparing the remaining elements by position,
+		extra elements are removed from or added to the end of the changed range.
+
+		The modifications can be applied to the first JSON tree with jsonl_create_set_values_plan and jsonl_set_values_with_plan
+		or jsonl_create_next_version functions. The diff is valid as long as both JSON trees are valid.
+
+	Parameters
+		tree_hash_a
+			This parameter is a pointer to tree hash of the JSON tree to be modified.
+		tree_hash_b
+			This parameter is a pointer to tree hash of the target JSON tree.
+		diff_buffer_size
+			This parameter specifies the size of buffer pointed by parameter diff_buffer in bytes.
+
+			If the buffer is not large enough to hold the diff, the function returns required buffer size in bytes.
+		diff_buffer
+			This parameter is a pointer to a buffer that receives the diff if size of the buffer is sufficiently large.
+
+			If the buffer size is zero, this parameter is ignored.
+
+	Return
+		If the diff is successfully created, the return value is size of the diff in bytes and zero otherwise.
+
+		If the returned size is not zero and not greater than the size of the diff buffer,
+		the buffer will contain the diff.
+*/
+
+int jsonl_value_equal(const jsonl_value_t* value_a, const jsonl_value_t* value_b);
+/*
+	Function
+		jsonl_value_equal
+
+	Description
+		This function compares two JSON values and all of their child values.
+		Order of object members is ignored and numbers are compared by value.
+		Members with repeated names are matched in order of occurrence, the n-th member of a name is compared with the n-th member of the same name in the other object.
+		The comparison is symmetric, so the order of the parameters does not change the result.
+
+		Identical values are equal without being visited, so values shared by jsonl_compact_tree and jsonl_set_values_shared functions are compared in constant time.
+		Two values of one tree created by jsonl_compact_tree function are equal only if they are the same value or they differ only by the order of members of objects.
+		Other values are compared by their structure. Trees that have tree hashes are compared faster with jsonl_tree_hash_equal function.
+
+	Parameters
+		value_a
+			This parameter is a pointer to the first value.
+		value_b
+			This parameter is a pointer to the second value.
+
+	Return
+		If the values are equal, the return value is nonzero and zero otherwise.
+*/
+
+int jsonl_tree_hash_equal(const jsonl_tree_hash_t* tree_hash_a, const jsonl_tree_hash_t* tree_hash_b);
+/*
+	Function
+		jsonl_tree_hash_equal
+
+	Description
+		This function compares two JSON trees using the hashes of their values created by jsonl_create_tree_hash function.
+		Order of object members is ignored, members with repeated names are matched in order of occurrence and numbers are compared by value, like by jsonl_value_equal function.
+
+		Trees that have different hashes are not equal, so they are rejected in constant time without visiting the trees.
+		The structure of the trees is compared only when the hashes are equal, and every pair of child values is again compared by hash first.
+		The hashes only reject values, two values are never considered equal because of their hashes alone.
+
+	Parameters
+		tree_hash_a
+			This parameter is a pointer to the tree hash of the first tree.
+		tree_hash_b
+			This parameter is a pointer to the tree hash of the second tree.
+
+	Return
+		If the trees are equal, the return value is nonzero and zero otherwise.
+*/
+
+size_t jsonl_compact_tree(const jsonl_tree_hash_t* tree_hash, size_t value_buffer_size, jsonl_value_t* value_buffer);
+/*
+	Function
+		jsonl_compact_tree
+
+	Description
+		This function copies a JSON tree storing each distinct value only once.
+		Values that are repeated in the tree are replaced by pointers to the first copy of the value.
+
+		Values are looked up by hashes of the tree hash and compared before they are shared, so hash collisions do not merge different values.
+		Members of objects are compared in order, so the order of members is preserved and objects with the same members in different order are not shared.
+		Numbers are shared when they are equal by value, so negative zero may be replaced by zero.
+
+		The parent member of a shared value points to the parent of its first occurrence in the tree.
+		The size member of a value does not include sizes of shared child values stored for earlier occurrences.
+
+	Parameters
+		tree_hash
+			This parameter is a pointer to tree hash of JSON tree to be compacted created by jsonl_create_tree_hash function.
+		value_buffer_size
+			This parameter specifies the size of buffer pointed by parameter value_buffer in bytes.
+
+			If the buffer is not large enough, the function returns required buffer size in bytes.
+			The required size includes temporary space used during compaction that is located at the end of the buffer.
+			The size returned for a buffer that can not hold the temporary space is the size needed for compacting a tree without repeated values,
+			for other buffers the size is exact.
+		value_buffer
+			This parameter is a pointer to a buffer that receives the compacted JSON tree if size of the buffer is sufficiently large.
+
+			If the buffer size is zero, this parameter is ignored.
+
+	Return
+		If the tree is successfully compacted, the return value is the required buffer size in bytes and zero otherwise.
+		The return value is not the size of the compacted tree, because it includes the temporary space.
+		The size of the compacted tree is the size member of its root value.
+
+		If the returned size is not zero and not greater than the size of the value buffer,
+		the buffer will contain the compacted JSON tree. A buffer of the returned size always receives the same tree.
+*/
+
+typedef void* (*jsonl_reallocate_callback_t)(void* context, void* block, size_t old_size, size_t new_size);
+/*
+	Type
+		jsonl_reallocate_callback_t
+
+	Description
+		This type is a pointer to function that grows memory blocks used by jsonl_builder_t.
+
+	Parameters
+		context
+			This parameter is the reallocate context pointer given to jsonl_builder_initialize function.
+		block
+			This parameter is a pointer to the current memory block or zero if there is no current block.
+		old_size
+			This parameter specifies the size of the current memory block in bytes.
+		new_size
+			This parameter specifies the required size of the new memory block in bytes.
+
+	Return
+		The function returns pointer to the new memory block or zero if the block can not be allocated.
+		The first old_size bytes of the new block must be copied from the current block.
+		The new block must be aligned like memory returned by malloc.
+		The current block is not used by the builder after the function succeeds.
+*/
+
+typedef struct jsonl_builder_t
+{
+	size_t arena_size;
+	size_t arena_used;
+	void* arena;
+	jsonl_reallocate_callback_t reallocate_callback;
+	void* reallocate_context;
+	size_t root;
+	int error;
+} jsonl_builder_t;
+/*
+	Structure
+		jsonl_builder_t
+
+	Description
+		The jsonl_builder_t structure holds the state of a JSON tree builder.
+		The builder appends values to an arena in the order they are created and jsonl_builder_finalize function writes them as a standard JSON value tree.
+		Every value in the arena is identified by a handle, which is an offset to the arena and stays valid when the arena grows.
+		Zero is never a valid handle.
+		The structure is initialized by jsonl_builder_initialize function and its members should not be modified by the caller.
+
+	Members
+		arena_size
+			This member specifies the size of the arena in bytes.
+
+		arena_used
+			This member specifies the number of bytes used from the beginning of the arena.
+
+		arena
+			This member is a pointer to the arena.
+
+		reallocate_callback
+			This member is a pointer to function that grows the arena or zero if the arena can not grow.
+
+		reallocate_context
+			This member is the pointer passed to the reallocate callback.
+
+		root
+			This member is handle to the root value or zero if the root value is not created.
+
+		error
+			This member is nonzero if memory allocation has failed or the builder was used incorrectly.
+			After an error all functions of the builder fail.
+*/
+
+int jsonl_builder_initialize(jsonl_builder_t* builder, size_t arena_size, void* arena, jsonl_reallocate_callback_t reallocate_callback, void* reallocate_context);
+/*
+	Function
+		jsonl_builder_initialize
+
+	Description
+		This function initializes a builder with empty arena.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder structure to be initialized.
+		arena_size
+			This parameter specifies the size of buffer pointed by parameter arena in bytes.
+		arena
+			This parameter is a pointer to the initial arena buffer or zero if the arena size is zero.
+			The buffer must be aligned like memory returned by malloc.
+		reallocate_callback
+			This parameter is a pointer to function that grows the arena when the arena is full.
+			If this parameter is zero, all values must fit to the initial arena.
+		reallocate_context
+			This parameter is a pointer that is passed to the reallocate callback as is.
+
+	Return
+		If the builder is successfully initialized, the return value is nonzero and zero otherwise.
+*/
+
+size_t jsonl_builder_create_root(jsonl_builder_t* builder, int value_type);
+/*
+	Function
+		jsonl_builder_create_root
+
+	Description
+		This function creates the root value of the tree.
+		If the root value is already created, the new value replaces it.
+
+		New objects and arrays are empty, new strings are empty, new numbers are zero and new booleans are false.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		value_type
+			This parameter specifies the type of the root value.
+
+	Return
+		If the function succeeds, the return value is handle to the new value and zero otherwise.
+*/
+
+size_t jsonl_builder_add_member(jsonl_builder_t* builder, size_t object_value, size_t name_length, const char* name, int value_type);
+/*
+	Function
+		jsonl_builder_add_member
+
+	Description
+		This function appends a new member to an object.
+		The function does not check if the object already has a member with the same name.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		object_value
+			This parameter is handle to the object.
+		name_length
+			This parameter specifies the length of the member name in bytes.
+		name
+			This parameter is a pointer to the member name in UTF-8 format.
+		value_type
+			This parameter specifies the type of the new member value.
+
+	Return
+		If the function succeeds, the return value is handle to the new member value and zero otherwise.
+*/
+
+size_t jsonl_builder_push_element(jsonl_builder_t* builder, size_t array_value, int value_type);
+/*
+	Function
+		jsonl_builder_push_element
+
+	Description
+		This function appends a new element to the end of an array.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		array_value
+			This parameter is handle to the array.
+		value_type
+			This parameter specifies the type of the new element.
+
+	Return
+		If the function succeeds, the return value is handle to the new element and zero otherwise.
+*/
+
+int jsonl_builder_set_string(jsonl_builder_t* builder, size_t value, size_t string_length, const char* string);
+/*
+	Function
+		jsonl_builder_set_string
+
+	Description
+		This function changes a value to a string value.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		value
+			This parameter is handle to the value to be changed.
+		string_length
+			This parameter specifies the length of the string in bytes.
+		string
+			This parameter is a pointer to the string in UTF-8 format.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
+
+int jsonl_builder_set_number(jsonl_builder_t* builder, size_t value, const jsonl_number_value_t* number_value);
+/*
+	Function
+		jsonl_builder_set_number
+
+	Description
+		This function changes a value to a number value.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		value
+			This parameter is handle to the value to be changed.
+		number_value
+			This parameter is a pointer to the number value.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
+
+int jsonl_builder_set_boolean(jsonl_builder_t* builder, size_t value, int boolean_value);
+/*
+	Function
+		jsonl_builder_set_boolean
+
+	Description
+		This function changes a value to a boolean value.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		value
+			This parameter is handle to the value to be changed.
+		boolean_value
+			This parameter specifies the boolean value.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
+
+int jsonl_builder_set_null(jsonl_builder_t* builder, size_t value);
+/*
+	Function
+		jsonl_builder_set_null
+
+	Description
+		This function changes a value to a null value.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		value
+			This parameter is handle to the value to be changed.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
+
+size_t jsonl_builder_set_member(jsonl_builder_t* builder, size_t object_value, size_t name_length, const char* name, int value_type);
+/*
+	Function
+		jsonl_builder_set_member
+
+	Description
+		This function sets member of an object to a new empty value of given type.
+		If the object has a member with the same name, the value of that member is replaced in place.
+		Otherwise a new member is appended to the object.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		object_value
+			This parameter is handle to the object.
+		name_length
+			This parameter specifies the length of the member name in bytes.
+		name
+			This parameter is a pointer to the member name in UTF-8 format.
+		value_type
+			This parameter specifies the type of the member value.
+
+	Return
+		If the function succeeds, the return value is handle to the member value and zero otherwise.
+*/
+
+size_t jsonl_builder_insert_element(jsonl_builder_t* builder, size_t array_value, size_t index, int value_type);
+/*
+	Function
+		jsonl_builder_insert_element
+
+	Description
+		This function inserts a new element to an array before the element at given index.
+		The elements after the new element are moved one index forward.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		array_value
+			This parameter is handle to the array.
+		index
+			This parameter specifies the index of the new element.
+			If the index is equal to the number of elements, the element is appended to the end of the array.
+		value_type
+			This parameter specifies the type of the new element.
+
+	Return
+		If the function succeeds, the return value is handle to the new element and zero otherwise.
+*/
+
+int jsonl_builder_remove_member(jsonl_builder_t* builder, size_t object_value, size_t name_length, const char* name);
+/*
+	Function
+		jsonl_builder_remove_member
+
+	Description
+		This function removes member with given name from an object.
+		The order of the other members is not changed.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		object_value
+			This parameter is handle to the object.
+		name_length
+			This parameter specifies the length of the member name in bytes.
+		name
+			This parameter is a pointer to the member name in UTF-8 format.
+
+	Return
+		If the member is removed, the return value is nonzero and zero otherwise.
+		Zero is returned also if the object does not have member with given name.
+*/
+
+int jsonl_builder_remove_element(jsonl_builder_t* builder, size_t array_value, size_t index);
+/*
+	Function
+		jsonl_builder_remove_element
+
+	Description
+		This function removes element at given index from an array.
+		The elements after the removed element are moved one index backward.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		array_value
+			This parameter is handle to the array.
+		index
+			This parameter specifies the index of the element to be removed.
+
+	Return
+		If the element is removed, the return value is nonzero and zero otherwise.
+		Zero is returned also if the index is not less than the number of elements.
+*/
+
+int jsonl_builder_reset(jsonl_builder_t* builder, size_t value, int value_type);
+/*
+	Function
+		jsonl_builder_reset
+
+	Description
+		This function changes a value to a new empty value of given type.
+		Children of the old value are removed from the tree.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		value
+			This parameter is handle to the value to be changed.
+		value_type
+			This parameter specifies the new type of the value.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
+
+int jsonl_builder_set_value(jsonl_builder_t* builder, size_t value, const jsonl_value_t* value_tree);
+/*
+	Function
+		jsonl_builder_set_value
+
+	Description
+		This function changes a value to a copy of given JSON value tree.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		value
+			This parameter is handle to the value to be changed.
+		value_tree
+			This parameter is a pointer to the JSON value to be copied.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
+
+size_t jsonl_builder_load(jsonl_builder_t* builder, const jsonl_value_t* value_tree);
+/*
+	Function
+		jsonl_builder_load
+
+	Description
+		This function creates the root value of the tree as a copy of given JSON value tree.
+		The copy can be modified in place and jsonl_builder_finalize function writes the modified tree.
+		Loading a tree takes time linear to its size and after that every modification only takes time proportional to the modified values.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		value_tree
+			This parameter is a pointer to the JSON value to be copied.
+
+	Return
+		If the function succeeds, the return value is handle to the new root value and zero otherwise.
+*/
+
+size_t jsonl_builder_get_value(const jsonl_builder_t* builder, size_t parent_value, size_t path_length, const jsonl_path_component_t* path_table, int required_value_type);
+/*
+	Function
+		jsonl_builder_get_value
+
+	Description
+		This function finds a child value of a value in the builder.
+		The path is interpreted like the path given to jsonl_get_value function.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		parent_value
+			This parameter is handle to the value where the search starts.
+		path_length
+			This parameter specifies number of components in the path.
+		path_table
+			This parameter is a pointer to the path components.
+		required_value_type
+			This parameter specifies required type for the child value.
+			If this parameter is zero, type of the child value is not checked.
+
+	Return
+		If the child value is found, the return value is handle to the child value and zero otherwise.
+*/
+
+int jsonl_builder_read_value(const jsonl_builder_t* builder, size_t value, jsonl_value_t* value_buffer);
+/*
+	Function
+		jsonl_builder_read_value
+
+	Description
+		This function reads type and content of a value in the builder.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		value
+			This parameter is handle to the value.
 		value_buffer
-			This parameter is a pointer to a buffer that receives the new JSON tree if size of the buffer is sufficiently large.
-			The whole tree is written to this buffer and will not contain any pointers to any memory outside of the value tree buffer.
+			This parameter is a pointer to structure that receives the value.
+			For strings, numbers and booleans the structure receives the value.
+			The string pointer is valid until the builder is modified.
+			For objects and arrays the structure only receives the number of children and the table pointers are set to zero.
+			The size and parent members are set to zero.
 
-			All strings in the value tree are null terminated and aligned to size of pointer.
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+*/
 
-			If the buffer is not large enough to hold the tree data, the contents of the tree value buffer are undefined.
+size_t jsonl_builder_finalize(const jsonl_builder_t* builder, size_t value_buffer_size, jsonl_value_t* value_buffer);
+/*
+	Function
+		jsonl_builder_finalize
+
+	Description
+		This function writes the values of the builder as a JSON value tree.
+		The tree has the same contiguous layout as trees created by jsonl_parse_text function.
+		The builder is not modified and it can be finalized more than once.
+
+		Finalizing also compacts the tree, since values removed or replaced in the builder are not written.
+		Memory of removed values stays in the arena until the builder is initialized again.
+		To release it, finalize the tree and load it to a new builder with jsonl_builder_load function.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		value_buffer_size
+			This parameter specifies the size of buffer pointed by parameter value_buffer in bytes.
+
+			If the buffer is not large enough to hold the tree data, the function returns required buffer size in bytes.
+		value_buffer
+			This parameter is a pointer to a buffer that receives the JSON tree if size of the buffer is sufficiently large.
 
 			If the buffer size is zero, this parameter is ignored.
 
 	Return
-		If the JSON tree is successfully modified, the return value is size of value three in bytes and zero otherwise.
+		If the JSON tree is successfully created, the return value is size of value tree in bytes and zero otherwise.
+		Zero is returned if the root value is not created or the builder is in error state.
 
 		If the returned size is not zero and not greater than the size of the value tree buffer,
-		the buffer will contain new modified JSON tree.
+		the buffer will contain the new JSON tree.
+*/
+
+int jsonl_builder_apply_json_patch(jsonl_builder_t* builder, const jsonl_value_t* patch);
+/*
+	Function
+		jsonl_builder_apply_json_patch
+
+	Description
+		This function applies JSON Patch document defined in RFC 6902 to the tree of the builder.
+		Operations add, remove, replace, move, copy and test are supported.
+		The operations are applied in order directly to the values of the builder,
+		so array indices of each operation refer to the array as left by the previous operations.
+
+		Typical use is to load the tree with jsonl_builder_load function, apply one or more patches and write the result with jsonl_builder_finalize function.
+		The tree is then traversed once when loading and once when finalizing regardless of number of operations in the patch.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+			The root value of the builder must be created before calling this function.
+		patch
+			This parameter is a pointer to the patch document.
+			The patch document is an array of operation objects.
+
+	Return
+		If all operations are successfully applied, the return value is nonzero and zero otherwise.
+		Zero is returned if the patch is not valid, a path does not exist, a test operation fails or memory allocation fails.
+
+		If the function fails, the builder is set to error state, because operations before the failing one are already applied.
+		Load the original tree to a new builder to try again.
+*/
+
+int jsonl_builder_apply_merge_patch(jsonl_builder_t* builder, size_t value, const jsonl_value_t* patch);
+/*
+	Function
+		jsonl_builder_apply_merge_patch
+
+	Description
+		This function applies JSON Merge Patch document defined in RFC 7396 to a value of the builder.
+		Members of the patch with null value are removed from the target, other members are merged recursively
+		and a patch that is not an object replaces the target.
+
+	Parameters
+		builder
+			This parameter is a pointer to the builder.
+		value
+			This parameter specifies handle of the target value, usually the root value of the builder.
+		patch
+			This parameter is a pointer to the merge patch document.
+
+	Return
+		If the patch is successfully applied, the return value is nonzero and zero otherwise.
+		If the function fails, the builder is set to error state.
+*/
+
+int jsonl_write_json_patch_diff(const jsonl_tree_hash_t* tree_hash_a, const jsonl_tree_hash_t* tree_hash_b, jsonl_writer_t* writer);
+/*
+	Function
+		jsonl_write_json_patch_diff
+
+	Description
+		This function writes RFC 6902 JSON Patch that transforms the first JSON tree to the second JSON tree.
+		The patch contains the same modifications as created by jsonl_diff function as add, remove and replace operations.
+
+	Parameters
+		tree_hash_a
+			This parameter is a pointer to tree hash of the JSON tree to be modified.
+		tree_hash_b
+			This parameter is a pointer to tree hash of the target JSON tree.
+		writer
+			This parameter is a pointer to the writer that receives the patch array as next value.
+			The caller completes the output with jsonl_writer_finish function.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
 */
 
 #ifdef __cplusplus
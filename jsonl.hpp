@@ -0,0 +1,557 @@
+/*
+	C++ interface of JSON library by Santtu S. Nyman.
+	git repository https://github.com/Santtu-Nyman/jsonl
+
+	Description
+		Header only C++17 wrapper for the C library declared in the file "jsonl.h".
+
+		The wrapper does not copy any part of the value tree.
+		jsonl::value_view is a single pointer to a jsonl_value_t and all its functions are inline,
+		so reading the tree through the wrapper compiles to the same loads as reading the C structures directly.
+		jsonl::document owns the value tree buffer created by jsonl_parse_text_with_options function.
+
+		The wrapper does not throw exceptions. Failures are reported by empty documents and empty views.
+		Every access through an empty view returns an empty view or an empty value,
+		so paths like document.root()["a"]["b"][2] can be written without checking every step.
+
+	License
+		This is free and unencumbered software released into the public domain.
+		For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef JSONL_HPP
+#define JSONL_HPP
+
+#include "jsonl.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+
+namespace jsonl
+{
+	class value_view;
+
+	class member_view
+	{
+	public:
+		member_view(std::string_view name, const jsonl_value_t* value) noexcept : name_(name), value_(value) {}
+		std::string_view name() const noexcept { return name_; }
+		value_view value() const noexcept;
+
+	private:
+		std::string_view name_;
+		const jsonl_value_t* value_;
+	};
+	/*
+		Class
+			jsonl::member_view
+
+		Description
+			The jsonl::member_view class holds the name and the value of one object member during iteration.
+			The name points to the name stored in the value tree.
+	*/
+
+	class element_iterator
+	{
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = value_view;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = value_view;
+
+		element_iterator() noexcept : read_(nullptr) {}
+		explicit element_iterator(jsonl_value_t* const* read) noexcept : read_(read) {}
+		value_view operator*() const noexcept;
+		value_view operator[](difference_type offset) const noexcept;
+		element_iterator& operator++() noexcept { ++read_; return *this; }
+		element_iterator operator++(int) noexcept { element_iterator previous = *this; ++read_; return previous; }
+		element_iterator& operator--() noexcept { --read_; return *this; }
+		element_iterator operator--(int) noexcept { element_iterator previous = *this; --read_; return previous; }
+		element_iterator& operator+=(difference_type offset) noexcept { read_ += offset; return *this; }
+		element_iterator& operator-=(difference_type offset) noexcept { read_ -= offset; return *this; }
+		element_iterator operator+(difference_type offset) const noexcept { return element_iterator(read_ + offset); }
+		element_iterator operator-(difference_type offset) const noexcept { return element_iterator(read_ - offset); }
+		difference_type operator-(const element_iterator& other) const noexcept { return read_ - other.read_; }
+		bool operator==(const element_iterator& other) const noexcept { return read_ == other.read_; }
+		bool operator!=(const element_iterator& other) const noexcept { return read_ != other.read_; }
+		bool operator<(const element_iterator& other) const noexcept { return read_ < other.read_; }
+		bool operator>(const element_iterator& other) const noexcept { return read_ > other.read_; }
+		bool operator<=(const element_iterator& other) const noexcept { return read_ <= other.read_; }
+		bool operator>=(const element_iterator& other) const noexcept { return read_ >= other.read_; }
+
+	private:
+		jsonl_value_t* const* read_;
+	};
+	/*
+		Class
+			jsonl::element_iterator
+
+		Description
+			The jsonl::element_iterator class iterates the table of array elements. Dereferencing gives a jsonl::value_view.
+	*/
+
+	class member_iterator
+	{
+	public:
+		using member_entry_t = std::remove_pointer_t<decltype(jsonl_value_t::object.table)>;
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = member_view;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = member_view;
+
+		member_iterator() noexcept : read_(nullptr) {}
+		explicit member_iterator(const member_entry_t* read) noexcept : read_(read) {}
+		member_view operator*() const noexcept { return member_view(std::string_view(read_->name, read_->name_length), read_->value); }
+		member_view operator[](difference_type offset) const noexcept { return *(*this + offset); }
+		member_iterator& operator++() noexcept { ++read_; return *this; }
+		member_iterator operator++(int) noexcept { member_iterator previous = *this; ++read_; return previous; }
+		member_iterator& operator--() noexcept { --read_; return *this; }
+		member_iterator operator--(int) noexcept { member_iterator previous = *this; --read_; return previous; }
+		member_iterator& operator+=(difference_type offset) noexcept { read_ += offset; return *this; }
+		member_iterator& operator-=(difference_type offset) noexcept { read_ -= offset; return *this; }
+		member_iterator operator+(difference_type offset) const noexcept { return member_iterator(read_ + offset); }
+		member_iterator operator-(difference_type offset) const noexcept { return member_iterator(read_ - offset); }
+		difference_type operator-(const member_iterator& other) const noexcept { return read_ - other.read_; }
+		bool operator==(const member_iterator& other) const noexcept { return read_ == other.read_; }
+		bool operator!=(const member_iterator& other) const noexcept { return read_ != other.read_; }
+		bool operator<(const member_iterator& other) const noexcept { return read_ < other.read_; }
+		bool operator>(const member_iterator& other) const noexcept { return read_ > other.read_; }
+		bool operator<=(const member_iterator& other) const noexcept { return read_ <= other.read_; }
+		bool operator>=(const member_iterator& other) const noexcept { return read_ >= other.read_; }
+
+	private:
+		const member_entry_t* read_;
+	};
+	/*
+		Class
+			jsonl::member_iterator
+
+		Description
+			The jsonl::member_iterator class iterates the table of object members in the order they are stored in the value tree.
+			Dereferencing gives a jsonl::member_view.
+	*/
+
+	template <typename iterator_t>
+	class range
+	{
+	public:
+		range(iterator_t begin, iterator_t end) noexcept : begin_(begin), end_(end) {}
+		iterator_t begin() const noexcept { return begin_; }
+		iterator_t end() const noexcept { return end_; }
+		std::size_t size() const noexcept { return static_cast<std::size_t>(end_ - begin_); }
+		bool empty() const noexcept { return begin_ == end_; }
+
+	private:
+		iterator_t begin_;
+		iterator_t end_;
+	};
+	/*
+		Class
+			jsonl::range
+
+		Description
+			The jsonl::range class is a pair of iterators that can be used with range based for loops.
+	*/
+
+	class value_view
+	{
+	public:
+		value_view() noexcept : value_(nullptr) {}
+		value_view(const jsonl_value_t* value) noexcept : value_(value) {}
+
+		const jsonl_value_t* get() const noexcept { return value_; }
+		explicit operator bool() const noexcept { return value_ != nullptr; }
+		int type() const noexcept { return value_ ? value_->type : JSONL_TYPE_ERROR; }
+		bool is_object() const noexcept { return type() == JSONL_TYPE_OBJECT; }
+		bool is_array() const noexcept { return type() == JSONL_TYPE_ARRAY; }
+		bool is_string() const noexcept { return type() == JSONL_TYPE_STRING; }
+		bool is_number() const noexcept { return type() == JSONL_TYPE_NUMBER; }
+		bool is_boolean() const noexcept { return type() == JSONL_TYPE_BOOLEAN; }
+		bool is_null() const noexcept { return type() == JSONL_TYPE_NULL; }
+
+		std::string_view string() const noexcept { return is_string() ? std::string_view(value_->string.value, value_->string.length) : std::string_view(); }
+		const jsonl_number_value_t* number() const noexcept { return is_number() ? &value_->number : nullptr; }
+		bool boolean() const noexcept { return is_boolean() && value_->boolean.value; }
+
+		std::size_t size() const noexcept
+		{
+			if (is_array())
+				return value_->array.value_count;
+			else if (is_object())
+				return value_->object.value_count;
+			else
+				return 0;
+		}
+
+		value_view operator[](std::size_t index) const noexcept
+		{
+			return (is_array() && index < value_->array.value_count) ? value_view(value_->array.table[index]) : value_view();
+		}
+
+		value_view operator[](std::string_view name) const noexcept
+		{
+			if (!is_object())
+				return value_view();
+			jsonl_path_component_t path_component;
+			path_component.container_type = JSONL_TYPE_OBJECT;
+			path_component.name.length = name.size();
+			path_component.name.value = const_cast<char*>(name.data());
+			return value_view(jsonl_get_value(value_, 1, &path_component, 0));
+		}
+
+		value_view operator[](const char* name) const noexcept { return (*this)[std::string_view(name)]; }
+
+		range<element_iterator> elements() const noexcept
+		{
+			if (!is_array())
+				return range<element_iterator>(element_iterator(), element_iterator());
+			return range<element_iterator>(element_iterator(value_->array.table), element_iterator(value_->array.table + value_->array.value_count));
+		}
+
+		range<member_iterator> members() const noexcept
+		{
+			if (!is_object())
+				return range<member_iterator>(member_iterator(), member_iterator());
+			return range<member_iterator>(member_iterator(value_->object.table), member_iterator(value_->object.table + value_->object.value_count));
+		}
+
+	private:
+		const jsonl_value_t* value_;
+	};
+	/*
+		Class
+			jsonl::value_view
+
+		Description
+			The jsonl::value_view class is a non owning view to a value in a value tree.
+			The view is valid as long as the value tree is valid.
+
+			Strings and names are returned as std::string_view that points to the strings stored in the value tree.
+			Numbers are returned as pointer to jsonl_number_value_t, because the number format depends on JSONL_FIXED_POINT_NUMBER_FORMAT.
+
+			Indexing an array with a number gives an element and indexing an object with a name gives a member.
+			Members are found with jsonl_get_value function, so large objects use the object index.
+			Index that is out of range, name that is not found or a value of wrong type gives an empty view.
+
+			elements function gives a range of the elements of an array and members function gives a range of the members of an object.
+			For other types the ranges are empty.
+	*/
+
+	inline value_view member_view::value() const noexcept { return value_view(value_); }
+
+	inline value_view element_iterator::operator*() const noexcept { return value_view(*read_); }
+
+	inline value_view element_iterator::operator[](difference_type offset) const noexcept { return value_view(read_[offset]); }
+
+	class document
+	{
+	public:
+		document() noexcept : size_(0) {}
+
+		explicit document(std::string_view json_text, const jsonl_parse_options_t* options = nullptr) noexcept : size_(0)
+		{
+			std::size_t tree_size = jsonl_parse_text_with_options(json_text.size(), json_text.data(), options, 0, nullptr);
+			if (!tree_size)
+				return;
+			std::size_t value_count = (tree_size + sizeof(jsonl_value_t) - 1) / sizeof(jsonl_value_t);
+			tree_.reset(new (std::nothrow) jsonl_value_t[value_count]);
+			if (tree_ && jsonl_parse_text_with_options(json_text.size(), json_text.data(), options, value_count * sizeof(jsonl_value_t), tree_.get()) == tree_size)
+				size_ = tree_size;
+			else
+				tree_.reset();
+		}
+
+		document(document&& other) noexcept : tree_(std::move(other.tree_)), size_(other.size_) { other.size_ = 0; }
+
+		document& operator=(document&& other) noexcept
+		{
+			tree_ = std::move(other.tree_);
+			size_ = other.size_;
+			other.size_ = 0;
+			return *this;
+		}
+
+		document(const document&) = delete;
+		document& operator=(const document&) = delete;
+
+		explicit operator bool() const noexcept { return static_cast<bool>(tree_); }
+		const jsonl_value_t* get() const noexcept { return tree_.get(); }
+		std::size_t size() const noexcept { return size_; }
+		value_view root() const noexcept { return value_view(tree_.get()); }
+		value_view operator[](std::size_t index) const noexcept { return root()[index]; }
+		value_view operator[](std::string_view name) const noexcept { return root()[name]; }
+		value_view operator[](const char* name) const noexcept { return root()[name]; }
+
+	private:
+		std::unique_ptr<jsonl_value_t[]> tree_;
+		std::size_t size_;
+	};
+	/*
+		Class
+			jsonl::document
+
+		Description
+			The jsonl::document class owns a value tree parsed from JSON text.
+			The constructor queries the required buffer size, allocates the buffer and parses the JSON text like the C interface is used.
+			If the JSON text is not valid or the allocation fails, the document is empty.
+
+			The document can be moved but not copied, because views to the tree point inside the buffer.
+			Moving the document does not move the buffer, so views remain valid after the document is moved.
+	*/
+
+	template <typename struct_t>
+	struct struct_fields;
+	/*
+		Class
+			jsonl::struct_fields
+
+		Description
+			The jsonl::struct_fields class template lists the fields of a structure that is mapped to JSON object.
+			Specializations are declared with JSONL_STRUCT_FIELDS macro and contain member table,
+			which is an array of jsonl_field_descriptor_t created with JSONL_FIELD and JSONL_FIELD_NAMED macros.
+	*/
+
+	namespace detail
+	{
+		template <typename struct_t, typename = void>
+		struct has_struct_fields : std::false_type {};
+
+		template <typename struct_t>
+		struct has_struct_fields<struct_t, std::void_t<decltype(struct_fields<struct_t>::table)>> : std::true_type {};
+
+		template <typename field_t>
+		struct dependent_false : std::false_type {};
+
+		constexpr std::size_t name_length(const char* name)
+		{
+			std::size_t length = 0;
+			while (name[length])
+				++length;
+			return length;
+		}
+
+		// Same slot function as jsonl_create_struct_descriptor uses, specified in the documentation of jsonl_struct_descriptor_t.
+		constexpr std::size_t field_slot(std::uint64_t hash_seed, std::size_t hash_mask, std::size_t name_length, const char* name)
+		{
+			std::uint64_t hash = static_cast<std::uint64_t>(0xCBF29CE484222325) ^ hash_seed;
+			for (std::size_t i = 0; i != name_length; ++i)
+				hash = (hash ^ static_cast<std::uint64_t>(static_cast<unsigned char>(name[i]))) * static_cast<std::uint64_t>(0x100000001B3);
+			hash ^= hash >> 33;
+			hash *= static_cast<std::uint64_t>(0xFF51AFD7ED558CCD);
+			hash ^= hash >> 33;
+			hash *= static_cast<std::uint64_t>(0xC4CEB9FE1A85EC53);
+			hash ^= hash >> 33;
+			return static_cast<std::size_t>(hash) & hash_mask;
+		}
+
+		template <std::size_t field_count>
+		constexpr bool is_perfect_hash(const jsonl_field_descriptor_t (&field_table)[field_count], std::uint64_t hash_seed, std::size_t hash_mask)
+		{
+			for (std::size_t i = 1; i < field_count; ++i)
+			{
+				std::size_t slot = field_slot(hash_seed, hash_mask, field_table[i].name_length, field_table[i].name);
+				for (std::size_t j = 0; j != i; ++j)
+					if (slot == field_slot(hash_seed, hash_mask, field_table[j].name_length, field_table[j].name))
+						return false;
+			}
+			return true;
+		}
+
+		struct perfect_hash_t
+		{
+			std::uint64_t hash_seed;
+			std::size_t slot_count;
+		};
+
+		template <std::size_t field_count>
+		constexpr perfect_hash_t find_perfect_hash(const jsonl_field_descriptor_t (&field_table)[field_count])
+		{
+			for (std::size_t i = 1; i < field_count; ++i)
+				for (std::size_t j = 0; j != i; ++j)
+					if (field_table[i].name_length == field_table[j].name_length && std::string_view(field_table[i].name, field_table[i].name_length) == std::string_view(field_table[j].name, field_table[j].name_length))
+						return perfect_hash_t{ 0, 0 };
+			std::size_t slot_count = 1;
+			while (slot_count < field_count * 2)
+				slot_count <<= 1;
+			for (;; slot_count <<= 1)
+			{
+				for (std::uint64_t seed_index = 0; seed_index != 256; ++seed_index)
+					if (is_perfect_hash(field_table, seed_index * static_cast<std::uint64_t>(0x9E3779B97F4A7C15), slot_count - 1))
+						return perfect_hash_t{ seed_index * static_cast<std::uint64_t>(0x9E3779B97F4A7C15), slot_count };
+				if (slot_count > field_count * field_count)
+					return perfect_hash_t{ 0, 0 };
+			}
+		}
+
+		template <std::size_t slot_count, std::size_t field_count>
+		constexpr std::array<std::size_t, slot_count> create_hash_table(const jsonl_field_descriptor_t (&field_table)[field_count], std::uint64_t hash_seed)
+		{
+			std::array<std::size_t, slot_count> hash_table{};
+			for (std::size_t i = 0; i != slot_count; ++i)
+				hash_table[i] = ~static_cast<std::size_t>(0);
+			for (std::size_t i = 0; i != field_count; ++i)
+				hash_table[field_slot(hash_seed, slot_count - 1, field_table[i].name_length, field_table[i].name)] = i;
+			return hash_table;
+		}
+
+		template <std::size_t field_count>
+		constexpr std::size_t longest_name_length(const jsonl_field_descriptor_t (&field_table)[field_count])
+		{
+			std::size_t longest_length = 0;
+			for (std::size_t i = 0; i != field_count; ++i)
+				if (field_table[i].name_length > longest_length)
+					longest_length = field_table[i].name_length;
+			return longest_length;
+		}
+	}
+
+	template <typename struct_t>
+	struct struct_mapping
+	{
+		static_assert(detail::has_struct_fields<struct_t>::value, "the structure has no JSONL_STRUCT_FIELDS declaration");
+		static constexpr detail::perfect_hash_t perfect_hash = detail::find_perfect_hash(struct_fields<struct_t>::table);
+		static_assert(perfect_hash.slot_count, "field names are not unique");
+		static constexpr std::array<std::size_t, perfect_hash.slot_count> hash_table = detail::create_hash_table<perfect_hash.slot_count>(struct_fields<struct_t>::table, perfect_hash.hash_seed);
+		static constexpr jsonl_struct_descriptor_t descriptor = {
+			sizeof(jsonl_struct_descriptor_t) + sizeof(hash_table),
+			sizeof(struct_fields<struct_t>::table) / sizeof(jsonl_field_descriptor_t),
+			struct_fields<struct_t>::table,
+			perfect_hash.hash_seed,
+			perfect_hash.slot_count - 1,
+			hash_table.data(),
+			detail::longest_name_length(struct_fields<struct_t>::table) };
+	};
+	/*
+		Class
+			jsonl::struct_mapping
+
+		Description
+			The jsonl::struct_mapping class template holds the struct descriptor of a structure declared with JSONL_STRUCT_FIELDS macro.
+			The perfect hash of the field names is found at compile time, so the descriptor is a constant and needs no initialization at run time.
+			Decoding and printing use jsonl_decode_struct and jsonl_writer_struct functions,
+			which scan the JSON text with the parser of the C library without creating a value tree.
+	*/
+
+	template <typename field_t>
+	constexpr jsonl_field_descriptor_t make_field(const char* name, std::size_t offset)
+	{
+		using type_t = std::remove_cv_t<field_t>;
+		std::size_t length = detail::name_length(name);
+		if constexpr (std::is_same_v<type_t, bool>)
+			return jsonl_field_descriptor_t{ length, name, offset, JSONL_FIELD_TYPE_BOOLEAN, sizeof(bool), nullptr };
+		else if constexpr (std::is_integral_v<type_t> && std::is_signed_v<type_t> && !std::is_same_v<type_t, char> && (sizeof(type_t) == 1 || sizeof(type_t) == 2 || sizeof(type_t) == 4 || sizeof(type_t) == 8))
+			return jsonl_field_descriptor_t{ length, name, offset, JSONL_FIELD_TYPE_INTEGER, sizeof(type_t), nullptr };
+		else if constexpr (std::is_same_v<type_t, double>)
+			return jsonl_field_descriptor_t{ length, name, offset, JSONL_FIELD_TYPE_DOUBLE, 0, nullptr };
+		else if constexpr (std::is_same_v<type_t, jsonl_number_value_t>)
+			return jsonl_field_descriptor_t{ length, name, offset, JSONL_FIELD_TYPE_NUMBER, 0, nullptr };
+		else if constexpr (std::is_array_v<type_t> && std::is_same_v<std::remove_extent_t<type_t>, char> && std::rank_v<type_t> == 1)
+			return jsonl_field_descriptor_t{ length, name, offset, JSONL_FIELD_TYPE_STRING, sizeof(type_t), nullptr };
+		else if constexpr (detail::has_struct_fields<type_t>::value)
+			return jsonl_field_descriptor_t{ length, name, offset, JSONL_FIELD_TYPE_OBJECT, 0, &struct_mapping<type_t>::descriptor };
+		else
+			static_assert(detail::dependent_false<type_t>::value, "the field type is not bool, signed integer, double, jsonl_number_value_t, char array or structure declared with JSONL_STRUCT_FIELDS");
+	}
+	/*
+		Function
+			jsonl::make_field
+
+		Description
+			This function creates field descriptor for a field and chooses the field type from the C++ type of the field.
+			bool fields are booleans, signed integers of 1, 2, 4 or 8 bytes are integers, char arrays are strings
+			and structures declared with JSONL_STRUCT_FIELDS macro are objects.
+			The function is called by JSONL_FIELD and JSONL_FIELD_NAMED macros.
+	*/
+
+	template <typename struct_t>
+	std::size_t decode_struct(std::string_view json_text, struct_t& structure) noexcept
+	{
+		return jsonl_decode_struct(&struct_mapping<struct_t>::descriptor, json_text.size(), json_text.data(), &structure);
+	}
+	/*
+		Function
+			jsonl::decode_struct
+
+		Description
+			This function decodes JSON object to a structure declared with JSONL_STRUCT_FIELDS macro like jsonl_decode_struct function.
+			The return value is size of the JSON text used by the object in bytes or zero if the JSON text is not valid.
+	*/
+
+	template <typename struct_t>
+	bool write_struct(jsonl_writer_t* writer, const struct_t& structure) noexcept
+	{
+		return jsonl_writer_struct(writer, &struct_mapping<struct_t>::descriptor, &structure) != 0;
+	}
+	/*
+		Function
+			jsonl::write_struct
+
+		Description
+			This function writes a structure declared with JSONL_STRUCT_FIELDS macro as next value of the writer like jsonl_writer_struct function.
+	*/
+
+	template <typename struct_t>
+	std::size_t print_struct(const struct_t& structure, const jsonl_print_options_t* options, std::size_t json_text_buffer_size, char* json_text_buffer) noexcept
+	{
+		return jsonl_print_struct(&struct_mapping<struct_t>::descriptor, &structure, options, json_text_buffer_size, json_text_buffer);
+	}
+	/*
+		Function
+			jsonl::print_struct
+
+		Description
+			This function prints a structure declared with JSONL_STRUCT_FIELDS macro like jsonl_print_struct function.
+	*/
+}
+
+#define JSONL_STRUCT_FIELDS(struct_type, ...) \
+	namespace jsonl \
+	{ \
+		template <> \
+		struct struct_fields<struct_type> \
+		{ \
+			using mapped_struct_t = struct_type; \
+			static constexpr jsonl_field_descriptor_t table[] = { __VA_ARGS__ }; \
+		}; \
+	}
+/*
+	Macro
+		JSONL_STRUCT_FIELDS
+
+	Description
+		This macro declares the fields of a structure that are mapped to JSON object members.
+		The macro must be used in the global namespace after the declaration of the structure.
+		Structures used as fields of other structures must be declared before the structures that contain them.
+
+		Example
+			struct point_t { int32_t x; int32_t y; };
+			JSONL_STRUCT_FIELDS(point_t, JSONL_FIELD(x), JSONL_FIELD(y))
+*/
+
+#define JSONL_FIELD(member) ::jsonl::make_field<decltype(mapped_struct_t::member)>(#member, offsetof(mapped_struct_t, member))
+/*
+	Macro
+		JSONL_FIELD
+
+	Description
+		This macro creates field descriptor for a field of the structure inside JSONL_STRUCT_FIELDS macro.
+		The name of the JSON object member is the name of the field.
+*/
+
+#define JSONL_FIELD_NAMED(member, name) ::jsonl::make_field<decltype(mapped_struct_t::member)>(name, offsetof(mapped_struct_t, member))
+/*
+	Macro
+		JSONL_FIELD_NAMED
+
+	Description
+		This macro works like JSONL_FIELD, but the name of the JSON object member is specified by the string literal parameter name.
+*/
+
+#endif
@@ -0,0 +1,253 @@
+/*
+	File interface of JSON library by Santtu S. Nyman.
+	git repository https://github.com/Santtu-Nyman/jsonl
+
+	Description
+		POSIX implementation of the functions declared in the file "jsonl_file.h".
+
+	License
+		This is free and unencumbered software released into the public domain.
+		For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef _FILE_OFFSET_BITS
+#define _FILE_OFFSET_BITS 64
+#endif
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
+#include "jsonl_file.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifndef JSONL_FILE_WINDOW_SIZE
+#define JSONL_FILE_WINDOW_SIZE ((size_t)64 << 20)
+#endif
+
+#ifndef O_CLOEXEC
+#define O_CLOEXEC 0
+#endif
+
+typedef struct jsonl_file_record_buffer_t
+{
+	size_t size;
+	jsonl_value_t* tree;
+} jsonl_file_record_buffer_t;
+
+static int jsonl_file_open(const char* file_name, uint64_t* file_size);
+
+static int jsonl_file_is_white_space_line(size_t text_size, const char* text);
+
+static int jsonl_file_parse_record(const jsonl_parse_options_t* options, jsonl_file_record_buffer_t* buffer, jsonl_file_record_t* record);
+
+static int jsonl_file_open(const char* file_name, uint64_t* file_size)
+{
+	int file_descriptor;
+	do
+		file_descriptor = open(file_name, O_RDONLY | O_CLOEXEC);
+	while (file_descriptor == -1 && errno == EINTR);
+	if (file_descriptor == -1)
+		return -1;
+	struct stat file_status;
+	if (fstat(file_descriptor, &file_status) == -1)
+	{
+		int error = errno;
+		close(file_descriptor);
+		errno = error;
+		return -1;
+	}
+	if (!S_ISREG(file_status.st_mode))
+	{
+		close(file_descriptor);
+		errno = S_ISDIR(file_status.st_mode) ? EISDIR : EINVAL;
+		return -1;
+	}
+	*file_size = (uint64_t)file_status.st_size;
+	return file_descriptor;
+}
+
+int jsonl_file_map(const char* file_name, jsonl_file_t* file)
+{
+	uint64_t file_size;
+	int file_descriptor = jsonl_file_open(file_name, &file_size);
+	if (file_descriptor == -1)
+		return 0;
+	if (file_size != (uint64_t)(size_t)file_size)
+	{
+		close(file_descriptor);
+		errno = EFBIG;
+		return 0;
+	}
+	if (!file_size)
+	{
+		// Empty files can not be mapped, but empty text needs no mapping.
+		close(file_descriptor);
+		file->size = 0;
+		file->data = "";
+		return 1;
+	}
+	void* mapping = mmap(0, (size_t)file_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+	int error = errno;
+	close(file_descriptor);
+	if (mapping == MAP_FAILED)
+	{
+		errno = error;
+		return 0;
+	}
+	madvise(mapping, (size_t)file_size, MADV_SEQUENTIAL);
+	file->size = (size_t)file_size;
+	file->data = (const char*)mapping;
+	return 1;
+}
+
+void jsonl_file_unmap(jsonl_file_t* file)
+{
+	if (file->size)
+		munmap((void*)file->data, file->size);
+	file->size = 0;
+	file->data = 0;
+}
+
+jsonl_value_t* jsonl_file_load_tree(const char* file_name, const jsonl_parse_options_t* options, size_t* tree_size)
+{
+	jsonl_file_t file;
+	if (!jsonl_file_map(file_name, &file))
+		return 0;
+	jsonl_value_t* tree = 0;
+	size_t required_tree_size = jsonl_parse_text_with_options(file.size, file.data, options, 0, 0);
+	if (required_tree_size)
+	{
+		tree = (jsonl_value_t*)malloc(required_tree_size);
+		if (tree && jsonl_parse_text_with_options(file.size, file.data, options, required_tree_size, tree) != required_tree_size)
+		{
+			free(tree);
+			tree = 0;
+			errno = EINVAL;
+		}
+	}
+	else
+		errno = EINVAL;
+	int error = errno;
+	jsonl_file_unmap(&file);
+	errno = error;
+	if (tree && tree_size)
+		*tree_size = required_tree_size;
+	return tree;
+}
+
+static int jsonl_file_is_white_space_line(size_t text_size, const char* text)
+{
+	for (const char* end = text + text_size; text != end; ++text)
+		if (*text != ' ' && *text != '\t' && *text != '\r')
+			return 0;
+	return 1;
+}
+
+static int jsonl_file_parse_record(const jsonl_parse_options_t* options, jsonl_file_record_buffer_t* buffer, jsonl_file_record_t* record)
+{
+	size_t tree_size = jsonl_parse_text_with_options(record->text_size, record->text, options, buffer->size, buffer->tree);
+	if (tree_size > buffer->size)
+	{
+		// The buffer grows at least to double size, so records of similar size do not reallocate it again.
+		size_t new_size = (buffer->size < (size_t)~0 / 2) ? (2 * buffer->size) : (size_t)~0;
+		if (new_size < tree_size)
+			new_size = tree_size;
+		jsonl_value_t* new_tree = (jsonl_value_t*)realloc(buffer->tree, new_size);
+		if (!new_tree)
+			return 0;
+		buffer->size = new_size;
+		buffer->tree = new_tree;
+		tree_size = jsonl_parse_text_with_options(record->text_size, record->text, options, buffer->size, buffer->tree);
+	}
+	record->value_tree = tree_size ? buffer->tree : 0;
+	return 1;
+}
+
+int jsonl_file_for_each_record(const char* file_name, const jsonl_parse_options_t* options, jsonl_file_record_callback_t record_callback, void* record_context)
+{
+	uint64_t file_size;
+	int file_descriptor = jsonl_file_open(file_name, &file_size);
+	if (file_descriptor == -1)
+		return 0;
+	long page_size = sysconf(_SC_PAGESIZE);
+	if (page_size < 1)
+		page_size = 4096;
+	jsonl_file_record_buffer_t buffer = { 0, 0 };
+	jsonl_file_record_t record;
+	record.line_number = 1;
+	uint64_t offset = 0;
+	size_t window_size = JSONL_FILE_WINDOW_SIZE;
+	int error = 0;
+	while (!error && offset != file_size)
+	{
+		// The window begins at the page that contains the beginning of the next record.
+		uint64_t window_offset = offset - (offset % (uint64_t)page_size);
+		size_t mapping_size = ((file_size - window_offset) < (uint64_t)window_size) ? (size_t)(file_size - window_offset) : window_size;
+		int last_window = window_offset + (uint64_t)mapping_size == file_size;
+		void* mapping = mmap(0, mapping_size, PROT_READ, MAP_PRIVATE, file_descriptor, (off_t)window_offset);
+		if (mapping == MAP_FAILED)
+		{
+			error = errno;
+			break;
+		}
+		madvise(mapping, mapping_size, MADV_SEQUENTIAL);
+		const char* window_begin = (const char*)mapping + (size_t)(offset - window_offset);
+		const char* window_end = (const char*)mapping + mapping_size;
+		const char* read = window_begin;
+		while (read != window_end)
+		{
+			const char* line_end = (const char*)memchr(read, '\n', (size_t)(window_end - read));
+			if (!line_end)
+			{
+				// The last line of the file does not need a line feed. Other incomplete lines continue in the next window.
+				if (!last_window)
+					break;
+				line_end = window_end;
+			}
+			record.offset = window_offset + (uint64_t)(read - (const char*)mapping);
+			record.text_size = (size_t)(line_end - read);
+			record.text = read;
+			if (!jsonl_file_is_white_space_line(record.text_size, record.text))
+			{
+				if (!jsonl_file_parse_record(options, &buffer, &record))
+				{
+					error = ENOMEM;
+					break;
+				}
+				if (!record_callback(record_context, &record))
+				{
+					error = ECANCELED;
+					break;
+				}
+			}
+			++record.line_number;
+			read = (line_end != window_end) ? (line_end + 1) : line_end;
+		}
+		offset = window_offset + (uint64_t)(read - (const char*)mapping);
+		munmap(mapping, mapping_size);
+		if (read != window_begin)
+			window_size = JSONL_FILE_WINDOW_SIZE;
+		else if (!error)
+		{
+			// A single record is larger than the window, so the window is doubled until the record fits in it.
+			if (window_size > (size_t)~0 / 2)
+				error = EFBIG;
+			else
+				window_size *= 2;
+		}
+	}
+	free(buffer.tree);
+	close(file_descriptor);
+	if (error)
+	{
+		errno = error;
+		return 0;
+	}
+	return 1;
+}
@@ -0,0 +1,193 @@
+/*
+	File interface of JSON library by Santtu S. Nyman.
+	git repository https://github.com/Santtu-Nyman/jsonl
+
+	Description
+		Optional POSIX companion module for the library declared in the file "jsonl.h".
+		Unlike the library itself, this module uses the C standard library and the POSIX functions open, mmap and madvise.
+		Programs that do not need it compile only the file "jsonl.c".
+
+		JSON files are memory mapped and parsed directly from the mapping, so the text is never copied to an allocated buffer.
+		The mapped text can be given to every function of the library that reads JSON text.
+
+		NDJSON files are read through a window that is mapped over the file one part at a time,
+		so files much larger than the memory and the address space can be processed one record at a time.
+
+	License
+		This is free and unencumbered software released into the public domain.
+		For more information, please refer to <https://unlicense.org>
+*/
+
+#ifndef JSONL_FILE_H
+#define JSONL_FILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "jsonl.h"
+
+typedef struct jsonl_file_t
+{
+	size_t size;
+	const char* data;
+} jsonl_file_t;
+/*
+	Structure
+		jsonl_file_t
+
+	Description
+		The jsonl_file_t structure describes the text of a memory mapped file.
+
+	Members
+		size
+			This member specifies the size of the file in bytes.
+		data
+			This member is a pointer to the read only text of the file. The text is not null terminated.
+*/
+
+int jsonl_file_map(const char* file_name, jsonl_file_t* file);
+/*
+	Function
+		jsonl_file_map
+
+	Description
+		This function maps the whole file to memory for reading.
+		The mapping is advised to be read sequentially, so the kernel reads ahead and the pages read can be dropped from memory early.
+		The parser reads the text from the beginning to the end several times, once for every level of nesting.
+
+		The file must fit in the address space, but it does not need to fit in the memory.
+
+	Parameters
+		file_name
+			This parameter is a pointer to null terminated name of the file.
+		file
+			This parameter is a pointer to structure that receives the mapped text.
+
+	Return
+		If the function succeeds, the return value is nonzero and zero otherwise.
+		If the function fails, errno describes the error.
+*/
+
+void jsonl_file_unmap(jsonl_file_t* file);
+/*
+	Function
+		jsonl_file_unmap
+
+	Description
+		This function unmaps file mapped by jsonl_file_map function.
+		Value trees parsed from the file remain valid, because value trees do not point to the JSON text.
+
+	Parameters
+		file
+			This parameter is a pointer to the mapped file.
+*/
+
+jsonl_value_t* jsonl_file_load_tree(const char* file_name, const jsonl_parse_options_t* options, size_t* tree_size);
+/*
+	Function
+		jsonl_file_load_tree
+
+	Description
+		This function maps JSON file, parses it to a value tree allocated with malloc and unmaps the file.
+		The only allocated memory is the value tree.
+
+	Parameters
+		file_name
+			This parameter is a pointer to null terminated name of the file.
+		options
+			This parameter is a pointer to structure that specifies the options for parsing or zero for default options.
+		tree_size
+			This parameter is a pointer to variable that receives the size of the value tree in bytes.
+			This parameter can be zero, if the size is not needed.
+
+	Return
+		If the function succeeds, the return value is a pointer to the root of the value tree and zero otherwise.
+		The value tree is released with free function.
+		If reading the file failed, errno describes the error. If the text is not valid JSON, errno is set to EINVAL.
+*/
+
+typedef struct jsonl_file_record_t
+{
+	uint64_t line_number;
+	uint64_t offset;
+	size_t text_size;
+	const char* text;
+	const jsonl_value_t* value_tree;
+} jsonl_file_record_t;
+/*
+	Structure
+		jsonl_file_record_t
+
+	Description
+		The jsonl_file_record_t structure describes one record of NDJSON file passed to the record callback.
+		The text and the value tree are only valid until the callback returns.
+
+	Members
+		line_number
+			This member specifies the number of the line of the record. The first line is number 1.
+		offset
+			This member specifies the offset of the record from the beginning of the file in bytes.
+		text_size
+			This member specifies the size of the text of the record in bytes. The size does not include the line feed.
+		text
+			This member is a pointer to the text of the record in the file mapping.
+		value_tree
+			This member is a pointer to the value tree parsed from the record or zero, if the record is not valid JSON.
+*/
+
+typedef int (*jsonl_file_record_callback_t)(void* context, const jsonl_file_record_t* record);
+/*
+	Function
+		jsonl_file_record_callback_t
+
+	Description
+		Callback function type for receiving records of NDJSON file.
+
+	Parameters
+		context
+			This parameter is the context pointer given to jsonl_file_for_each_record function.
+		record
+			This parameter is a pointer to the record.
+
+	Return
+		The callback returns nonzero to continue to the next record and zero to stop.
+*/
+
+int jsonl_file_for_each_record(const char* file_name, const jsonl_parse_options_t* options, jsonl_file_record_callback_t record_callback, void* record_context);
+/*
+	Function
+		jsonl_file_for_each_record
+
+	Description
+		This function parses every line of NDJSON file and passes the records to the callback in order.
+		Empty lines and lines that contain only white space are skipped. Lines can end with line feed or carriage return and line feed.
+
+		The file is mapped through a window of JSONL_FILE_WINDOW_SIZE bytes that moves over the file, 64 MiB by default.
+		The window grows temporarily when a single record does not fit in it.
+		Only the window is mapped at a time, so the size of the file is not limited by the memory or the address space.
+
+		The value trees of the records are created to one buffer that is allocated with malloc and reused for every record.
+
+	Parameters
+		file_name
+			This parameter is a pointer to null terminated name of the file.
+		options
+			This parameter is a pointer to structure that specifies the options for parsing the records or zero for default options.
+			The limits of the options apply to every record separately.
+		record_callback
+			This parameter is a pointer to the callback function that receives the records.
+			The callback also receives the records that are not valid JSON and decides whether to continue.
+		record_context
+			This parameter is the context pointer passed to the callback.
+
+	Return
+		If every record was passed to the callback, the return value is nonzero and zero otherwise.
+		If the callback stopped the function, errno is set to ECANCELED. Otherwise errno describes the error.
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif